@@ -33,6 +33,8 @@ LOCAL_SRC_FILES := \
 	executor/xeTestCase.cpp \
 	executor/xeTestCaseListParser.cpp \
 	executor/xeTestCaseResult.cpp \
+	executor/xeTestLogDiff.cpp \
+	executor/xeTestLogIndex.cpp \
 	executor/xeTestLogParser.cpp \
 	executor/xeTestLogWriter.cpp \
 	executor/xeTestResultParser.cpp \
@@ -42,6 +44,7 @@ LOCAL_SRC_FILES := \
 	framework/common/tcuArray.cpp \
 	framework/common/tcuAstcUtil.cpp \
 	framework/common/tcuBilinearImageCompare.cpp \
+	framework/common/tcuCaseTrie.cpp \
 	framework/common/tcuCommandLine.cpp \
 	framework/common/tcuCompressedTexture.cpp \
 	framework/common/tcuCPUWarmup.cpp \
@@ -83,6 +86,7 @@ LOCAL_SRC_FILES := \
 	framework/common/tcuThreadUtil.cpp \
 	framework/delibs/debase/deDefs.c \
 	framework/delibs/debase/deFloat16.c \
+	framework/delibs/debase/deFloat16Test.c \
 	framework/delibs/debase/deInt32.c \
 	framework/delibs/debase/deInt32Test.c \
 	framework/delibs/debase/deMath.c \
@@ -147,6 +151,7 @@ LOCAL_SRC_FILES := \
 	framework/delibs/deutil/deCommandLine.c \
 	framework/delibs/deutil/deDynamicLibrary.c \
 	framework/delibs/deutil/deFile.c \
+	framework/delibs/deutil/deMappedFile.c \
 	framework/delibs/deutil/deProcess.c \
 	framework/delibs/deutil/deSocket.c \
 	framework/delibs/deutil/deTimer.c \
@@ -198,6 +203,7 @@ LOCAL_SRC_FILES := \
 	framework/opengl/simplereference/sglrContextWrapper.cpp \
 	framework/opengl/simplereference/sglrGLContext.cpp \
 	framework/opengl/simplereference/sglrReferenceContext.cpp \
+	framework/opengl/simplereference/sglrReferenceRenderContext.cpp \
 	framework/opengl/simplereference/sglrReferenceUtils.cpp \
 	framework/opengl/simplereference/sglrShaderProgram.cpp \
 	framework/opengl/wrapper/glwDefs.cpp \
@@ -227,6 +233,7 @@ LOCAL_SRC_FILES := \
 	framework/qphelper/qpXmlWriter.c \
 	framework/randomshaders/rsgBinaryOps.cpp \
 	framework/randomshaders/rsgBuiltinFunctions.cpp \
+	framework/randomshaders/rsgCompiledShader.cpp \
 	framework/randomshaders/rsgDefs.cpp \
 	framework/randomshaders/rsgExecutionContext.cpp \
 	framework/randomshaders/rsgExpression.cpp \
@@ -0,0 +1,101 @@
+/*-------------------------------------------------------------------------
+ * drawElements Quality Program Test Executor
+ * ------------------------------------------
+ *
+ * Copyright 2014 The Android Open Source Project
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ *      http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ *
+ *//*!
+ * \file
+ * \brief Build case index for existing test log.
+ *//*--------------------------------------------------------------------*/
+
+#include "xeTestLogIndex.hpp"
+#include "deString.h"
+
+#include <string>
+#include <cstdio>
+#include <stdexcept>
+
+using std::string;
+
+struct CommandLine
+{
+	CommandLine (void)
+	{
+	}
+
+	string		srcFilename;
+	string		dstFilename;
+};
+
+static void printHelp (const char* binName)
+{
+	printf("%s: [testlog] [dst index (optional, default <testlog>.idx)]\n", binName);
+}
+
+static bool parseCommandLine (CommandLine& cmdLine, int argc, const char* const* argv)
+{
+	for (int argNdx = 1; argNdx < argc; argNdx++)
+	{
+		const char* arg = argv[argNdx];
+
+		if (!deStringBeginsWith(arg, "--"))
+		{
+			if (cmdLine.srcFilename.empty())
+				cmdLine.srcFilename = arg;
+			else if (cmdLine.dstFilename.empty())
+				cmdLine.dstFilename = arg;
+			else
+				return false;
+		}
+		else
+			return false;
+	}
+
+	if (cmdLine.srcFilename.empty())
+		return false;
+
+	if (cmdLine.dstFilename.empty())
+		cmdLine.dstFilename = cmdLine.srcFilename + ".idx";
+
+	return true;
+}
+
+int main (int argc, const char* const* argv)
+{
+	try
+	{
+		CommandLine			cmdLine;
+		xe::TestLogIndex	index;
+
+		if (!parseCommandLine(cmdLine, argc, argv))
+		{
+			printHelp(argv[0]);
+			return -1;
+		}
+
+		xe::buildTestLogIndex(index, cmdLine.srcFilename.c_str());
+		xe::writeTestLogIndex(cmdLine.dstFilename.c_str(), index);
+
+		printf("Wrote %d entries to %s\n", index.getNumEntries(), cmdLine.dstFilename.c_str());
+	}
+	catch (const std::exception& e)
+	{
+		printf("FATAL ERROR: %s\n", e.what());
+		return -1;
+	}
+
+	return 0;
+}
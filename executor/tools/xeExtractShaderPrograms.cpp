@@ -23,6 +23,7 @@
 
 #include "xeTestLogParser.hpp"
 #include "xeTestResultParser.hpp"
+#include "xeTestLogIndex.hpp"
 #include "deFilePath.hpp"
 #include "deStringUtil.hpp"
 #include "deString.h"
@@ -31,6 +32,7 @@
 #include <string>
 #include <cstdio>
 #include <cstdlib>
+#include <cstring>
 #include <fstream>
 #include <iostream>
 #include <stdexcept>
@@ -46,8 +48,9 @@ struct CommandLine
 	{
 	}
 
-	string		filename;
-	string		dstPath;
+	string			filename;
+	string			dstPath;
+	vector<string>	casePaths;		//!< If non-empty, only these cases are extracted using log index.
 };
 
 static const char* getShaderTypeSuffix (const xe::ri::Shader::ShaderType shaderType)
@@ -196,9 +199,25 @@ static void extractShaderProgramsFromLogFile (const CommandLine& cmdLine)
 	in.close();
 }
 
+static void extractShaderProgramsFromIndexedLog (const CommandLine& cmdLine)
+{
+	const xe::IndexedTestLog log (cmdLine.filename.c_str());
+
+	for (vector<string>::const_iterator casePath = cmdLine.casePaths.begin(); casePath != cmdLine.casePaths.end(); ++casePath)
+	{
+		xe::TestCaseResult result;
+
+		if (!log.getTestCaseResult(casePath->c_str(), result))
+			throw xe::Error("Test case '" + *casePath + "' not found in log");
+
+		extractShaderPrograms(cmdLine, *casePath, result);
+	}
+}
+
 static void printHelp (const char* binName)
 {
 	printf("%s: [filename] [dst path (optional)]\n", binName);
+	printf("  --case=[case path]  Extract only given case (can be repeated). Uses <filename>.idx if available.\n");
 }
 
 static bool parseCommandLine (CommandLine& cmdLine, int argc, const char* const* argv)
@@ -216,6 +235,8 @@ static bool parseCommandLine (CommandLine& cmdLine, int argc, const char* const*
 			else
 				return false;
 		}
+		else if (deStringBeginsWith(arg, "--case="))
+			cmdLine.casePaths.push_back(arg + strlen("--case="));
 		else
 			return false;
 	}
@@ -238,7 +259,10 @@ int main (int argc, const char* const* argv)
 			return -1;
 		}
 
-		extractShaderProgramsFromLogFile(cmdLine);
+		if (cmdLine.casePaths.empty())
+			extractShaderProgramsFromLogFile(cmdLine);
+		else
+			extractShaderProgramsFromIndexedLog(cmdLine);
 	}
 	catch (const std::exception& e)
 	{
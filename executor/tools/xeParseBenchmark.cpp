@@ -0,0 +1,178 @@
+/*-------------------------------------------------------------------------
+ * drawElements Quality Program Test Executor
+ * ------------------------------------------
+ *
+ * Copyright 2014 The Android Open Source Project
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ *      http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ *
+ *//*!
+ * \file
+ * \brief Test result parser benchmark.
+ *
+ * Parses a synthetic performance test case result with a large sample
+ * list and reports parse throughput.
+ *//*--------------------------------------------------------------------*/
+
+#include "xeTestResultParser.hpp"
+#include "deClock.h"
+#include "deString.h"
+#include "deStringUtil.hpp"
+
+#include <string>
+#include <sstream>
+#include <cstdio>
+#include <cstdlib>
+#include <cstring>
+#include <stdexcept>
+
+using std::string;
+
+struct CommandLine
+{
+	CommandLine (void)
+		: numSamples	(100000)
+		, numValues		(4)
+		, numIterations	(5)
+	{
+	}
+
+	int		numSamples;
+	int		numValues;
+	int		numIterations;
+};
+
+static string generatePerformanceCaseResult (int numSamples, int numValues)
+{
+	std::ostringstream str;
+
+	str << "<?xml version=\"1.0\" encoding=\"UTF-8\"?>\n"
+		<< "<TestCaseResult Version=\"0.3.4\" CasePath=\"dEQP-GLES3.performance.synthetic\" CaseType=\"Performance\">\n"
+		<< " <Text>Synthetic performance test result</Text>\n"
+		<< " <SampleList Name=\"Samples\" Description=\"Samples\">\n"
+		<< "  <SampleInfo>\n";
+
+	for (int valueNdx = 0; valueNdx < numValues; valueNdx++)
+		str << "   <ValueInfo Name=\"Value" << valueNdx << "\" Description=\"Value " << valueNdx << "\" Tag=\"" << (valueNdx == numValues-1 ? "Response" : "Predictor") << "\" Unit=\"us\"/>\n";
+
+	str << "  </SampleInfo>\n";
+
+	for (int sampleNdx = 0; sampleNdx < numSamples; sampleNdx++)
+	{
+		str << "  <Sample>";
+		for (int valueNdx = 0; valueNdx < numValues; valueNdx++)
+		{
+			if (valueNdx == numValues-1)
+				str << "<Value>" << (double)sampleNdx * 0.125 + 1.0 << "</Value>";
+			else
+				str << "<Value>" << sampleNdx*(valueNdx+1) << "</Value>";
+		}
+		str << "</Sample>\n";
+	}
+
+	str << " </SampleList>\n"
+		<< " <Result StatusCode=\"Pass\">Pass</Result>\n"
+		<< "</TestCaseResult>\n";
+
+	return str.str();
+}
+
+static void runBenchmark (const CommandLine& cmdLine)
+{
+	const string			data		= generatePerformanceCaseResult(cmdLine.numSamples, cmdLine.numValues);
+	xe::TestResultParser	parser;
+	deUint64				totalTime	= 0;
+
+	printf("Parsing %d samples x %d values (%.2f MB), %d iterations\n",
+		   cmdLine.numSamples, cmdLine.numValues, (double)data.size() / (1024.0*1024.0), cmdLine.numIterations);
+
+	for (int iterNdx = 0; iterNdx < cmdLine.numIterations; iterNdx++)
+	{
+		const deUint64 startTime = deGetMicroseconds();
+
+		{
+			xe::TestCaseResult	result;
+
+			parser.init(&result);
+
+			// \note Terminating null is included to signal end of data.
+			if (parser.parse((const deUint8*)data.c_str(), (int)data.size()+1) != xe::TestResultParser::PARSERESULT_COMPLETE)
+				throw xe::Error("Failed to parse synthetic test result: " + result.statusDetails);
+
+			// \note Result destruction is included in timing.
+		}
+
+		{
+			const deUint64 iterTime = deGetMicroseconds() - startTime;
+
+			printf("  iteration %d: %.2f ms\n", iterNdx, (double)iterTime / 1000.0);
+			totalTime += iterTime;
+		}
+	}
+
+	{
+		const double avgTimeSec = (double)totalTime / (double)cmdLine.numIterations / 1e6;
+
+		printf("Average: %.2f ms, %.2f MB/s, %.0f samples/s\n",
+			   avgTimeSec * 1000.0,
+			   (double)data.size() / (1024.0*1024.0) / avgTimeSec,
+			   (double)cmdLine.numSamples / avgTimeSec);
+	}
+}
+
+static void printHelp (const char* binName)
+{
+	printf("%s: [--samples=N] [--values=N] [--iterations=N]\n", binName);
+}
+
+static bool parseCommandLine (CommandLine& cmdLine, int argc, const char* const* argv)
+{
+	for (int argNdx = 1; argNdx < argc; argNdx++)
+	{
+		const char* arg = argv[argNdx];
+
+		if (deStringBeginsWith(arg, "--samples="))
+			cmdLine.numSamples = atoi(arg + strlen("--samples="));
+		else if (deStringBeginsWith(arg, "--values="))
+			cmdLine.numValues = atoi(arg + strlen("--values="));
+		else if (deStringBeginsWith(arg, "--iterations="))
+			cmdLine.numIterations = atoi(arg + strlen("--iterations="));
+		else
+			return false;
+	}
+
+	return cmdLine.numSamples > 0 && cmdLine.numValues > 0 && cmdLine.numIterations > 0;
+}
+
+int main (int argc, const char* const* argv)
+{
+	try
+	{
+		CommandLine cmdLine;
+
+		if (!parseCommandLine(cmdLine, argc, argv))
+		{
+			printHelp(argv[0]);
+			return -1;
+		}
+
+		runBenchmark(cmdLine);
+	}
+	catch (const std::exception& e)
+	{
+		printf("FATAL ERROR: %s\n", e.what());
+		return -1;
+	}
+
+	return 0;
+}
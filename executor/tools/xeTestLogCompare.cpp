@@ -21,26 +21,20 @@
  * \brief Test log compare utility.
  *//*--------------------------------------------------------------------*/
 
-#include "xeTestLogParser.hpp"
-#include "xeTestResultParser.hpp"
+#include "xeTestLogDiff.hpp"
 #include "deFilePath.hpp"
-#include "deString.h"
-#include "deThread.hpp"
 #include "deCommandLine.hpp"
 
 #include <vector>
 #include <string>
 #include <cstdio>
 #include <cstdlib>
-#include <fstream>
 #include <iostream>
-#include <set>
-#include <map>
+#include <sstream>
+#include <stdexcept>
 
 using std::vector;
 using std::string;
-using std::set;
-using std::map;
 
 enum OutputMode
 {
@@ -72,6 +66,15 @@ namespace opt
 DE_DECLARE_COMMAND_LINE_OPT(OutMode,	OutputMode);
 DE_DECLARE_COMMAND_LINE_OPT(OutFormat,	OutputFormat);
 DE_DECLARE_COMMAND_LINE_OPT(OutValue,	OutputValue);
+DE_DECLARE_COMMAND_LINE_OPT(Values,		bool);
+DE_DECLARE_COMMAND_LINE_OPT(Threshold,	double);
+
+static void parseThreshold (const char* src, double* dst)
+{
+	std::istringstream str(src);
+	if (!(str >> *dst) || !str.eof() || *dst < 0.0)
+		throw std::invalid_argument("invalid threshold");
+}
 
 static void registerOptions (de::cmdline::Parser& parser)
 {
@@ -96,7 +99,9 @@ static void registerOptions (de::cmdline::Parser& parser)
 
 	parser << Option<OutFormat>		("f",	"format",		"Output format",	s_outputFormats,	"csv")
 		   << Option<OutMode>		("m",	"mode",			"Output mode",		s_outputModes,		"all")
-		   << Option<OutValue>		("v",	"value",		"Value to extract",	s_outputValues,		"code");
+		   << Option<OutValue>		("v",	"value",		"Value to extract",	s_outputValues,		"code")
+		   << Option<Values>		("n",	"values",		"Compare numbers and sample list medians (requires text format)")
+		   << Option<Threshold>		("t",	"threshold",	"Max relative change of a compared number",	parseThreshold,	"0.05");
 }
 
 } // opt
@@ -107,152 +112,19 @@ struct CommandLine
 		: outMode	(OUTPUTMODE_ALL)
 		, outFormat	(OUTPUTFORMAT_CSV)
 		, outValue	(OUTPUTVALUE_STATUS_CODE)
+		, values	(false)
+		, threshold	(0.0)
 	{
 	}
 
 	OutputMode			outMode;
 	OutputFormat		outFormat;
 	OutputValue			outValue;
+	bool				values;
+	double				threshold;
 	vector<string>		filenames;
 };
 
-struct ShortBatchResult
-{
-	vector<xe::TestCaseResultHeader>	resultHeaders;
-	map<string, int>					resultMap;
-};
-
-class ShortResultHandler : public xe::TestLogHandler
-{
-public:
-	ShortResultHandler (ShortBatchResult& result)
-		: m_result(result)
-	{
-	}
-
-	void setSessionInfo (const xe::SessionInfo&)
-	{
-		// Ignored.
-	}
-
-	xe::TestCaseResultPtr startTestCaseResult (const char* casePath)
-	{
-		return xe::TestCaseResultPtr(new xe::TestCaseResultData(casePath));
-	}
-
-	void testCaseResultUpdated (const xe::TestCaseResultPtr&)
-	{
-		// Ignored.
-	}
-
-	void testCaseResultComplete (const xe::TestCaseResultPtr& caseData)
-	{
-		xe::TestCaseResultHeader	header;
-		int							caseNdx	= (int)m_result.resultHeaders.size();
-
-		header.casePath			= caseData->getTestCasePath();
-		header.caseType			= xe::TESTCASETYPE_SELF_VALIDATE;
-		header.statusCode		= caseData->getStatusCode();
-		header.statusDetails	= caseData->getStatusDetails();
-
-		if (header.statusCode == xe::TESTSTATUSCODE_LAST)
-		{
-			xe::TestCaseResult fullResult;
-
-			xe::parseTestCaseResultFromData(&m_testResultParser, &fullResult, *caseData.get());
-
-			header = xe::TestCaseResultHeader(fullResult);
-		}
-
-		// Insert into result list & map.
-		m_result.resultHeaders.push_back(header);
-		m_result.resultMap[header.casePath] = caseNdx;
-	}
-
-private:
-	ShortBatchResult&		m_result;
-	xe::TestResultParser	m_testResultParser;
-};
-
-static void readLogFile (ShortBatchResult& batchResult, const char* filename)
-{
-	std::ifstream		in				(filename, std::ifstream::binary|std::ifstream::in);
-	ShortResultHandler	resultHandler	(batchResult);
-	xe::TestLogParser	parser			(&resultHandler);
-	deUint8				buf				[1024];
-	int					numRead			= 0;
-
-	for (;;)
-	{
-		in.read((char*)&buf[0], DE_LENGTH_OF_ARRAY(buf));
-		numRead = (int)in.gcount();
-
-		if (numRead <= 0)
-			break;
-
-		parser.parse(&buf[0], numRead);
-	}
-
-	in.close();
-}
-
-class LogFileReader : public de::Thread
-{
-public:
-	LogFileReader (ShortBatchResult& batchResult, const char* filename)
-		: m_batchResult	(batchResult)
-		, m_filename	(filename)
-	{
-	}
-
-	void run (void)
-	{
-		readLogFile(m_batchResult, m_filename.c_str());
-	}
-
-private:
-	ShortBatchResult&	m_batchResult;
-	std::string			m_filename;
-};
-
-static void computeCaseList (vector<string>& cases, const vector<ShortBatchResult>& batchResults)
-{
-	// \todo [2012-07-10 pyry] Do proper case ordering (eg. handle missing cases nicely).
-	set<string> addedCases;
-
-	for (vector<ShortBatchResult>::const_iterator batchIter = batchResults.begin(); batchIter != batchResults.end(); batchIter++)
-	{
-		for (vector<xe::TestCaseResultHeader>::const_iterator caseIter = batchIter->resultHeaders.begin(); caseIter != batchIter->resultHeaders.end(); caseIter++)
-		{
-			if (addedCases.find(caseIter->casePath) == addedCases.end())
-			{
-				cases.push_back(caseIter->casePath);
-				addedCases.insert(caseIter->casePath);
-			}
-		}
-	}
-}
-
-static void getTestResultHeaders (vector<xe::TestCaseResultHeader>& headers, const vector<ShortBatchResult>& batchResults, const char* casePath)
-{
-	headers.resize(batchResults.size());
-
-	for (int ndx = 0; ndx < (int)batchResults.size(); ndx++)
-	{
-		const ShortBatchResult&				batchResult	= batchResults[ndx];
-		map<string, int>::const_iterator	resultPos	= batchResult.resultMap.find(casePath);
-
-		if (resultPos != batchResult.resultMap.end())
-			headers[ndx] = batchResult.resultHeaders[resultPos->second];
-		else
-		{
-			headers[ndx].casePath	= casePath;
-			headers[ndx].caseType	= xe::TESTCASETYPE_SELF_VALIDATE;
-			headers[ndx].statusCode	= xe::TESTSTATUSCODE_LAST;
-		}
-	}
-}
-
 static const char* getStatusCodeName (xe::TestStatusCode code)
 {
 	if (code == xe::TESTSTATUSCODE_LAST)
@@ -263,40 +135,29 @@ static const char* getStatusCodeName (xe::TestStatusCode code)
 
 static bool runCompare (const CommandLine& cmdLine, std::ostream& dst)
 {
-	vector<ShortBatchResult>	results;
-	vector<string>				batchNames;
-	bool						compareOk	= true;
+	vector<string>	batchNames;
+	bool			compareOk	= true;
 
 	XE_CHECK(!cmdLine.filenames.empty());
 
 	try
 	{
-		// Read in batch results
-		results.resize(cmdLine.filenames.size());
-		{
-			std::vector<de::SharedPtr<LogFileReader> > readers;
+		xe::TestLogDiffParams params;
 
-			for (int ndx = 0; ndx < (int)cmdLine.filenames.size(); ndx++)
-			{
-				readers.push_back(de::SharedPtr<LogFileReader>(new LogFileReader(results[ndx], cmdLine.filenames[ndx].c_str())));
-				readers.back()->start();
-			}
+		params.parseDetails		= cmdLine.outFormat == OUTPUTFORMAT_TEXT || cmdLine.outValue == OUTPUTVALUE_STATUS_DETAILS;
+		params.compareValues	= cmdLine.values;
+		params.valueThreshold	= cmdLine.threshold;
 
-			for (int ndx = 0; ndx < (int)cmdLine.filenames.size(); ndx++)
-			{
-				readers[ndx]->join();
+		// Opens logs and reads or builds indices in parallel.
+		xe::TestLogDiff	diff		(cmdLine.filenames, params);
+		xe::CaseDiff	caseDiff;
 
-				// Use file name as batch name.
-				batchNames.push_back(de::FilePath(cmdLine.filenames[ndx].c_str()).getBaseName());
-			}
-		}
-
-		// Compute unified case list.
-		vector<string> caseList;
-		computeCaseList(caseList, results);
+		// Use file name as batch name.
+		for (vector<string>::const_iterator filename = cmdLine.filenames.begin(); filename != cmdLine.filenames.end(); ++filename)
+			batchNames.push_back(de::FilePath(filename->c_str()).getBaseName());
 
 		// Stats.
-		int		numCases		= (int)caseList.size();
+		int		numCases		= 0;
 		int		numEqual		= 0;
 
 		if (cmdLine.outFormat == OUTPUTFORMAT_CSV)
@@ -307,23 +168,14 @@ static bool runCompare (const CommandLine& cmdLine, std::ostream& dst)
 			dst << "\n";
 		}
 
-		// Compare cases.
-		for (vector<string>::const_iterator caseIter = caseList.begin(); caseIter != caseList.end(); caseIter++)
+		// Compare cases in path order.
+		while (diff.next(caseDiff))
 		{
-			const string&						caseName	= *caseIter;
-			vector<xe::TestCaseResultHeader>	headers;
-			bool								allEqual	= true;
-
-			getTestResultHeaders(headers, results, caseName.c_str());
+			const string&						caseName	= caseDiff.casePath;
+			const vector<xe::CaseSummary>&		results		= caseDiff.results;
+			const bool							allEqual	= caseDiff.flags == 0;
 
-			for (vector<xe::TestCaseResultHeader>::const_iterator iter = headers.begin()+1; iter != headers.end(); iter++)
-			{
-				if (iter->statusCode != headers[0].statusCode)
-				{
-					allEqual = false;
-					break;
-				}
-			}
+			numCases += 1;
 
 			if (allEqual)
 				numEqual += 1;
@@ -333,14 +185,17 @@ static bool runCompare (const CommandLine& cmdLine, std::ostream& dst)
 				if (cmdLine.outFormat == OUTPUTFORMAT_TEXT)
 				{
 					dst << caseName << "\n";
-					for (int ndx = 0; ndx < (int)headers.size(); ndx++)
-						dst << "  " << batchNames[ndx] << ": " << getStatusCodeName(headers[ndx].statusCode) << " (" << headers[ndx].statusDetails << ")\n";
+					for (int ndx = 0; ndx < (int)results.size(); ndx++)
+						dst << "  " << batchNames[ndx] << ": " << getStatusCodeName(results[ndx].statusCode) << " (" << results[ndx].statusDetails << ")\n";
+					for (vector<xe::CaseValueDiff>::const_iterator iter = caseDiff.valueDiffs.begin(); iter != caseDiff.valueDiffs.end(); iter++)
+						dst << "  " << batchNames[iter->logNdx] << ": " << iter->name << " " << iter->reference << " -> " << iter->value
+							<< " (" << (iter->relativeChange >= 0.0 ? "+" : "") << iter->relativeChange*100.0 << "%)\n";
 					dst << "\n";
 				}
 				else if (cmdLine.outFormat == OUTPUTFORMAT_CSV)
 				{
 					dst << caseName;
-					for (vector<xe::TestCaseResultHeader>::const_iterator iter = headers.begin(); iter != headers.end(); iter++)
+					for (vector<xe::CaseSummary>::const_iterator iter = results.begin(); iter != results.end(); iter++)
 						dst << "," << (cmdLine.outValue == OUTPUTVALUE_STATUS_CODE ? getStatusCodeName(iter->statusCode) : iter->statusDetails.c_str());
 					dst << "\n";
 				}
@@ -377,13 +232,22 @@ static bool parseCommandLine (CommandLine& cmdLine, int argc, const char* const*
 		opts.getArgs().empty())
 	{
 		std::cout << argv[0] << ": [options] [filenames]\n";
+		std::cout << "Cases are listed in case path order. First log is the reference.\n";
 		parser.help(std::cout);
 		return false;
 	}
 
+	if (opts.getOption<opt::Values>() && opts.getOption<opt::OutFormat>() != OUTPUTFORMAT_TEXT)
+	{
+		std::cerr << "--values requires --format=text\n";
+		return false;
+	}
+
 	cmdLine.outFormat	= opts.getOption<opt::OutFormat>();
 	cmdLine.outMode		= opts.getOption<opt::OutMode>();
 	cmdLine.outValue	= opts.getOption<opt::OutValue>();
+	cmdLine.values		= opts.getOption<opt::Values>();
+	cmdLine.threshold	= opts.getOption<opt::Threshold>();
 	cmdLine.filenames	= opts.getArgs();
 
 	return true;
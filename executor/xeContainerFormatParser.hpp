@@ -62,6 +62,7 @@ public:
 	void						advance						(void);
 
 	ContainerElement			getElement					(void) const { return m_element; }
+	int							getElementLength			(void) const { return m_elementLen; }	//!< Number of bytes in current element.
 
 	// SESSION_INFO
 	const char*					getSessionInfoAttribute		(void) const;
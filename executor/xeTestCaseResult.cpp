@@ -57,16 +57,41 @@ namespace ri
 {
 
 List::List (void)
+	: m_pool(DE_NULL)
+{
+}
+
+List::List (de::MemPool* pool)
+	: m_pool(pool)
 {
 }
 
 List::~List (void)
 {
 	for (std::vector<Item*>::iterator i = m_items.begin(); i != m_items.end(); i++)
-		delete *i;
+	{
+		// Pool-allocated items are only destructed, memory is released with the pool.
+		if (m_pool)
+			(*i)->~Item();
+		else
+			delete *i;
+	}
 	m_items.clear();
 }
 
+void List::setPool (de::MemPool* pool)
+{
+	DE_ASSERT(m_items.empty());
+	m_pool = pool;
+}
+
+void List::reserveItem (void)
+{
+	// \note Grow geometrically; reserving one element at a time makes long sample lists quadratic.
+	if (m_items.size() == m_items.capacity())
+		m_items.reserve(de::max<size_t>(m_items.size()*2, 4));
+}
+
 std::ostream& operator<< (std::ostream& str, const NumericValue& value)
 {
 	switch (value.getType())
@@ -25,6 +25,7 @@
 
 #include "xeDefs.hpp"
 #include "xeTestCase.hpp"
+#include "deMemPool.hpp"
 
 #include <string>
 #include <vector>
@@ -82,12 +83,23 @@ class SampleValue;
 
 // \todo [2014-02-28 pyry] Make List<T> for items that have only specific subitems.
 
+/*--------------------------------------------------------------------*//*!
+ * \brief Result item list
+ *
+ * If list has a memory pool, items are allocated from the pool and child
+ * lists of the items share the same pool. Item memory is released only
+ * when pool is destroyed.
+ *//*--------------------------------------------------------------------*/
 class List
 {
 public:
 							List			(void);
+	explicit				List			(de::MemPool* pool);
 							~List			(void);
 
+	void					setPool			(de::MemPool* pool);
+	de::MemPool*			getPool			(void) const	{ return m_pool;				}
+
 	int						getNumItems		(void) const	{ return (int)m_items.size();	}
 	const Item&				getItem			(int ndx) const	{ return *m_items[ndx];			}
 	Item&					getItem			(int ndx)		{ return *m_items[ndx];			}
@@ -96,14 +108,30 @@ public:
 	T*						allocItem		(void);
 
 private:
+							List			(const List& other);
+	List&					operator=		(const List& other);
+
+	void					reserveItem		(void);
+
+	de::MemPool*			m_pool;
 	std::vector<Item*>		m_items;
 };
 
 template <typename T>
 T* List::allocItem (void)
 {
-	m_items.reserve(m_items.size()+1);
-	T* item = new T();
+	reserveItem();
+
+	T* item = DE_NULL;
+
+	if (m_pool)
+	{
+		item = new (m_pool->alignedAlloc(sizeof(T), (deUint32)sizeof(deUint64))) T();
+		initItemLists(item, m_pool);
+	}
+	else
+		item = new T();
+
 	m_items.push_back(static_cast<ri::Item*>(item));
 	return item;
 }
@@ -123,6 +151,15 @@ public:
 
 class TestCaseResult : public TestCaseResultHeader
 {
+public:
+						TestCaseResult			(void) : resultItems(&m_itemPool) {}
+
+private:
+						TestCaseResult			(const TestCaseResult& other);
+	TestCaseResult&		operator=				(const TestCaseResult& other);
+
+	de::MemPool			m_itemPool;				//!< Memory for result items. \note Must be declared before resultItems.
+
 public:
 	ri::List			resultItems;			//!< Test log items.
 };
@@ -512,6 +549,22 @@ public:
 	List				samples;
 };
 
+// Child list pool propagation for List::allocItem().
+
+inline void initItemLists (Item*, de::MemPool*)							{}
+inline void initItemLists (ImageSet* item, de::MemPool* pool)			{ item->images.setPool(pool);		}
+inline void initItemLists (ShaderProgram* item, de::MemPool* pool)		{ item->shaders.setPool(pool);		}
+inline void initItemLists (EglConfigSet* item, de::MemPool* pool)		{ item->configs.setPool(pool);		}
+inline void initItemLists (Section* item, de::MemPool* pool)			{ item->items.setPool(pool);		}
+inline void initItemLists (SampleInfo* item, de::MemPool* pool)			{ item->valueInfos.setPool(pool);	}
+inline void initItemLists (Sample* item, de::MemPool* pool)				{ item->values.setPool(pool);		}
+
+inline void initItemLists (SampleList* item, de::MemPool* pool)
+{
+	item->sampleInfo.valueInfos.setPool(pool);
+	item->samples.setPool(pool);
+}
+
 } // ri
 } // xe
 
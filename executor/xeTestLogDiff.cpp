@@ -0,0 +1,364 @@
+/*-------------------------------------------------------------------------
+ * drawElements Quality Program Test Executor
+ * ------------------------------------------
+ *
+ * Copyright 2014 The Android Open Source Project
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ *      http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ *
+ *//*!
+ * \file
+ * \brief Streaming test log comparison.
+ *//*--------------------------------------------------------------------*/
+
+#include "xeTestLogDiff.hpp"
+#include "deThread.hpp"
+#include "deSharedPtr.hpp"
+#include "deMath.h"
+
+#include <algorithm>
+#include <limits>
+
+using std::string;
+using std::vector;
+
+namespace xe
+{
+
+namespace
+{
+
+double getValue (const ri::NumericValue& value)
+{
+	if (value.getType() == ri::NumericValue::TYPE_INT64)
+		return (double)value.getInt64();
+	else
+		return value.getFloat64();
+}
+
+double getMedian (vector<double>& values)
+{
+	DE_ASSERT(!values.empty());
+
+	const size_t mid = values.size()/2;
+
+	std::nth_element(values.begin(), values.begin()+mid, values.end());
+
+	if (values.size() % 2 == 0)
+		return (values[mid] + *std::max_element(values.begin(), values.begin()+mid)) * 0.5;
+	else
+		return values[mid];
+}
+
+void summarizeSampleList (vector<CaseValue>& dst, const ri::SampleList& sampleList)
+{
+	const ri::List&	valueInfos	= sampleList.sampleInfo.valueInfos;
+	vector<double>	values;
+
+	for (int valueNdx = 0; valueNdx < valueInfos.getNumItems(); valueNdx++)
+	{
+		const ri::ValueInfo& valueInfo = static_cast<const ri::ValueInfo&>(valueInfos.getItem(valueNdx));
+
+		// Only responses are compared; predictors are inputs of the measurement.
+		if (valueInfo.tag != ri::ValueInfo::VALUETAG_RESPONSE)
+			continue;
+
+		values.clear();
+
+		for (int sampleNdx = 0; sampleNdx < sampleList.samples.getNumItems(); sampleNdx++)
+		{
+			const ri::Sample& sample = static_cast<const ri::Sample&>(sampleList.samples.getItem(sampleNdx));
+
+			if (valueNdx < sample.values.getNumItems())
+			{
+				const ri::NumericValue& value = static_cast<const ri::SampleValue&>(sample.values.getItem(valueNdx)).value;
+
+				if (value.getType() != ri::NumericValue::TYPE_EMPTY)
+					values.push_back(getValue(value));
+			}
+		}
+
+		if (!values.empty())
+			dst.push_back(CaseValue(sampleList.name + "." + valueInfo.name, getMedian(values)));
+	}
+}
+
+void summarizeItems (vector<CaseValue>& dst, const ri::List& items)
+{
+	for (int itemNdx = 0; itemNdx < items.getNumItems(); itemNdx++)
+	{
+		const ri::Item& item = items.getItem(itemNdx);
+
+		if (item.getType() == ri::TYPE_NUMBER)
+		{
+			const ri::Number& number = static_cast<const ri::Number&>(item);
+
+			if (number.value.getType() != ri::NumericValue::TYPE_EMPTY)
+				dst.push_back(CaseValue(number.name, getValue(number.value)));
+		}
+		else if (item.getType() == ri::TYPE_SAMPLELIST)
+			summarizeSampleList(dst, static_cast<const ri::SampleList&>(item));
+		else if (item.getType() == ri::TYPE_SECTION)
+			summarizeItems(dst, static_cast<const ri::Section&>(item).items);
+	}
+}
+
+struct CaseValueNameLess
+{
+	bool operator() (const CaseValue& a, const CaseValue& b) const { return a.name < b.name; }
+};
+
+double computeRelativeChange (double reference, double value)
+{
+	if (reference != 0.0)
+		return (value - reference) / deAbs(reference);
+	else if (value == 0.0)
+		return 0.0;
+	else
+		return value > 0.0 ? std::numeric_limits<double>::infinity() : -std::numeric_limits<double>::infinity();
+}
+
+class LogLoader : public de::Thread
+{
+public:
+	LogLoader (const string& filename)
+		: m_filename	(filename)
+		, m_log			(DE_NULL)
+	{
+	}
+
+	~LogLoader (void)
+	{
+		delete m_log;
+	}
+
+	void run (void)
+	{
+		try
+		{
+			m_log = new IndexedTestLog(m_filename.c_str());
+
+			// Sort index here instead of on first access from the compare loop.
+			if (m_log->getIndex().getNumEntries() > 0)
+				m_log->getIndex().getSortedEntry(0);
+		}
+		catch (const std::exception& e)
+		{
+			m_error = e.what();
+		}
+	}
+
+	const string&	getError	(void) const	{ return m_error;	}
+
+	IndexedTestLog* releaseLog (void)
+	{
+		IndexedTestLog* const log = m_log;
+		m_log = DE_NULL;
+		return log;
+	}
+
+private:
+	const string		m_filename;
+	IndexedTestLog*		m_log;
+	string				m_error;
+};
+
+} // anonymous
+
+void summarizeCaseValues (vector<CaseValue>& dst, const TestCaseResult& result)
+{
+	dst.clear();
+	summarizeItems(dst, result.resultItems);
+	std::stable_sort(dst.begin(), dst.end(), CaseValueNameLess());
+}
+
+TestLogDiff::TestLogDiff (const vector<string>& logFilenames, const TestLogDiffParams& params)
+	: m_params		(params)
+	, m_positions	(logFilenames.size(), 0)
+{
+	vector<de::SharedPtr<LogLoader> > loaders;
+
+	XE_CHECK(!logFilenames.empty());
+
+	for (vector<string>::const_iterator filename = logFilenames.begin(); filename != logFilenames.end(); ++filename)
+	{
+		loaders.push_back(de::SharedPtr<LogLoader>(new LogLoader(*filename)));
+		loaders.back()->start();
+	}
+
+	for (vector<de::SharedPtr<LogLoader> >::iterator loader = loaders.begin(); loader != loaders.end(); ++loader)
+		(*loader)->join();
+
+	try
+	{
+		for (int ndx = 0; ndx < (int)loaders.size(); ndx++)
+		{
+			if (!loaders[ndx]->getError().empty())
+				throw Error(logFilenames[ndx] + ": " + loaders[ndx]->getError());
+
+			m_logs.push_back(loaders[ndx]->releaseLog());
+		}
+	}
+	catch (...)
+	{
+		for (vector<IndexedTestLog*>::iterator log = m_logs.begin(); log != m_logs.end(); ++log)
+			delete *log;
+		throw;
+	}
+}
+
+TestLogDiff::~TestLogDiff (void)
+{
+	for (vector<IndexedTestLog*>::iterator log = m_logs.begin(); log != m_logs.end(); ++log)
+		delete *log;
+}
+
+const TestLogIndexEntry* TestLogDiff::nextEntry (int logNdx, const string& casePath)
+{
+	const TestLogIndex&			index	= m_logs[logNdx]->getIndex();
+	int&						pos		= m_positions[logNdx];
+	const TestLogIndexEntry*	entry	= DE_NULL;
+
+	// If case was run several times, last result is used.
+	while (pos < index.getNumEntries() && index.getSortedEntry(pos).casePath == casePath)
+		entry = &index.getSortedEntry(pos++);
+
+	return entry;
+}
+
+void TestLogDiff::getSummary (CaseSummary& dst, int logNdx, const TestLogIndexEntry& entry)
+{
+	dst.found		= true;
+	dst.statusCode	= entry.statusCode;
+
+	if (m_params.parseDetails || m_params.compareValues || entry.statusCode == TESTSTATUSCODE_LAST)
+	{
+		// Result is local so that its item memory is released after each case.
+		TestCaseResult result;
+
+		m_logs[logNdx]->getTestCaseResult(entry, result);
+
+		dst.statusCode		= result.statusCode;
+		dst.statusDetails	= result.statusDetails;
+
+		if (m_params.compareValues)
+			summarizeCaseValues(dst.values, result);
+	}
+}
+
+void TestLogDiff::compareValues (CaseDiff& diff) const
+{
+	const CaseSummary& reference = diff.results[0];
+
+	for (int logNdx = 1; logNdx < (int)diff.results.size(); logNdx++)
+	{
+		const vector<CaseValue>&			refValues	= reference.values;
+		const vector<CaseValue>&			values		= diff.results[logNdx].values;
+		vector<CaseValue>::const_iterator	refIter		= refValues.begin();
+		vector<CaseValue>::const_iterator	iter		= values.begin();
+
+		// Both lists are sorted by name.
+		while (refIter != refValues.end() && iter != values.end())
+		{
+			const int cmp = refIter->name.compare(iter->name);
+
+			if (cmp < 0)
+				++refIter;
+			else if (cmp > 0)
+				++iter;
+			else
+			{
+				const double relativeChange = computeRelativeChange(refIter->value, iter->value);
+
+				if (deAbs(relativeChange) > m_params.valueThreshold)
+				{
+					CaseValueDiff valueDiff;
+
+					valueDiff.logNdx			= logNdx;
+					valueDiff.name				= iter->name;
+					valueDiff.reference			= refIter->value;
+					valueDiff.value				= iter->value;
+					valueDiff.relativeChange	= relativeChange;
+
+					diff.valueDiffs.push_back(valueDiff);
+					diff.flags |= CASEDIFF_VALUE_CHANGED;
+				}
+
+				++refIter;
+				++iter;
+			}
+		}
+	}
+}
+
+bool TestLogDiff::next (CaseDiff& dst)
+{
+	const int		numLogs		= (int)m_logs.size();
+	const string*	minPath		= DE_NULL;
+
+	for (int logNdx = 0; logNdx < numLogs; logNdx++)
+	{
+		const TestLogIndex& index = m_logs[logNdx]->getIndex();
+
+		if (m_positions[logNdx] < index.getNumEntries())
+		{
+			const string& path = index.getSortedEntry(m_positions[logNdx]).casePath;
+
+			if (!minPath || path < *minPath)
+				minPath = &path;
+		}
+	}
+
+	if (!minPath)
+		return false;
+
+	dst.casePath	= *minPath;
+	dst.flags		= 0;
+	dst.valueDiffs.clear();
+	dst.results.resize(numLogs);
+
+	for (int logNdx = 0; logNdx < numLogs; logNdx++)
+	{
+		const TestLogIndexEntry* const	entry	= nextEntry(logNdx, dst.casePath);
+		CaseSummary&					summary	= dst.results[logNdx];
+
+		summary = CaseSummary();
+
+		if (entry)
+			getSummary(summary, logNdx, *entry);
+	}
+
+	{
+		const CaseSummary& reference = dst.results[0];
+
+		if (!reference.found)
+			dst.flags |= CASEDIFF_NEW;
+
+		for (int logNdx = 1; logNdx < numLogs; logNdx++)
+		{
+			const CaseSummary& result = dst.results[logNdx];
+
+			if (reference.found && !result.found)
+				dst.flags |= CASEDIFF_MISSING;
+			else if (reference.found && result.statusCode != reference.statusCode)
+				dst.flags |= CASEDIFF_STATUS_CHANGED;
+		}
+
+		if (m_params.compareValues && reference.found)
+			compareValues(dst);
+	}
+
+	return true;
+}
+
+} // xe
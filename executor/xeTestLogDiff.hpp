@@ -0,0 +1,136 @@
+#ifndef _XETESTLOGDIFF_HPP
+#define _XETESTLOGDIFF_HPP
+/*-------------------------------------------------------------------------
+ * drawElements Quality Program Test Executor
+ * ------------------------------------------
+ *
+ * Copyright 2014 The Android Open Source Project
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ *      http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ *
+ *//*!
+ * \file
+ * \brief Streaming test log comparison.
+ *
+ * Logs are opened as IndexedTestLogs and walked in case path order with
+ * a merge-join over the sorted indices. Only the case currently being
+ * compared is parsed, and only when index data is not sufficient, so
+ * memory use is bounded by the size of the indices.
+ *
+ * First log is the reference that all other logs are compared against.
+ *//*--------------------------------------------------------------------*/
+
+#include "xeDefs.hpp"
+#include "xeTestCaseResult.hpp"
+#include "xeTestLogIndex.hpp"
+
+#include <string>
+#include <vector>
+
+namespace xe
+{
+
+enum CaseDiffFlag
+{
+	CASEDIFF_STATUS_CHANGED		= (1<<0),	//!< Status code differs from reference.
+	CASEDIFF_MISSING			= (1<<1),	//!< Case is in reference but missing from some other log.
+	CASEDIFF_NEW				= (1<<2),	//!< Case is not in reference log.
+	CASEDIFF_VALUE_CHANGED		= (1<<3)	//!< Numeric value changed more than threshold.
+};
+
+struct TestLogDiffParams
+{
+	bool		parseDetails;		//!< Parse case data to get status details.
+	bool		compareValues;		//!< Compare numeric values (Numbers and sample list medians).
+	double		valueThreshold;		//!< Max relative change of a value that is not reported.
+
+	TestLogDiffParams (void)
+		: parseDetails		(false)
+		, compareValues		(false)
+		, valueThreshold	(0.05)
+	{
+	}
+};
+
+//! Numeric value summarized from a case result.
+struct CaseValue
+{
+	std::string		name;			//!< Number name or <sample list>.<value name> for sample list medians.
+	double			value;
+
+	CaseValue (void) : value(0.0) {}
+	CaseValue (const std::string& name_, double value_) : name(name_), value(value_) {}
+};
+
+struct CaseValueDiff
+{
+	int				logNdx;
+	std::string		name;
+	double			reference;
+	double			value;
+	double			relativeChange;	//!< (value - reference) / |reference|
+
+	CaseValueDiff (void) : logNdx(0), reference(0.0), value(0.0), relativeChange(0.0) {}
+};
+
+struct CaseSummary
+{
+	bool					found;
+	TestStatusCode			statusCode;		//!< TESTSTATUSCODE_LAST if case is missing.
+	std::string				statusDetails;	//!< Only set if details or values were parsed.
+	std::vector<CaseValue>	values;			//!< Sorted by name.
+
+	CaseSummary (void) : found(false), statusCode(TESTSTATUSCODE_LAST) {}
+};
+
+struct CaseDiff
+{
+	std::string					casePath;
+	deUint32					flags;		//!< CaseDiffFlag bits.
+	std::vector<CaseSummary>	results;	//!< One per log.
+	std::vector<CaseValueDiff>	valueDiffs;
+
+	CaseDiff (void) : flags(0) {}
+};
+
+//! Summarize numeric values in case result.
+void	summarizeCaseValues		(std::vector<CaseValue>& dst, const TestCaseResult& result);
+
+class TestLogDiff
+{
+public:
+	//! Open logs. Indices are read or built in parallel.
+								TestLogDiff			(const std::vector<std::string>& logFilenames, const TestLogDiffParams& params);
+								~TestLogDiff		(void);
+
+	int							getNumLogs			(void) const { return (int)m_logs.size(); }
+
+	//! Compare next case in path order. Returns false when all cases have been visited.
+	bool						next				(CaseDiff& dst);
+
+private:
+								TestLogDiff			(const TestLogDiff& other);
+	TestLogDiff&				operator=			(const TestLogDiff& other);
+
+	const TestLogIndexEntry*	nextEntry			(int logNdx, const std::string& casePath);
+	void						getSummary			(CaseSummary& dst, int logNdx, const TestLogIndexEntry& entry);
+	void						compareValues		(CaseDiff& diff) const;
+
+	const TestLogDiffParams			m_params;
+	std::vector<IndexedTestLog*>	m_logs;
+	std::vector<int>				m_positions;		//!< Position in sorted index per log.
+};
+
+} // xe
+
+#endif // _XETESTLOGDIFF_HPP
@@ -0,0 +1,511 @@
+/*-------------------------------------------------------------------------
+ * drawElements Quality Program Test Executor
+ * ------------------------------------------
+ *
+ * Copyright 2014 The Android Open Source Project
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ *      http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ *
+ *//*!
+ * \file
+ * \brief Test log case index and random-access log reader.
+ *//*--------------------------------------------------------------------*/
+
+#include "xeTestLogIndex.hpp"
+#include "xeTestResultParser.hpp"
+#include "xeBatchResult.hpp"
+#include "deFile.h"
+#include "deMemory.h"
+#include "deString.h"
+#include "deStringUtil.hpp"
+
+#include <algorithm>
+#include <fstream>
+#include <sstream>
+#include <cstring>
+#include <limits>
+
+using std::string;
+using std::vector;
+
+namespace xe
+{
+
+enum
+{
+	MAX_SCANNED_LINE_LENGTH	= 1024,		//!< Longer log lines are not scanned for status code or duration.
+	FEED_CHUNK_SIZE			= 64*1024
+};
+
+// TestLogIndex
+
+namespace
+{
+
+struct CasePathLess
+{
+	const vector<TestLogIndexEntry>& entries;
+
+	CasePathLess (const vector<TestLogIndexEntry>& entries_) : entries(entries_) {}
+
+	bool operator() (int a, int b) const				{ return entries[a].casePath < entries[b].casePath;	}
+	bool operator() (int a, const char* b) const		{ return entries[a].casePath.compare(b) < 0;		}
+	bool operator() (const char* a, int b) const		{ return entries[b].casePath.compare(a) > 0;		}
+};
+
+} // anonymous
+
+TestLogIndex::TestLogIndex (void)
+	: m_lookupValid(true)
+{
+}
+
+TestLogIndex::~TestLogIndex (void)
+{
+}
+
+void TestLogIndex::clear (void)
+{
+	m_entries.clear();
+	m_lookup.clear();
+	m_lookupValid = true;
+}
+
+void TestLogIndex::addEntry (const TestLogIndexEntry& entry)
+{
+	m_entries.push_back(entry);
+	m_lookupValid = false;
+}
+
+void TestLogIndex::updateLookup (void) const
+{
+	m_lookup.resize(m_entries.size());
+
+	for (int ndx = 0; ndx < (int)m_entries.size(); ndx++)
+		m_lookup[ndx] = ndx;
+
+	std::stable_sort(m_lookup.begin(), m_lookup.end(), CasePathLess(m_entries));
+	m_lookupValid = true;
+}
+
+const TestLogIndexEntry* TestLogIndex::findEntry (const char* casePath) const
+{
+	if (!m_lookupValid)
+		updateLookup();
+
+	// Lookup is stable-sorted, so entry before upper bound is the last one in log order.
+	const vector<int>::const_iterator pos = std::upper_bound(m_lookup.begin(), m_lookup.end(), casePath, CasePathLess(m_entries));
+
+	if (pos != m_lookup.begin() && m_entries[*(pos-1)].casePath == casePath)
+		return &m_entries[*(pos-1)];
+	else
+		return DE_NULL;
+}
+
+const TestLogIndexEntry& TestLogIndex::getSortedEntry (int ndx) const
+{
+	if (!m_lookupValid)
+		updateLookup();
+
+	return m_entries[m_lookup[ndx]];
+}
+
+static TestStatusCode parseIndexStatusCode (const char* str)
+{
+	try
+	{
+		return getTestStatusCode(str);
+	}
+	catch (const TestResultParseError&)
+	{
+		return TESTSTATUSCODE_LAST;
+	}
+}
+
+void readTestLogIndex (TestLogIndex& dst, const char* filename)
+{
+	std::ifstream	in		(filename, std::ifstream::binary|std::ifstream::in);
+	string			line;
+	int				lineNdx	= 0;
+
+	if (!in.good())
+		throw Error(string("Failed to open '") + filename + "'");
+
+	dst.clear();
+
+	while (std::getline(in, line))
+	{
+		std::istringstream	str			(line);
+		TestLogIndexEntry	entry;
+		string				statusCode;
+
+		lineNdx += 1;
+
+		if (line.empty())
+			continue;
+
+		str >> entry.dataOffset >> entry.dataSize >> statusCode >> entry.duration >> entry.casePath;
+
+		if (str.fail() || entry.dataOffset < 0 || entry.dataSize < 0)
+			throw ParseError(string(filename) + ":" + de::toString(lineNdx) + ": invalid index entry");
+
+		entry.statusCode = parseIndexStatusCode(statusCode.c_str());
+
+		dst.addEntry(entry);
+	}
+}
+
+void writeTestLogIndex (const char* filename, const TestLogIndex& index)
+{
+	std::ofstream out(filename, std::ofstream::binary|std::ofstream::out);
+
+	if (!out.good())
+		throw Error(string("Failed to open '") + filename + "'");
+
+	for (int ndx = 0; ndx < index.getNumEntries(); ndx++)
+	{
+		const TestLogIndexEntry& entry = index.getEntry(ndx);
+
+		out << entry.dataOffset << " "
+			<< entry.dataSize << " "
+			<< (entry.statusCode != TESTSTATUSCODE_LAST ? getTestStatusCodeName(entry.statusCode) : "Unknown") << " "
+			<< entry.duration << " "
+			<< entry.casePath << "\n";
+	}
+
+	if (!out.good())
+		throw Error(string("Failed to write '") + filename + "'");
+}
+
+// TestLogIndexBuilder
+
+TestLogIndexBuilder::TestLogIndexBuilder (TestLogIndex* dst)
+	: m_dst			(dst)
+	, m_position	(0)
+	, m_inCase		(false)
+{
+}
+
+TestLogIndexBuilder::~TestLogIndexBuilder (void)
+{
+}
+
+static bool parseQuotedValue (const string& line, size_t start, string& dst)
+{
+	const size_t end = line.find('"', start);
+
+	if (end == string::npos)
+		return false;
+
+	dst = line.substr(start, end-start);
+	return true;
+}
+
+void TestLogIndexBuilder::handleDataLine (void)
+{
+	static const char* const	s_resultPrefix		= "<Result StatusCode=\"";
+	static const char* const	s_durationName		= "Name=\"TestDuration\"";
+	size_t						pos;
+
+	if ((pos = m_curLine.find(s_resultPrefix)) != string::npos)
+	{
+		string statusCode;
+
+		if (parseQuotedValue(m_curLine, pos + strlen(s_resultPrefix), statusCode))
+			m_curEntry.statusCode = parseIndexStatusCode(statusCode.c_str());
+	}
+	else if ((pos = m_curLine.find(s_durationName)) != string::npos && m_curLine.find("<Number") != string::npos)
+	{
+		const size_t valueStart = m_curLine.find('>', pos);
+
+		if (valueStart != string::npos)
+		{
+			std::istringstream	str			(m_curLine.substr(valueStart+1));
+			deInt64				duration	= 0;
+
+			if (str >> duration)
+				m_curEntry.duration = duration;
+		}
+	}
+}
+
+void TestLogIndexBuilder::endCase (TestStatusCode defaultStatusCode)
+{
+	DE_ASSERT(m_inCase);
+
+	m_curEntry.dataSize = m_position - m_curEntry.dataOffset;
+
+	if (m_curEntry.statusCode == TESTSTATUSCODE_LAST)
+		m_curEntry.statusCode = defaultStatusCode;
+
+	m_dst->addEntry(m_curEntry);
+
+	m_curEntry	= TestLogIndexEntry();
+	m_inCase	= false;
+	m_curLine.clear();
+}
+
+void TestLogIndexBuilder::feed (const deUint8* bytes, size_t numBytes)
+{
+	m_containerParser.feed(bytes, numBytes);
+
+	for (;;)
+	{
+		const ContainerElement	element		= m_containerParser.getElement();
+
+		if (element == CONTAINERELEMENT_INCOMPLETE)
+			break;
+
+		const int				elementLen	= m_containerParser.getElementLength();
+
+		switch (element)
+		{
+			case CONTAINERELEMENT_BEGIN_TEST_CASE_RESULT:
+				if (m_inCase)
+					endCase(TESTSTATUSCODE_TERMINATED);
+
+				m_curEntry.casePath		= m_containerParser.getTestCasePath();
+				m_curEntry.dataOffset	= m_position + elementLen;
+				m_inCase				= true;
+				break;
+
+			case CONTAINERELEMENT_END_TEST_CASE_RESULT:
+				if (m_inCase)
+					endCase(TESTSTATUSCODE_LAST);
+				break;
+
+			case CONTAINERELEMENT_TERMINATE_TEST_CASE_RESULT:
+				if (m_inCase)
+				{
+					// Terminate reason overrides anything parsed from partial data.
+					m_curEntry.statusCode = parseIndexStatusCode(m_containerParser.getTerminateReason());
+
+					if (m_curEntry.statusCode == TESTSTATUSCODE_LAST)
+						m_curEntry.statusCode = TESTSTATUSCODE_CRASH;
+
+					endCase(TESTSTATUSCODE_CRASH);
+				}
+				break;
+
+			case CONTAINERELEMENT_END_OF_STRING:
+				if (m_inCase)
+					endCase(TESTSTATUSCODE_TERMINATED);
+				break;
+
+			case CONTAINERELEMENT_TEST_LOG_DATA:
+				if (m_inCase)
+				{
+					// \note Data element may contain only part of line if it was split between feed() calls.
+					const size_t	prevSize	= m_curLine.size();
+					const int		numToCopy	= de::min(elementLen, de::max(0, (int)MAX_SCANNED_LINE_LENGTH - (int)prevSize));
+
+					if (numToCopy > 0)
+					{
+						m_curLine.resize(prevSize + numToCopy);
+						m_containerParser.getData((deUint8*)&m_curLine[prevSize], numToCopy, 0);
+					}
+
+					{
+						deUint8 lastChar = 0;
+						m_containerParser.getData(&lastChar, 1, elementLen-1);
+
+						if (lastChar == '\n' || lastChar == '\r')
+						{
+							handleDataLine();
+							m_curLine.clear();
+						}
+					}
+				}
+				break;
+
+			default:
+				// Session info etc. are not indexed.
+				break;
+		}
+
+		m_position += elementLen;
+		m_containerParser.advance();
+	}
+}
+
+void TestLogIndexBuilder::finish (void)
+{
+	if (m_inCase)
+		endCase(TESTSTATUSCODE_TERMINATED);
+}
+
+void buildTestLogIndex (TestLogIndex& dst, const char* logFilename)
+{
+	std::ifstream		in			(logFilename, std::ifstream::binary|std::ifstream::in);
+	TestLogIndexBuilder	builder		(&dst);
+	deUint8				buf			[4096];
+
+	if (!in.good())
+		throw Error(string("Failed to open '") + logFilename + "'");
+
+	dst.clear();
+
+	for (;;)
+	{
+		in.read((char*)&buf[0], DE_LENGTH_OF_ARRAY(buf));
+
+		const int numRead = (int)in.gcount();
+
+		if (numRead <= 0)
+			break;
+
+		builder.feed(&buf[0], numRead);
+	}
+
+	builder.finish();
+}
+
+// IndexedTestLog
+
+static bool isIndexEntryValid (const TestLogIndexEntry& entry, const deUint8* data, deInt64 dataSize)
+{
+	static const char	beginTag[]	= "#beginTestCaseResult ";
+	const deInt64		tagLen		= (deInt64)sizeof(beginTag)-1;
+	const deInt64		pathLen		= (deInt64)entry.casePath.size();
+	deInt64				lineEnd		= entry.dataOffset-1;
+
+	if (entry.dataOffset < 0 || entry.dataSize < 0 || entry.dataOffset + entry.dataSize > dataSize)
+		return false;
+
+	// Data must start right after "#beginTestCaseResult <path>\n".
+	if (lineEnd < 0 || data[lineEnd] != '\n')
+		return false;
+
+	if (lineEnd > 0 && data[lineEnd-1] == '\r')
+		lineEnd -= 1;
+
+	return lineEnd >= tagLen + pathLen																&&
+		   deMemCmp(data + lineEnd - pathLen, entry.casePath.c_str(), (size_t)pathLen) == 0			&&
+		   deMemCmp(data + lineEnd - pathLen - tagLen, beginTag, (size_t)tagLen) == 0				&&
+		   (lineEnd - pathLen - tagLen == 0 || data[lineEnd - pathLen - tagLen - 1] == '\n');
+}
+
+static bool isIndexValid (const TestLogIndex& index, const deMappedFile* file)
+{
+	const deUint8* const	data		= (const deUint8*)deMappedFile_getPtr(file);
+	const deInt64			dataSize	= deMappedFile_getSize(file);
+
+	for (int ndx = 0; ndx < index.getNumEntries(); ndx++)
+	{
+		if (!isIndexEntryValid(index.getEntry(ndx), data, dataSize))
+			return false;
+	}
+
+	return true;
+}
+
+IndexedTestLog::IndexedTestLog (const char* logFilename, const char* indexFilename)
+	: m_file(deMappedFile_create(logFilename))
+{
+	if (!m_file)
+		throw Error(string("Failed to open '") + logFilename + "'");
+
+	try
+	{
+		const string	defaultIndexFilename	= string(logFilename) + ".idx";
+		const char*		usedIndexFilename		= indexFilename ? indexFilename
+												: deFileExists(defaultIndexFilename.c_str()) ? defaultIndexFilename.c_str()
+												: DE_NULL;
+		bool			indexValid				= false;
+
+		// Index may be stale (e.g. left over from an earlier run with the same
+		// log name) so it is checked against the log and rebuilt if it doesn't match.
+		if (usedIndexFilename)
+		{
+			try
+			{
+				readTestLogIndex(m_index, usedIndexFilename);
+				indexValid = isIndexValid(m_index, m_file);
+			}
+			catch (const ParseError&)
+			{
+				indexValid = false;
+			}
+		}
+
+		if (!indexValid)
+		{
+			const deUint8* const	data		= (const deUint8*)deMappedFile_getPtr(m_file);
+			const deInt64			dataSize	= deMappedFile_getSize(m_file);
+			TestLogIndexBuilder		builder		(&m_index);
+
+			m_index.clear();
+
+			// \note Feed in chunks to keep parser buffer small.
+			for (deInt64 offset = 0; offset < dataSize; offset += FEED_CHUNK_SIZE)
+				builder.feed(data + offset, (size_t)de::min<deInt64>(FEED_CHUNK_SIZE, dataSize - offset));
+
+			builder.finish();
+		}
+	}
+	catch (...)
+	{
+		deMappedFile_destroy(m_file);
+		throw;
+	}
+}
+
+IndexedTestLog::~IndexedTestLog (void)
+{
+	deMappedFile_destroy(m_file);
+}
+
+const deUint8* IndexedTestLog::getCaseData (const TestLogIndexEntry& entry) const
+{
+	DE_ASSERT(entry.dataOffset + entry.dataSize <= deMappedFile_getSize(m_file));
+	return (const deUint8*)deMappedFile_getPtr(m_file) + entry.dataOffset;
+}
+
+void IndexedTestLog::getTestCaseResult (const TestLogIndexEntry& entry, TestCaseResult& dst) const
+{
+	TestCaseResultData	data		(entry.casePath.c_str());
+	TestResultParser	parser;
+	const bool			terminated	= entry.statusCode == TESTSTATUSCODE_CRASH		||
+									  entry.statusCode == TESTSTATUSCODE_TIMEOUT	||
+									  entry.statusCode == TESTSTATUSCODE_TERMINATED;
+
+	// Mimic TestLogParser: status code of completed cases is parsed from data.
+	if (terminated)
+		data.setTestResult(entry.statusCode, getTestStatusCodeName(entry.statusCode));
+	else
+		data.setTestResult(TESTSTATUSCODE_LAST, "");
+
+	XE_CHECK_MSG(entry.dataSize <= (deInt64)std::numeric_limits<int>::max(), "Test case data is too large");
+
+	data.setDataSize((int)entry.dataSize);
+
+	if (entry.dataSize > 0)
+		deMemcpy(data.getData(), getCaseData(entry), (size_t)entry.dataSize);
+
+	parseTestCaseResultFromData(&parser, &dst, data);
+}
+
+bool IndexedTestLog::getTestCaseResult (const char* casePath, TestCaseResult& dst) const
+{
+	const TestLogIndexEntry* const entry = m_index.findEntry(casePath);
+
+	if (entry)
+	{
+		getTestCaseResult(*entry, dst);
+		return true;
+	}
+	else
+		return false;
+}
+
+} // xe
@@ -0,0 +1,149 @@
+#ifndef _XETESTLOGINDEX_HPP
+#define _XETESTLOGINDEX_HPP
+/*-------------------------------------------------------------------------
+ * drawElements Quality Program Test Executor
+ * ------------------------------------------
+ *
+ * Copyright 2014 The Android Open Source Project
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ *      http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ *
+ *//*!
+ * \file
+ * \brief Test log case index and random-access log reader.
+ *
+ * Index maps test case path to location of the case XML data in the log
+ * file. Index is either written by qpTestLog (QP_TEST_LOG_WRITE_INDEX,
+ * --deqp-log-index=enable) into <log>.idx or built offline from an
+ * existing log with TestLogIndexBuilder.
+ *
+ * Index file contains one line per test case:
+ * <data offset> <data size> <status code> <duration in us> <case path>
+ *//*--------------------------------------------------------------------*/
+
+#include "xeDefs.hpp"
+#include "xeTestCaseResult.hpp"
+#include "xeContainerFormatParser.hpp"
+#include "deMappedFile.h"
+
+#include <string>
+#include <vector>
+
+namespace xe
+{
+
+struct TestLogIndexEntry
+{
+	std::string		casePath;
+	deInt64			dataOffset;		//!< Offset of case XML data in log file.
+	deInt64			dataSize;		//!< Size of case XML data in bytes.
+	TestStatusCode	statusCode;		//!< Status code, TESTSTATUSCODE_LAST if not known.
+	deInt64			duration;		//!< Case duration in microseconds, -1 if not known.
+
+	TestLogIndexEntry (void)
+		: dataOffset	(0)
+		, dataSize		(0)
+		, statusCode	(TESTSTATUSCODE_LAST)
+		, duration		(-1)
+	{
+	}
+};
+
+class TestLogIndex
+{
+public:
+									TestLogIndex		(void);
+									~TestLogIndex		(void);
+
+	void							clear				(void);
+	void							addEntry			(const TestLogIndexEntry& entry);
+
+	int								getNumEntries		(void) const	{ return (int)m_entries.size();	}
+	const TestLogIndexEntry&		getEntry			(int ndx) const	{ return m_entries[ndx];		}
+
+	//! Find entry by case path in O(log n). Returns DE_NULL if not found.
+	//! If case is in log several times (re-run), last entry in log order is returned.
+	//! \note Lookup table is built on first call after adding entries.
+	const TestLogIndexEntry*		findEntry			(const char* casePath) const;
+
+	//! Get entry in case path order. Entries with equal path keep log order.
+	const TestLogIndexEntry&		getSortedEntry		(int ndx) const;
+
+private:
+	void							updateLookup		(void) const;
+
+	std::vector<TestLogIndexEntry>	m_entries;			//!< Entries in log order.
+	mutable std::vector<int>		m_lookup;			//!< Entry indices sorted by case path.
+	mutable bool					m_lookupValid;
+};
+
+void	readTestLogIndex		(TestLogIndex& dst, const char* filename);
+void	writeTestLogIndex		(const char* filename, const TestLogIndex& index);
+
+//! Builds index by scanning container-format log data.
+class TestLogIndexBuilder
+{
+public:
+							TestLogIndexBuilder		(TestLogIndex* dst);
+							~TestLogIndexBuilder	(void);
+
+	void					feed					(const deUint8* bytes, size_t numBytes);
+	void					finish					(void);
+
+private:
+							TestLogIndexBuilder		(const TestLogIndexBuilder& other);
+	TestLogIndexBuilder&	operator=				(const TestLogIndexBuilder& other);
+
+	void					handleDataLine			(void);
+	void					endCase					(TestStatusCode defaultStatusCode);
+
+	ContainerFormatParser	m_containerParser;
+	TestLogIndex*			m_dst;
+
+	deInt64					m_position;				//!< Log offset of current container element.
+	bool					m_inCase;
+	TestLogIndexEntry		m_curEntry;
+	std::string				m_curLine;
+};
+
+void	buildTestLogIndex		(TestLogIndex& dst, const char* logFilename);
+
+//! Memory-mapped log with random access to test case results.
+class IndexedTestLog
+{
+public:
+	//! Open log using index from indexFilename. If indexFilename is DE_NULL,
+	//! <logFilename>.idx is used if it exists and otherwise index is built by
+	//! scanning the log. Index that doesn't match the log is rebuilt by scanning.
+								IndexedTestLog			(const char* logFilename, const char* indexFilename = DE_NULL);
+								~IndexedTestLog			(void);
+
+	const TestLogIndex&			getIndex				(void) const { return m_index; }
+
+	const deUint8*				getCaseData				(const TestLogIndexEntry& entry) const;
+	void						getTestCaseResult		(const TestLogIndexEntry& entry, TestCaseResult& dst) const;
+
+	//! Parse single test case result. Returns false if case is not in log.
+	bool						getTestCaseResult		(const char* casePath, TestCaseResult& dst) const;
+
+private:
+								IndexedTestLog			(const IndexedTestLog& other);
+	IndexedTestLog&				operator=				(const IndexedTestLog& other);
+
+	deMappedFile*				m_file;
+	TestLogIndex				m_index;
+};
+
+} // xe
+
+#endif // _XETESTLOGINDEX_HPP
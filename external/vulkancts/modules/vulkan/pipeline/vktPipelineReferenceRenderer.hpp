@@ -132,6 +132,8 @@ public:
 		m_outputs[0].type	= (channelClass == tcu::TEXTURECHANNELCLASS_SIGNED_INTEGER)? rr::GENERICVECTYPE_INT32 :
 							  (channelClass == tcu::TEXTURECHANNELCLASS_UNSIGNED_INTEGER)? rr::GENERICVECTYPE_UINT32
 							  : rr::GENERICVECTYPE_FLOAT;
+
+		m_writesFragmentDepth = (m_depthStencilFormat.order == tcu::TextureFormat::D || m_depthStencilFormat.order == tcu::TextureFormat::DS);
 	}
 
 	virtual ~ColorFragmentShader (void) {}
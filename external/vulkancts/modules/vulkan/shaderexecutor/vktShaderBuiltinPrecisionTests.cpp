@@ -458,6 +458,35 @@ struct Traits<Vector<T, Size> > :
 {
 };
 
+//! Float vectors are converted and rounded with the batch FloatFormat operations.
+template <int Size>
+struct Traits<Vector<float, Size> > :
+	ContainerTraits<Vector<float, Size>, Vector<Interval, Size> >
+{
+	typedef				Vector<Interval, Size>	IVal;
+
+	static IVal			doConvert		(const FloatFormat& fmt, const IVal& value)
+	{
+		IVal ret;
+
+		fmt.convert(ret.getPtr(), value.getPtr(), Size);
+
+		return ret;
+	}
+
+	static IVal			doRound			(const FloatFormat& fmt, const Vector<float, Size>& value)
+	{
+		IVal ret;
+
+		for (int ndx = 0; ndx < Size; ++ndx)
+			ret[ndx] = Interval(double(value[ndx]));
+
+		fmt.roundOut(ret.getPtr(), ret.getPtr(), Size, false);
+
+		return ret;
+	}
+};
+
 template <typename T, int Rows, int Cols>
 struct Traits<Matrix<T, Rows, Cols> > :
 	ContainerTraits<Matrix<T, Rows, Cols>, Matrix<typename Traits<T>::IVal, Rows, Cols> >
@@ -1877,10 +1906,8 @@ public:
 		// Fast-path for common case
 		if (iargs.a.isOrdinary() && iargs.b.isOrdinary())
 		{
-			Interval ret;
-			TCU_SET_INTERVAL_BOUNDS(ret, sum,
-									sum = iargs.a.lo() + iargs.b.lo(),
-									sum = iargs.a.hi() + iargs.b.hi());
+			const Interval ret = Interval(tcu::addRoundDown(iargs.a.lo(), iargs.b.lo())) |
+								 Interval(tcu::addRoundUp(iargs.a.hi(), iargs.b.hi()));
 			return ctx.format.convert(ctx.format.roundOut(ret, true));
 		}
 		return this->applyMonotone(ctx, iargs.a, iargs.b);
@@ -1912,16 +1939,14 @@ public:
 			}
 			if (a.lo() >= 0 && b.lo() >= 0)
 			{
-				TCU_SET_INTERVAL_BOUNDS(ret, prod,
-										prod = iargs.a.lo() * iargs.b.lo(),
-										prod = iargs.a.hi() * iargs.b.hi());
+				ret = Interval(tcu::mulRoundDown(iargs.a.lo(), iargs.b.lo())) |
+					  Interval(tcu::mulRoundUp(iargs.a.hi(), iargs.b.hi()));
 				return ctx.format.convert(ctx.format.roundOut(ret, true));
 			}
 			if (a.lo() >= 0 && b.hi() <= 0)
 			{
-				TCU_SET_INTERVAL_BOUNDS(ret, prod,
-										prod = iargs.a.hi() * iargs.b.lo(),
-										prod = iargs.a.lo() * iargs.b.hi());
+				ret = Interval(tcu::mulRoundDown(iargs.a.hi(), iargs.b.lo())) |
+					  Interval(tcu::mulRoundUp(iargs.a.lo(), iargs.b.hi()));
 				return ctx.format.convert(ctx.format.roundOut(ret, true));
 			}
 		}
@@ -1952,11 +1977,9 @@ public:
 		// Fast-path for common case
 		if (iargs.a.isOrdinary() && iargs.b.isOrdinary())
 		{
-			Interval ret;
+			const Interval ret = Interval(tcu::subRoundDown(iargs.a.lo(), iargs.b.hi())) |
+								 Interval(tcu::subRoundUp(iargs.a.hi(), iargs.b.lo()));
 
-			TCU_SET_INTERVAL_BOUNDS(ret, diff,
-									diff = iargs.a.lo() - iargs.b.hi(),
-									diff = iargs.a.hi() - iargs.b.lo());
 			return ctx.format.convert(ctx.format.roundOut(ret, true));
 
 		}
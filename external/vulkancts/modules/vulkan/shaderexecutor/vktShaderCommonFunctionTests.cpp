@@ -2322,23 +2322,12 @@ public:
 		const tcu::Interval		ia		= format.convert(a);
 		const tcu::Interval		ib		= format.convert(b);
 		const tcu::Interval		ic		= format.convert(c);
-		tcu::Interval			prod0;
-		tcu::Interval			prod1;
-		tcu::Interval			prod2;
-		tcu::Interval			prod3;
-		tcu::Interval			prod;
-		tcu::Interval			res;
-
-		TCU_SET_INTERVAL(prod0, tmp, tmp = ia.lo() * ib.lo());
-		TCU_SET_INTERVAL(prod1, tmp, tmp = ia.lo() * ib.hi());
-		TCU_SET_INTERVAL(prod2, tmp, tmp = ia.hi() * ib.lo());
-		TCU_SET_INTERVAL(prod3, tmp, tmp = ia.hi() * ib.hi());
-
-		prod = format.convert(format.roundOut(prod0 | prod1 | prod2 | prod3, ia.isFinite() && ib.isFinite()));
-
-		TCU_SET_INTERVAL_BOUNDS(res, tmp,
-								tmp = prod.lo() + ic.lo(),
-								tmp = prod.hi() + ic.hi());
+		const tcu::Interval		prod0	= tcu::Interval(tcu::mulRoundDown(ia.lo(), ib.lo())) | tcu::Interval(tcu::mulRoundUp(ia.lo(), ib.lo()));
+		const tcu::Interval		prod1	= tcu::Interval(tcu::mulRoundDown(ia.lo(), ib.hi())) | tcu::Interval(tcu::mulRoundUp(ia.lo(), ib.hi()));
+		const tcu::Interval		prod2	= tcu::Interval(tcu::mulRoundDown(ia.hi(), ib.lo())) | tcu::Interval(tcu::mulRoundUp(ia.hi(), ib.lo()));
+		const tcu::Interval		prod3	= tcu::Interval(tcu::mulRoundDown(ia.hi(), ib.hi())) | tcu::Interval(tcu::mulRoundUp(ia.hi(), ib.hi()));
+		const tcu::Interval		prod	= format.convert(format.roundOut(prod0 | prod1 | prod2 | prod3, ia.isFinite() && ib.isFinite()));
+		const tcu::Interval		res		= tcu::Interval(tcu::addRoundDown(prod.lo(), ic.lo())) | tcu::Interval(tcu::addRoundUp(prod.hi(), ic.hi()));
 
 		return format.convert(format.roundOut(res, prod.isFinite() && ic.isFinite()));
 	}
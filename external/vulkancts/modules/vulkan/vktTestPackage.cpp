@@ -374,30 +374,32 @@ tcu::TestCaseExecutor* TestPackage::createExecutor (void) const
 
 void TestPackage::init (void)
 {
+	// Most test groups are created on demand, so a single-case run only
+	// constructs the subtree that it executes.
 	addChild(createTestGroup				(m_testCtx, "info", "Build and Device Info Tests", createInfoTests));
-	addChild(api::createTests				(m_testCtx));
-	addChild(memory::createTests			(m_testCtx));
-	addChild(pipeline::createTests			(m_testCtx));
-	addChild(BindingModel::createTests		(m_testCtx));
-	addChild(SpirVAssembly::createTests		(m_testCtx));
+	addLazyChild("api",						tcu::NODECLASS_GROUP,	api::createTests);
+	addLazyChild("memory",					tcu::NODECLASS_GROUP,	memory::createTests);
+	addLazyChild("pipeline",				tcu::NODECLASS_GROUP,	pipeline::createTests);
+	addLazyChild("binding_model",			tcu::NODECLASS_GROUP,	BindingModel::createTests);
+	addLazyChild("spirv_assembly",			tcu::NODECLASS_GROUP,	SpirVAssembly::createTests);
 	addChild(createTestGroup				(m_testCtx, "glsl", "GLSL shader execution tests", createGlslTests));
-	addChild(createRenderPassTests			(m_testCtx));
-	addChild(ubo::createTests				(m_testCtx));
-	addChild(DynamicState::createTests		(m_testCtx));
-	addChild(ssbo::createTests				(m_testCtx));
-	addChild(QueryPool::createTests			(m_testCtx));
-	addChild(Draw::createTests				(m_testCtx));
-	addChild(compute::createTests			(m_testCtx));
-	addChild(image::createTests				(m_testCtx));
-	addChild(wsi::createTests				(m_testCtx));
-	addChild(synchronization::createTests	(m_testCtx));
-	addChild(sparse::createTests			(m_testCtx));
-	addChild(tessellation::createTests		(m_testCtx));
-	addChild(rasterization::createTests		(m_testCtx));
-	addChild(clipping::createTests			(m_testCtx));
-	addChild(FragmentOperations::createTests(m_testCtx));
-	addChild(texture::createTests			(m_testCtx));
-	addChild(geometry::createTests			(m_testCtx));
+	addLazyChild("renderpass",				tcu::NODECLASS_GROUP,	createRenderPassTests);
+	addLazyChild("ubo",						tcu::NODECLASS_GROUP,	ubo::createTests);
+	addLazyChild("dynamic_state",			tcu::NODECLASS_GROUP,	DynamicState::createTests);
+	addLazyChild("ssbo",					tcu::NODECLASS_GROUP,	ssbo::createTests);
+	addLazyChild("query_pool",				tcu::NODECLASS_GROUP,	QueryPool::createTests);
+	addLazyChild("draw",					tcu::NODECLASS_GROUP,	Draw::createTests);
+	addLazyChild("compute",					tcu::NODECLASS_GROUP,	compute::createTests);
+	addLazyChild("image",					tcu::NODECLASS_GROUP,	image::createTests);
+	addLazyChild("wsi",						tcu::NODECLASS_GROUP,	wsi::createTests);
+	addLazyChild("synchronization",			tcu::NODECLASS_GROUP,	synchronization::createTests);
+	addLazyChild("sparse_resources",		tcu::NODECLASS_GROUP,	sparse::createTests);
+	addLazyChild("tessellation",			tcu::NODECLASS_GROUP,	tessellation::createTests);
+	addLazyChild("rasterization",			tcu::NODECLASS_GROUP,	rasterization::createTests);
+	addLazyChild("clipping",				tcu::NODECLASS_GROUP,	clipping::createTests);
+	addLazyChild("fragment_operations",		tcu::NODECLASS_GROUP,	FragmentOperations::createTests);
+	addLazyChild("texture",					tcu::NODECLASS_GROUP,	texture::createTests);
+	addLazyChild("geometry",				tcu::NODECLASS_GROUP,	geometry::createTests);
 }
 
 } // vkt
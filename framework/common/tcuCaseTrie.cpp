@@ -0,0 +1,678 @@
+/*-------------------------------------------------------------------------
+ * drawElements Quality Program Tester Core
+ * ----------------------------------------
+ *
+ * Copyright 2014 The Android Open Source Project
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ *      http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ *
+ *//*!
+ * \file
+ * \brief Compact test case list trie.
+ *//*--------------------------------------------------------------------*/
+
+#include "tcuCaseTrie.hpp"
+#include "tcuTestCase.hpp"
+#include "deString.h"
+#include "deMemory.h"
+#include "deInt32.h"
+
+#include <string>
+#include <algorithm>
+#include <fstream>
+#include <stdexcept>
+
+using std::string;
+using std::vector;
+
+namespace tcu
+{
+
+struct CaseTrie::Header
+{
+	deUint32	magic;
+	deUint32	version;
+	deUint32	numNodes;
+	deUint32	numHashSlots;
+	deUint32	stringTableSize;		//!< In bytes, padded to multiple of 4.
+};
+
+struct CaseTrie::Node
+{
+	deUint32	nameOffset;
+	deUint32	nameLength;
+	deUint32	nameHash;
+	deUint32	firstChild;
+	deUint32	numExactChildren;
+	deUint32	numWildcardChildren;	//!< Wildcard children follow exact children.
+	deUint32	firstHashSlot;
+	deUint32	numHashSlots;			//!< Power of two, 0 if node has no exact children.
+};
+
+namespace
+{
+
+enum
+{
+	BINARY_MAGIC		= 0x4c435164,	//!< "dQCL" in little-endian byte order.
+	BINARY_VERSION		= 1,
+	EMPTY_SLOT			= 0xffffffffu,
+	NOT_FOUND			= EMPTY_SLOT,
+
+	HEADER_WORDS		= sizeof(CaseTrie::Header) / sizeof(deUint32)
+};
+
+inline bool isValidNameChar (char c)
+{
+	return isValidTestCaseNameChar(c) || c == '*';
+}
+
+inline int getComponentLen (const char* path)
+{
+	int len = 0;
+	for (; path[len] != 0 && path[len] != '.'; ++len);
+	return len;
+}
+
+inline bool hasWildcard (const char* name, int nameLen)
+{
+	return std::find(name, name+nameLen, '*') != name+nameLen;
+}
+
+bool matchWildcards (const char* pattern, const char* patternEnd, const char* str, const char* strEnd)
+{
+	while (pattern != patternEnd && str != strEnd && *pattern == *str)
+	{
+		++pattern;
+		++str;
+	}
+
+	if (pattern == patternEnd)
+		return str == strEnd;
+	else if (*pattern == '*')
+	{
+		for (; str != strEnd; ++str)
+		{
+			if (matchWildcards(pattern+1, patternEnd, str, strEnd))
+				return true;
+		}
+
+		return matchWildcards(pattern+1, patternEnd, strEnd, strEnd);
+	}
+	else
+		return false;
+}
+
+//! Case paths stored back to back in a single buffer.
+class PathList
+{
+public:
+	void					add				(const string& path);
+	void					sort			(void);
+	void					checkDuplicates	(void) const;
+
+	int						size			(void) const	{ return (int)m_offsets.size();		}
+	const char*				getPath			(int ndx) const	{ return &m_data[m_offsets[ndx]];	}
+
+private:
+	vector<char>			m_data;
+	vector<deUint32>		m_offsets;
+};
+
+void PathList::add (const string& path)
+{
+	m_offsets.push_back((deUint32)m_data.size());
+	m_data.insert(m_data.end(), path.begin(), path.end());
+	m_data.push_back(0);
+}
+
+// Orders paths component-wise so that paths sharing a prefix are contiguous.
+struct PathLess
+{
+	const char* data;
+
+	PathLess (const char* data_) : data(data_) {}
+
+	static int getSortKey (char c) { return c == '.' ? 1 : (int)(deUint8)c; }
+
+	bool operator() (deUint32 a, deUint32 b) const
+	{
+		const char*	pa	= data+a;
+		const char*	pb	= data+b;
+
+		while (*pa != 0 && *pa == *pb)
+		{
+			++pa;
+			++pb;
+		}
+
+		return getSortKey(*pa) < getSortKey(*pb);
+	}
+};
+
+void PathList::sort (void)
+{
+	if (!m_data.empty())
+		std::sort(m_offsets.begin(), m_offsets.end(), PathLess(&m_data[0]));
+}
+
+void PathList::checkDuplicates (void) const
+{
+	for (int ndx = 1; ndx < size(); ++ndx)
+	{
+		if (deStringEqual(getPath(ndx-1), getPath(ndx)))
+			throw std::invalid_argument("Duplicate test case");
+	}
+}
+
+void parseCaseTrie (PathList& dst, std::istream& in)
+{
+	vector<size_t>	prefixStack;
+	string			prefix;
+	string			curName;
+	bool			expectNode		= true;
+
+	if (in.get() != '{')
+		throw std::invalid_argument("Malformed case trie");
+
+	prefixStack.push_back(0);
+
+	while (!prefixStack.empty())
+	{
+		const int	curChr	= in.get();
+
+		if (curChr == std::char_traits<char>::eof() || curChr == 0)
+			throw std::invalid_argument("Unterminated case tree");
+
+		if (curChr == '{' || curChr == ',' || curChr == '}')
+		{
+			if (!curName.empty() && expectNode)
+			{
+				if (curChr == '{')
+				{
+					prefixStack.push_back(prefix.size());
+					prefix += curName;
+					prefix += '.';
+				}
+				else
+					dst.add(prefix + curName);
+
+				curName.clear();
+			}
+			else if (curName.empty() == expectNode)
+				throw std::invalid_argument(expectNode ? "Empty node name" : "Missing node separator");
+
+			if (curChr == '}')
+			{
+				expectNode = false;
+				prefix.resize(prefixStack.back());
+				prefixStack.pop_back();
+
+				// consume trailing new line
+				if (prefixStack.empty())
+				{
+					if (in.peek() == '\r')
+					  in.get();
+					if (in.peek() == '\n')
+					  in.get();
+				}
+			}
+			else
+				expectNode = true;
+		}
+		else if (isValidNameChar((char)curChr))
+			curName += (char)curChr;
+		else
+			throw std::invalid_argument("Illegal character in node name");
+	}
+}
+
+void parseCaseList (PathList& dst, std::istream& in)
+{
+	string	curPath;
+	bool	componentEmpty	= true;
+
+	for (;;)
+	{
+		const int	curChr	= in.get();
+
+		if (curChr == std::char_traits<char>::eof() || curChr == 0 || curChr == '\n' || curChr == '\r')
+		{
+			if (componentEmpty)
+				throw std::invalid_argument("Empty test case name");
+
+			dst.add(curPath);
+
+			curPath.clear();
+			componentEmpty = true;
+
+			if (curChr == '\r' && in.peek() == '\n')
+				in.get();
+
+			{
+				const int nextChr = in.peek();
+
+				if (nextChr == std::char_traits<char>::eof() || nextChr == 0)
+					break;
+			}
+		}
+		else if (curChr == '.')
+		{
+			if (componentEmpty)
+				throw std::invalid_argument("Empty test group name");
+
+			curPath += '.';
+			componentEmpty = true;
+		}
+		else if (isValidNameChar((char)curChr))
+		{
+			curPath += (char)curChr;
+			componentEmpty = false;
+		}
+		else
+			throw std::invalid_argument("Illegal character in test case name");
+	}
+}
+
+struct ChildRange
+{
+	const char*	name;
+	int			nameLen;
+	int			begin;
+	int			end;
+};
+
+struct PendingNode
+{
+	deUint32	nodeNdx;
+	int			begin;
+	int			end;
+};
+
+//! Build trie image from sorted path list.
+void buildImage (vector<deUint32>& dst, const PathList& paths)
+{
+	vector<CaseTrie::Node>	nodes			(1);
+	vector<deUint32>		hashSlots;
+	vector<char>			strings;
+	vector<int>				cursors			(paths.size(), 0);	//!< Offset of current component in each path.
+	vector<PendingNode>		pending;
+	vector<ChildRange>		children;
+
+	deMemset(&nodes[0], 0, sizeof(CaseTrie::Node));
+
+	{
+		const PendingNode root = { 0u, 0, paths.size() };
+		pending.push_back(root);
+	}
+
+	// Breadth-first construction keeps children of each node contiguous.
+	for (size_t pendingNdx = 0; pendingNdx < pending.size(); ++pendingNdx)
+	{
+		const PendingNode	cur			= pending[pendingNdx];
+		int					pos			= cur.begin;
+		int					numExact	= 0;
+
+		// Paths that end at this node sort first.
+		while (pos < cur.end && paths.getPath(pos)[cursors[pos]] == 0)
+			++pos;
+
+		children.clear();
+
+		while (pos < cur.end)
+		{
+			const char* const	name	= paths.getPath(pos) + cursors[pos];
+			const int			nameLen	= getComponentLen(name);
+			int					end		= pos+1;
+
+			while (end < cur.end)
+			{
+				const char* const other = paths.getPath(end) + cursors[end];
+
+				if (deMemCmp(other, name, nameLen) != 0 || (other[nameLen] != '.' && other[nameLen] != 0))
+					break;
+
+				++end;
+			}
+
+			{
+				const ChildRange range = { name, nameLen, pos, end };
+
+				if (hasWildcard(name, nameLen))
+					children.push_back(range);
+				else
+				{
+					children.insert(children.begin()+numExact, range);
+					numExact += 1;
+				}
+			}
+
+			pos = end;
+		}
+
+		{
+			CaseTrie::Node&		node		= nodes[cur.nodeNdx];
+			const deUint32		firstChild	= (deUint32)nodes.size();
+
+			node.firstChild				= firstChild;
+			node.numExactChildren		= (deUint32)numExact;
+			node.numWildcardChildren	= (deUint32)(children.size() - numExact);
+			node.firstHashSlot			= (deUint32)hashSlots.size();
+			node.numHashSlots			= numExact > 0 ? (1u << deLog2Ceil32(numExact*2)) : 0u;
+
+			hashSlots.resize(hashSlots.size() + node.numHashSlots, (deUint32)EMPTY_SLOT);
+		}
+
+		for (int childNdx = 0; childNdx < (int)children.size(); ++childNdx)
+		{
+			const ChildRange&	range		= children[childNdx];
+			const deUint32		nodeNdx		= (deUint32)nodes.size();
+			CaseTrie::Node		child;
+
+			deMemset(&child, 0, sizeof(child));
+
+			child.nameOffset	= (deUint32)strings.size();
+			child.nameLength	= (deUint32)range.nameLen;
+			child.nameHash		= deMemoryHash(range.name, (size_t)range.nameLen);
+
+			strings.insert(strings.end(), range.name, range.name+range.nameLen);
+
+			if (childNdx < numExact)
+			{
+				const CaseTrie::Node&	parent	= nodes[cur.nodeNdx];
+				const deUint32			mask	= parent.numHashSlots-1;
+				deUint32				slot	= child.nameHash & mask;
+
+				while (hashSlots[parent.firstHashSlot + slot] != (deUint32)EMPTY_SLOT)
+					slot = (slot+1) & mask;
+
+				hashSlots[parent.firstHashSlot + slot] = nodeNdx;
+			}
+
+			nodes.push_back(child);
+
+			for (int pathNdx = range.begin; pathNdx < range.end; ++pathNdx)
+			{
+				cursors[pathNdx] += range.nameLen;
+
+				if (paths.getPath(pathNdx)[cursors[pathNdx]] == '.')
+					cursors[pathNdx] += 1;
+			}
+
+			{
+				const PendingNode next = { nodeNdx, range.begin, range.end };
+				pending.push_back(next);
+			}
+		}
+	}
+
+	strings.resize(deAlign32((deInt32)strings.size(), (deInt32)sizeof(deUint32)), 0);
+
+	{
+		const size_t	nodeWords	= nodes.size() * sizeof(CaseTrie::Node) / sizeof(deUint32);
+		const size_t	stringWords	= strings.size() / sizeof(deUint32);
+		CaseTrie::Header header;
+
+		header.magic			= BINARY_MAGIC;
+		header.version			= BINARY_VERSION;
+		header.numNodes			= (deUint32)nodes.size();
+		header.numHashSlots		= (deUint32)hashSlots.size();
+		header.stringTableSize	= (deUint32)strings.size();
+
+		dst.resize(HEADER_WORDS + nodeWords + hashSlots.size() + stringWords);
+
+		deMemcpy(&dst[0], &header, sizeof(header));
+		deMemcpy(&dst[HEADER_WORDS], &nodes[0], nodes.size()*sizeof(CaseTrie::Node));
+		if (!hashSlots.empty())
+			deMemcpy(&dst[HEADER_WORDS + nodeWords], &hashSlots[0], hashSlots.size()*sizeof(deUint32));
+		if (!strings.empty())
+			deMemcpy(&dst[HEADER_WORDS + nodeWords + hashSlots.size()], &strings[0], strings.size());
+	}
+}
+
+} // anonymous
+
+CaseTrie* CaseTrie::parse (std::istream& in)
+{
+	const bool			isTrie	= in.peek() == '{';
+	PathList			paths;
+	vector<deUint32>	image;
+
+	if (isTrie)
+		parseCaseTrie(paths, in);
+	else
+		parseCaseList(paths, in);
+
+	{
+		const int curChr = in.get();
+		if (curChr != std::char_traits<char>::eof() && curChr != 0)
+			throw std::invalid_argument("Trailing characters at end of case list");
+	}
+
+	paths.sort();
+
+	if (!isTrie)
+		paths.checkDuplicates();
+
+	buildImage(image, paths);
+
+	return new CaseTrie(image);
+}
+
+CaseTrie* CaseTrie::load (const char* filename)
+{
+	deMappedFile* const file = deMappedFile_create(filename);
+
+	if (!file)
+		throw Exception(string("Failed to open case list file '") + filename + "'");
+
+	try
+	{
+		return new CaseTrie(file);
+	}
+	catch (...)
+	{
+		deMappedFile_destroy(file);
+		throw;
+	}
+}
+
+bool CaseTrie::isBinaryFile (const char* filename)
+{
+	std::ifstream	in		(filename, std::ios_base::binary);
+	deUint32		magic	= 0;
+
+	in.read((char*)&magic, sizeof(magic));
+
+	return in.good() && magic == (deUint32)BINARY_MAGIC;
+}
+
+CaseTrie::CaseTrie (vector<deUint32>& image)
+	: m_file		(DE_NULL)
+	, m_header		(DE_NULL)
+	, m_nodes		(DE_NULL)
+	, m_hashSlots	(DE_NULL)
+	, m_strings		(DE_NULL)
+{
+	m_image.swap(image);
+	init(&m_image[0], m_image.size());
+}
+
+CaseTrie::CaseTrie (deMappedFile* file)
+	: m_file		(DE_NULL)
+	, m_header		(DE_NULL)
+	, m_nodes		(DE_NULL)
+	, m_hashSlots	(DE_NULL)
+	, m_strings		(DE_NULL)
+{
+	const deInt64 size = deMappedFile_getSize(file);
+
+	if (size < (deInt64)sizeof(Header) || size % sizeof(deUint32) != 0)
+		throw std::invalid_argument("Malformed binary case list");
+
+	init((const deUint32*)deMappedFile_getPtr(file), (size_t)(size / sizeof(deUint32)));
+
+	m_file = file;
+}
+
+CaseTrie::~CaseTrie (void)
+{
+	if (m_file)
+		deMappedFile_destroy(m_file);
+}
+
+void CaseTrie::init (const deUint32* image, size_t numWords)
+{
+	const Header* const header = (const Header*)image;
+
+	if (numWords < HEADER_WORDS || header->magic != (deUint32)BINARY_MAGIC || header->version != (deUint32)BINARY_VERSION)
+		throw std::invalid_argument("Malformed binary case list");
+
+	{
+		const size_t	nodeWords	= (size_t)header->numNodes * (sizeof(Node) / sizeof(deUint32));
+		const size_t	stringWords	= header->stringTableSize / sizeof(deUint32);
+
+		if (header->numNodes == 0 ||
+			header->stringTableSize % sizeof(deUint32) != 0 ||
+			HEADER_WORDS + nodeWords + header->numHashSlots + stringWords != numWords)
+			throw std::invalid_argument("Malformed binary case list");
+
+		m_header	= header;
+		m_nodes		= (const Node*)(image + HEADER_WORDS);
+		m_hashSlots	= image + HEADER_WORDS + nodeWords;
+		m_strings	= (const char*)(image + HEADER_WORDS + nodeWords + header->numHashSlots);
+	}
+
+	// Validate links so that a corrupted file can't cause out of bounds access or cycles.
+	for (deUint32 nodeNdx = 0; nodeNdx < header->numNodes; ++nodeNdx)
+	{
+		const Node&		node		= m_nodes[nodeNdx];
+		const deUint64	childEnd	= (deUint64)node.firstChild + node.numExactChildren + node.numWildcardChildren;
+		const deUint64	slotEnd		= (deUint64)node.firstHashSlot + node.numHashSlots;
+
+		if ((deUint64)node.nameOffset + node.nameLength > header->stringTableSize	||
+			(childEnd != node.firstChild && node.firstChild <= nodeNdx)				||
+			childEnd > header->numNodes												||
+			slotEnd > header->numHashSlots											||
+			(node.numHashSlots != 0 && !deIsPowerOfTwo32((int)node.numHashSlots))	||
+			node.numHashSlots < node.numExactChildren)
+			throw std::invalid_argument("Malformed binary case list");
+
+		for (deUint32 slotNdx = 0; slotNdx < node.numHashSlots; ++slotNdx)
+		{
+			const deUint32 childNdx = m_hashSlots[node.firstHashSlot + slotNdx];
+
+			if (childNdx != (deUint32)EMPTY_SLOT &&
+				(childNdx < node.firstChild || childNdx >= node.firstChild + node.numExactChildren))
+				throw std::invalid_argument("Malformed binary case list");
+		}
+	}
+}
+
+void CaseTrie::write (const char* filename) const
+{
+	const size_t	numWords	= HEADER_WORDS
+								+ m_header->numNodes * (sizeof(Node) / sizeof(deUint32))
+								+ m_header->numHashSlots
+								+ m_header->stringTableSize / sizeof(deUint32);
+	std::ofstream	out			(filename, std::ios_base::binary);
+
+	out.write((const char*)m_header, (std::streamsize)(numWords * sizeof(deUint32)));
+
+	if (!out.good())
+		throw Exception(string("Failed to write case list file '") + filename + "'");
+}
+
+int CaseTrie::getNumNodes (void) const
+{
+	return (int)m_header->numNodes;
+}
+
+deUint32 CaseTrie::findExactChild (const Node& node, const char* name, int nameLen) const
+{
+	if (node.numHashSlots == 0)
+		return NOT_FOUND;
+
+	{
+		const deUint32	hash	= deMemoryHash(name, (size_t)nameLen);
+		const deUint32	mask	= node.numHashSlots-1;
+
+		for (deUint32 probe = 0; probe < node.numHashSlots; ++probe)
+		{
+			const deUint32 childNdx = m_hashSlots[node.firstHashSlot + ((hash + probe) & mask)];
+
+			if (childNdx == (deUint32)EMPTY_SLOT)
+				break;
+
+			{
+				const Node& child = m_nodes[childNdx];
+
+				if (child.nameHash == hash && child.nameLength == (deUint32)nameLen &&
+					deMemCmp(m_strings + child.nameOffset, name, (size_t)nameLen) == 0)
+					return childNdx;
+			}
+		}
+	}
+
+	return NOT_FOUND;
+}
+
+bool CaseTrie::matchesTail (deUint32 nodeNdx, const char* rest, bool group) const
+{
+	const Node&	node		= m_nodes[nodeNdx];
+	const bool	hasChildren	= node.numExactChildren + node.numWildcardChildren > 0;
+
+	if (*rest == 0)
+		return hasChildren == group;
+
+	DE_ASSERT(*rest == '.');
+	return hasChildren && matches(nodeNdx, rest+1, group);
+}
+
+bool CaseTrie::matches (deUint32 nodeNdx, const char* path, bool group) const
+{
+	const Node&	node		= m_nodes[nodeNdx];
+	const int	nameLen		= getComponentLen(path);
+	const char*	rest		= path + nameLen;
+
+	{
+		const deUint32 childNdx = findExactChild(node, path, nameLen);
+
+		if (childNdx != NOT_FOUND && matchesTail(childNdx, rest, group))
+			return true;
+	}
+
+	for (deUint32 ndx = 0; ndx < node.numWildcardChildren; ++ndx)
+	{
+		const deUint32	childNdx	= node.firstChild + node.numExactChildren + ndx;
+		const Node&		child		= m_nodes[childNdx];
+		const char*		childName	= m_strings + child.nameOffset;
+
+		if (matchWildcards(childName, childName + child.nameLength, path, rest) && matchesTail(childNdx, rest, group))
+			return true;
+	}
+
+	return false;
+}
+
+bool CaseTrie::matchesGroup (const char* groupPath) const
+{
+	return matches(0u, groupPath, true);
+}
+
+bool CaseTrie::matchesCase (const char* casePath) const
+{
+	return matches(0u, casePath, false);
+}
+
+} // tcu
@@ -0,0 +1,96 @@
+#ifndef _TCUCASETRIE_HPP
+#define _TCUCASETRIE_HPP
+/*-------------------------------------------------------------------------
+ * drawElements Quality Program Tester Core
+ * ----------------------------------------
+ *
+ * Copyright 2014 The Android Open Source Project
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ *      http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ *
+ *//*!
+ * \file
+ * \brief Compact test case list trie.
+ *
+ * Case list is stored as a flat array of 32-bit words: header, nodes,
+ * per-node child hash tables and node name strings. Children of a node
+ * are contiguous and child lookup by name is a hash table probe. Node
+ * names may contain *-wildcards that match any characters within a
+ * single path component.
+ *
+ * The same image is used as the precompiled binary case list format, so
+ * a binary case list file is used directly from a memory mapping.
+ *//*--------------------------------------------------------------------*/
+
+#include "tcuDefs.hpp"
+#include "deMappedFile.h"
+
+#include <istream>
+#include <vector>
+
+namespace tcu
+{
+
+class CaseTrie
+{
+public:
+	//! Parse case list in trie ({a{b,c}}) or line-separated (a.b\na.c) format.
+	static CaseTrie*				parse				(std::istream& in);
+
+	//! Load precompiled binary case list.
+	static CaseTrie*				load				(const char* filename);
+
+	//! Check if file is a precompiled binary case list.
+	static bool						isBinaryFile		(const char* filename);
+
+									~CaseTrie			(void);
+
+	//! Write precompiled binary case list.
+	void							write				(const char* filename) const;
+
+	//! Does path match a node that has children.
+	bool							matchesGroup		(const char* groupPath) const;
+
+	//! Does path match a node without children.
+	bool							matchesCase			(const char* casePath) const;
+
+	int								getNumNodes			(void) const;
+
+	// Image layout, see tcuCaseTrie.cpp.
+	struct Header;
+	struct Node;
+
+private:
+	explicit						CaseTrie			(std::vector<deUint32>& image);
+	explicit						CaseTrie			(deMappedFile* file);
+									CaseTrie			(const CaseTrie&);
+	CaseTrie&						operator=			(const CaseTrie&);
+
+	void							init				(const deUint32* image, size_t numWords);
+
+	bool							matches				(deUint32 nodeNdx, const char* path, bool group) const;
+	bool							matchesTail			(deUint32 nodeNdx, const char* rest, bool group) const;
+	deUint32						findExactChild		(const Node& node, const char* name, int nameLen) const;
+
+	std::vector<deUint32>			m_image;			//!< Image built in memory.
+	deMappedFile*					m_file;				//!< Image loaded from file.
+
+	const Header*					m_header;
+	const Node*						m_nodes;
+	const deUint32*					m_hashSlots;
+	const char*						m_strings;
+};
+
+} // tcu
+
+#endif // _TCUCASETRIE_HPP
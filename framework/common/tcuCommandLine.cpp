@@ -24,6 +24,7 @@
 #include "tcuCommandLine.hpp"
 #include "tcuPlatform.hpp"
 #include "tcuTestCase.hpp"
+#include "tcuCaseTrie.hpp"
 #include "deFilePath.hpp"
 #include "deStringUtil.hpp"
 #include "deString.h"
@@ -85,6 +86,7 @@ DE_DECLARE_COMMAND_LINE_OPT(LogShaderSources,			bool);
 DE_DECLARE_COMMAND_LINE_OPT(TestOOM,					bool);
 DE_DECLARE_COMMAND_LINE_OPT(VKDeviceID,					int);
 DE_DECLARE_COMMAND_LINE_OPT(LogFlush,					bool);
+DE_DECLARE_COMMAND_LINE_OPT(LogIndex,					bool);
 DE_DECLARE_COMMAND_LINE_OPT(Validation,					bool);
 
 static void parseIntList (const char* src, std::vector<int>* dst)
@@ -142,7 +144,7 @@ void registerOptions (de::cmdline::Parser& parser)
 	parser
 		<< Option<CasePath>				("n",		"deqp-case",					"Test case(s) to run, supports wildcards (e.g. dEQP-GLES2.info.*)")
 		<< Option<CaseList>				(DE_NULL,	"deqp-caselist",				"Case list to run in trie format (e.g. {dEQP-GLES2{info{version,renderer}}})")
-		<< Option<CaseListFile>			(DE_NULL,	"deqp-caselist-file",			"Read case list (in trie format) from given file")
+		<< Option<CaseListFile>			(DE_NULL,	"deqp-caselist-file",			"Read case list (in trie format or precompiled binary) from given file")
 		<< Option<StdinCaseList>		(DE_NULL,	"deqp-stdin-caselist",			"Read case list (in trie format) from stdin")
 		<< Option<LogFilename>			(DE_NULL,	"deqp-log-filename",			"Write test results to given file",					"TestResults.qpa")
 		<< Option<RunMode>				(DE_NULL,	"deqp-runmode",					"Execute tests, or write list of test cases into a file",
@@ -172,6 +174,7 @@ void registerOptions (de::cmdline::Parser& parser)
 		<< Option<LogShaderSources>		(DE_NULL,	"deqp-log-shader-sources",		"Enable or disable logging of shader sources",		s_enableNames,		"enable")
 		<< Option<TestOOM>				(DE_NULL,	"deqp-test-oom",				"Run tests that exhaust memory on purpose",			s_enableNames,		TEST_OOM_DEFAULT)
 		<< Option<LogFlush>				(DE_NULL,	"deqp-log-flush",				"Enable or disable log file fflush",				s_enableNames,		"enable")
+		<< Option<LogIndex>				(DE_NULL,	"deqp-log-index",				"Enable or disable writing case index (<log>.idx)",	s_enableNames,		"disable")
 		<< Option<Validation>			(DE_NULL,	"deqp-validation",				"Enable or disable test case validation",			s_enableNames,		"disable");
 }
 
@@ -244,287 +247,6 @@ void DebugOutStreambuf::flushLine (void)
 	m_curLine.str("");
 }
 
-class CaseTreeNode
-{
-public:
-										CaseTreeNode		(const std::string& name) : m_name(name) {}
-										~CaseTreeNode		(void);
-
-	const std::string&					getName				(void) const { return m_name;				}
-	bool								hasChildren			(void) const { return !m_children.empty();	}
-
-	bool								hasChild			(const std::string& name) const;
-	const CaseTreeNode*					getChild			(const std::string& name) const;
-	CaseTreeNode*						getChild			(const std::string& name);
-
-	void								addChild			(CaseTreeNode* child) { m_children.push_back(child); }
-
-private:
-										CaseTreeNode		(const CaseTreeNode&);
-	CaseTreeNode&						operator=			(const CaseTreeNode&);
-
-	enum { NOT_FOUND = -1 };
-
-	// \todo [2014-10-30 pyry] Speed up with hash / sorting
-	int									findChildNdx		(const std::string& name) const;
-
-	std::string							m_name;
-	std::vector<CaseTreeNode*>			m_children;
-};
-
-CaseTreeNode::~CaseTreeNode (void)
-{
-	for (vector<CaseTreeNode*>::const_iterator i = m_children.begin(); i != m_children.end(); ++i)
-		delete *i;
-}
-
-int CaseTreeNode::findChildNdx (const std::string& name) const
-{
-	for (int ndx = 0; ndx < (int)m_children.size(); ++ndx)
-	{
-		if (m_children[ndx]->getName() == name)
-			return ndx;
-	}
-	return NOT_FOUND;
-}
-
-inline bool CaseTreeNode::hasChild (const std::string& name) const
-{
-	return findChildNdx(name) != NOT_FOUND;
-}
-
-inline const CaseTreeNode* CaseTreeNode::getChild (const std::string& name) const
-{
-	const int ndx = findChildNdx(name);
-	return ndx == NOT_FOUND ? DE_NULL : m_children[ndx];
-}
-
-inline CaseTreeNode* CaseTreeNode::getChild (const std::string& name)
-{
-	const int ndx = findChildNdx(name);
-	return ndx == NOT_FOUND ? DE_NULL : m_children[ndx];
-}
-
-static int getCurrentComponentLen (const char* path)
-{
-	int ndx = 0;
-	for (; path[ndx] != 0 && path[ndx] != '.'; ++ndx);
-	return ndx;
-}
-
-static const CaseTreeNode* findNode (const CaseTreeNode* root, const char* path)
-{
-	const CaseTreeNode*	curNode		= root;
-	const char*			curPath		= path;
-	int					curLen		= getCurrentComponentLen(curPath);
-
-	for (;;)
-	{
-		curNode = curNode->getChild(std::string(curPath, curPath+curLen));
-
-		if (!curNode)
-			break;
-
-		curPath	+= curLen;
-
-		if (curPath[0] == 0)
-			break;
-		else
-		{
-			DE_ASSERT(curPath[0] == '.');
-			curPath		+= 1;
-			curLen		 = getCurrentComponentLen(curPath);
-		}
-	}
-
-	return curNode;
-}
-
-static void parseCaseTrie (CaseTreeNode* root, std::istream& in)
-{
-	vector<CaseTreeNode*>	nodeStack;
-	string					curName;
-	bool					expectNode		= true;
-
-	if (in.get() != '{')
-		throw std::invalid_argument("Malformed case trie");
-
-	nodeStack.push_back(root);
-
-	while (!nodeStack.empty())
-	{
-		const int	curChr	= in.get();
-
-		if (curChr == std::char_traits<char>::eof() || curChr == 0)
-			throw std::invalid_argument("Unterminated case tree");
-
-		if (curChr == '{' || curChr == ',' || curChr == '}')
-		{
-			if (!curName.empty() && expectNode)
-			{
-				CaseTreeNode* const newChild = new CaseTreeNode(curName);
-
-				try
-				{
-					nodeStack.back()->addChild(newChild);
-				}
-				catch (...)
-				{
-					delete newChild;
-					throw;
-				}
-
-				if (curChr == '{')
-					nodeStack.push_back(newChild);
-
-				curName.clear();
-			}
-			else if (curName.empty() == expectNode)
-				throw std::invalid_argument(expectNode ? "Empty node name" : "Missing node separator");
-
-			if (curChr == '}')
-			{
-				expectNode = false;
-				nodeStack.pop_back();
-
-				// consume trailing new line
-				if (nodeStack.empty())
-				{
-					if (in.peek() == '\r')
-					  in.get();
-					if (in.peek() == '\n')
-					  in.get();
-				}
-			}
-			else
-				expectNode = true;
-		}
-		else if (isValidTestCaseNameChar((char)curChr))
-			curName += (char)curChr;
-		else
-			throw std::invalid_argument("Illegal character in node name");
-	}
-}
-
-static void parseCaseList (CaseTreeNode* root, std::istream& in)
-{
-	// \note Algorithm assumes that cases are sorted by groups, but will
-	//		 function fine, albeit more slowly, if that is not the case.
-	vector<CaseTreeNode*>	nodeStack;
-	int						stackPos	= 0;
-	string					curName;
-
-	nodeStack.resize(8, DE_NULL);
-
-	nodeStack[0] = root;
-
-	for (;;)
-	{
-		const int	curChr	= in.get();
-
-		if (curChr == std::char_traits<char>::eof() || curChr == 0 || curChr == '\n' || curChr == '\r')
-		{
-			if (curName.empty())
-				throw std::invalid_argument("Empty test case name");
-
-			if (nodeStack[stackPos]->hasChild(curName))
-				throw std::invalid_argument("Duplicate test case");
-
-			CaseTreeNode* const newChild = new CaseTreeNode(curName);
-
-			try
-			{
-				nodeStack[stackPos]->addChild(newChild);
-			}
-			catch (...)
-			{
-				delete newChild;
-				throw;
-			}
-
-			curName.clear();
-			stackPos = 0;
-
-			if (curChr == '\r' && in.peek() == '\n')
-				in.get();
-
-			{
-				const int nextChr = in.peek();
-
-				if (nextChr == std::char_traits<char>::eof() || nextChr == 0)
-					break;
-			}
-		}
-		else if (curChr == '.')
-		{
-			if (curName.empty())
-				throw std::invalid_argument("Empty test group name");
-
-			if ((int)nodeStack.size() <= stackPos+1)
-				nodeStack.resize(nodeStack.size()*2, DE_NULL);
-
-			if (!nodeStack[stackPos+1] || nodeStack[stackPos+1]->getName() != curName)
-			{
-				CaseTreeNode* curGroup = nodeStack[stackPos]->getChild(curName);
-
-				if (!curGroup)
-				{
-					curGroup = new CaseTreeNode(curName);
-
-					try
-					{
-						nodeStack[stackPos]->addChild(curGroup);
-					}
-					catch (...)
-					{
-						delete curGroup;
-						throw;
-					}
-				}
-
-				nodeStack[stackPos+1] = curGroup;
-
-				if ((int)nodeStack.size() > stackPos+2)
-					nodeStack[stackPos+2] = DE_NULL; // Invalidate rest of entries
-			}
-
-			DE_ASSERT(nodeStack[stackPos+1]->getName() == curName);
-
-			curName.clear();
-			stackPos += 1;
-		}
-		else if (isValidTestCaseNameChar((char)curChr))
-			curName += (char)curChr;
-		else
-			throw std::invalid_argument("Illegal character in test case name");
-	}
-}
-
-static CaseTreeNode* parseCaseList (std::istream& in)
-{
-	CaseTreeNode* const root = new CaseTreeNode("");
-	try
-	{
-		if (in.peek() == '{')
-			parseCaseTrie(root, in);
-		else
-			parseCaseList(root, in);
-
-		{
-			const int curChr = in.get();
-			if (curChr != std::char_traits<char>::eof() && curChr != 0)
-				throw std::invalid_argument("Trailing characters at end of case list");
-		}
-
-		return root;
-	}
-	catch (...)
-	{
-		delete root;
-		throw;
-	}
-}
-
 class CasePaths
 {
 public:
@@ -732,6 +454,9 @@ bool CommandLine::parse (int argc, const char* const* argv)
 	if (!m_cmdLine.getOption<opt::LogFlush>())
 		m_logFlags |= QP_TEST_LOG_NO_FLUSH;
 
+	if (m_cmdLine.getOption<opt::LogIndex>())
+		m_logFlags |= QP_TEST_LOG_WRITE_INDEX;
+
 	if ((m_cmdLine.hasOption<opt::CasePath>()?1:0) +
 		(m_cmdLine.hasOption<opt::CaseList>()?1:0) +
 		(m_cmdLine.hasOption<opt::CaseListFile>()?1:0) +
@@ -748,20 +473,27 @@ bool CommandLine::parse (int argc, const char* const* argv)
 		{
 			std::istringstream str(m_cmdLine.getOption<opt::CaseList>());
 
-			m_caseTree = parseCaseList(str);
+			m_caseTree = CaseTrie::parse(str);
 		}
 		else if (m_cmdLine.hasOption<opt::CaseListFile>())
 		{
-			std::ifstream in(m_cmdLine.getOption<opt::CaseListFile>().c_str(), std::ios_base::binary);
+			const char* const filename = m_cmdLine.getOption<opt::CaseListFile>().c_str();
+
+			if (CaseTrie::isBinaryFile(filename))
+				m_caseTree = CaseTrie::load(filename);
+			else
+			{
+				std::ifstream in(filename, std::ios_base::binary);
 
-			if (!in.is_open() || !in.good())
-				throw Exception("Failed to open case list file '" + m_cmdLine.getOption<opt::CaseListFile>() + "'");
+				if (!in.is_open() || !in.good())
+					throw Exception("Failed to open case list file '" + m_cmdLine.getOption<opt::CaseListFile>() + "'");
 
-			m_caseTree = parseCaseList(in);
+				m_caseTree = CaseTrie::parse(in);
+			}
 		}
 		else if (m_cmdLine.getOption<opt::StdinCaseList>())
 		{
-			m_caseTree = parseCaseList(std::cin);
+			m_caseTree = CaseTrie::parse(std::cin);
 		}
 		else if (m_cmdLine.hasOption<opt::CasePath>())
 			m_casePaths = de::MovePtr<const CasePaths>(new CasePaths(m_cmdLine.getOption<opt::CasePath>()));
@@ -877,24 +609,12 @@ const char* CommandLine::getEGLPixmapType (void) const
 		return DE_NULL;
 }
 
-static bool checkTestGroupName (const CaseTreeNode* root, const char* groupPath)
-{
-	const CaseTreeNode* node = findNode(root, groupPath);
-	return node && node->hasChildren();
-}
-
-static bool checkTestCaseName (const CaseTreeNode* root, const char* casePath)
-{
-	const CaseTreeNode* node = findNode(root, casePath);
-	return node && !node->hasChildren();
-}
-
 bool CommandLine::checkTestGroupName (const char* groupName) const
 {
 	if (m_casePaths)
 		return m_casePaths->matches(groupName, true);
 	else if (m_caseTree)
-		return groupName[0] == 0 || tcu::checkTestGroupName(m_caseTree, groupName);
+		return groupName[0] == 0 || m_caseTree->matchesGroup(groupName);
 	else
 		return true;
 }
@@ -904,7 +624,7 @@ bool CommandLine::checkTestCaseName (const char* caseName) const
 	if (m_casePaths)
 		return m_casePaths->matches(caseName, false);
 	else if (m_caseTree)
-		return tcu::checkTestCaseName(m_caseTree, caseName);
+		return m_caseTree->matchesCase(caseName);
 	else
 		return true;
 }
@@ -86,7 +86,7 @@ enum ScreenRotation
 	SCREENROTATION_LAST
 };
 
-class CaseTreeNode;
+class CaseTrie;
 class CasePaths;
 
 /*--------------------------------------------------------------------*//*!
@@ -204,7 +204,7 @@ private:
 
 	de::cmdline::CommandLine		m_cmdLine;
 	deUint32						m_logFlags;
-	CaseTreeNode*					m_caseTree;
+	CaseTrie*						m_caseTree;
 	de::MovePtr<const CasePaths>	m_casePaths;
 };
 
@@ -0,0 +1,65 @@
+/*-------------------------------------------------------------------------
+ * drawElements Quality Program Tester Core
+ * ----------------------------------------
+ *
+ * Copyright 2014 The Android Open Source Project
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ *      http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ *
+ *//*!
+ * \file
+ * \brief Compile text case list into precompiled binary case list.
+ *
+ * Output can be given to --deqp-caselist-file.
+ *//*--------------------------------------------------------------------*/
+
+#include "tcuCaseTrie.hpp"
+#include "deUniquePtr.hpp"
+#include "deClock.h"
+
+#include <fstream>
+#include <cstdio>
+
+int main (int argc, const char* const* argv)
+{
+	if (argc != 3)
+	{
+		printf("%s: [case list] [output file]\n", argv[0]);
+		return -1;
+	}
+
+	try
+	{
+		std::ifstream in(argv[1], std::ios_base::binary);
+
+		if (!in.is_open() || !in.good())
+			throw tcu::Exception(std::string("Failed to open '") + argv[1] + "'");
+
+		{
+			const deUint64						startTime	= deGetMicroseconds();
+			const de::UniquePtr<tcu::CaseTrie>	trie		(tcu::CaseTrie::parse(in));
+			const deUint64						parseTime	= deGetMicroseconds() - startTime;
+
+			trie->write(argv[2]);
+
+			printf("%d nodes, parsed in %.2f ms\n", trie->getNumNodes(), (double)parseTime / 1000.0);
+		}
+	}
+	catch (const std::exception& e)
+	{
+		printf("FATAL ERROR: %s\n", e.what());
+		return -1;
+	}
+
+	return 0;
+}
@@ -24,7 +24,9 @@
 #include "tcuFloatFormat.hpp"
 
 #include "deMath.h"
+#include "deMemory.h"
 #include "deUniquePtr.hpp"
+#include "deRandom.hpp"
 
 #include <sstream>
 #include <iomanip>
@@ -48,6 +50,36 @@ Interval chooseInterval(YesNoMaybe choice, const Interval& no, const Interval& y
 	return Interval();
 }
 
+inline deUint64 doubleToBits (double x)
+{
+	deUint64 bits;
+	deMemcpy(&bits, &x, sizeof(bits));
+	return bits;
+}
+
+inline double bitsToDouble (deUint64 bits)
+{
+	double x;
+	deMemcpy(&x, &bits, sizeof(x));
+	return x;
+}
+
+//! Same exponent as given by deFractExp(), computed from the representation
+//! for normal numbers.
+inline int getExponent (double x)
+{
+	const int biasedExp = (int)((doubleToBits(x) >> 52) & 0x7ffu);
+
+	if (biasedExp == 0 || biasedExp == 0x7ff)
+	{
+		int exp = 0;
+		deFractExp(x, &exp);
+		return exp;
+	}
+
+	return biasedExp - 1023;
+}
+
 double computeMaxValue (int maxExp, int fractionBits)
 {
 	return (deLdExp(1.0, maxExp) +
@@ -138,15 +170,47 @@ int FloatFormat::exponentShift (int exp) const
 //! Return the number closest to `d` that is exactly representable with the
 //! significand bits and minimum exponent of the floatformat. Round up if
 //! `upward` is true, otherwise down.
+//!
+//! Rounding is done on the binary representation of `d`: bits below the
+//! quantum of the format are cleared, which rounds towards zero, and one
+//! quantum is added if rounding is away from zero and bits were lost.
 double FloatFormat::round (double d, bool upward) const
 {
-	int				exp			= 0;
-	const double	frac		= deFractExp(d, &exp);
-	const int		shift		= exponentShift(exp);
-	const double	shiftFrac	= deLdExp(frac, shift);
-	const double	roundFrac	= upward ? deCeil(shiftFrac) : deFloor(shiftFrac);
+	const deUint64	signBit		= 1ull << 63;
+	const deUint64	bits		= doubleToBits(d);
 
-	return deLdExp(roundFrac, exp - shift);
+	// Infinities, NaN and zero are unchanged.
+	if (deIsInf(d) || deIsNaN(d) || d == 0.0)
+		return d;
+
+	{
+		const int		exp				= getExponent(d);
+		const int		lsbExp			= de::max(exp, -1022) - 52;
+		const int		quantumExp		= de::max(exp, m_minExp) - m_fractionBits;
+		const bool		awayFromZero	= upward != (d < 0.0);
+
+		// All significand bits are representable.
+		if (quantumExp <= lsbExp)
+			return d;
+
+		{
+			const double quantum = deLdExp(d < 0.0 ? -1.0 : 1.0, quantumExp);
+
+			// Magnitude is smaller than the quantum.
+			if (quantumExp > exp)
+				return awayFromZero ? quantum : bitsToDouble(bits & signBit);
+
+			{
+				const deUint64	lostMask	= (1ull << (quantumExp - lsbExp)) - 1u;
+				const double	truncated	= bitsToDouble(bits & ~lostMask);
+
+				if ((bits & lostMask) == 0 || !awayFromZero)
+					return truncated;
+				else
+					return truncated + quantum;
+			}
+		}
+	}
 }
 
 //! Return the range of numbers that `d` might be converted to in the
@@ -155,11 +219,10 @@ double FloatFormat::round (double d, bool upward) const
 Interval FloatFormat::clampValue (double d) const
 {
 	const double	rSign		= deSign(d);
-	int				rExp		= 0;
+	const int		rExp		= getExponent(d);
 
 	DE_ASSERT(!deIsNaN(d));
 
-	deFractExp(d, &rExp);
 	if (rExp < m_minExp)
 		return chooseInterval(m_hasSubnormal, rSign * 0.0, d);
 	else if (deIsInf(d) || rExp > m_maxExp)
@@ -201,8 +264,7 @@ Interval FloatFormat::convert (const Interval& x) const
 
 double FloatFormat::roundOut (double d, bool upward, bool roundUnderOverflow) const
 {
-	int	exp	= 0;
-	deFractExp(d, &exp);
+	const int exp = getExponent(d);
 
 	if (roundUnderOverflow && exp > m_maxExp && (upward == (d < 0.0)))
 		return deSign(d) * getMaxValue();
@@ -224,6 +286,18 @@ Interval FloatFormat::roundOut (const Interval& x, bool roundUnderOverflow) cons
 	return ret;
 }
 
+void FloatFormat::roundOut (Interval* dst, const Interval* src, int count, bool roundUnderOverflow) const
+{
+	for (int ndx = 0; ndx < count; ndx++)
+		dst[ndx] = roundOut(src[ndx], roundUnderOverflow);
+}
+
+void FloatFormat::convert (Interval* dst, const Interval* src, int count) const
+{
+	for (int ndx = 0; ndx < count; ndx++)
+		dst[ndx] = convert(src[ndx]);
+}
+
 std::string	FloatFormat::floatToHex	(double x) const
 {
 	if (deIsNaN(x))
@@ -379,12 +453,69 @@ void TestBinary32::runTest (void) const
 	TCU_CHECK(m_fmt->floatToHex(p(-126) + p(-125)) == "0x1.800000p-125");
 }
 
+//! Reference rounding using floating point operations.
+double roundReference (const FloatFormat& fmt, double d, bool upward)
+{
+	int				exp			= 0;
+	const double	frac		= deFractExp(d, &exp);
+	const int		shift		= fmt.getFractionBits() - de::max(fmt.getMinExp() - exp, 0);
+	const double	shiftFrac	= deLdExp(frac, shift);
+	const double	roundFrac	= upward ? deCeil(shiftFrac) : deFloor(shiftFrac);
+
+	return deLdExp(roundFrac, exp - shift);
+}
+
+void testRoundRandom (void)
+{
+	const FloatFormat	formats[]	=
+	{
+		FloatFormat(-126,	127,	23,	true),
+		FloatFormat(-14,	15,		10,	true),
+		FloatFormat(-13,	13,		9,	false),
+		FloatFormat(0,		0,		7,	false),
+		FloatFormat::nativeDouble(),
+	};
+	de::Random			rnd			(0x9a71c3);
+
+	for (int ndx = 0; ndx < 10000; ndx++)
+	{
+		double d;
+
+		if (rnd.getBool())
+		{
+			const deUint64 bits = rnd.getUint64();
+			deMemcpy(&d, &bits, sizeof(d));
+		}
+		else
+			d = deLdExp(rnd.getDouble(-2.0, 2.0), rnd.getInt(-160, 160));
+
+		for (int fmtNdx = 0; fmtNdx < DE_LENGTH_OF_ARRAY(formats); fmtNdx++)
+		{
+			for (int upward = 0; upward < 2; upward++)
+			{
+				const double result		= formats[fmtNdx].round(d, upward != 0);
+				const double reference	= roundReference(formats[fmtNdx], d, upward != 0);
+
+				if (!(result == reference || (deIsNaN(result) && deIsNaN(reference))) ||
+					(result == 0.0 && deSign(1.0 / result) != deSign(1.0 / reference)))
+				{
+					ostringstream oss;
+					oss << std::setprecision(17) << "round(" << d << ", " << (upward != 0) << ") returned " << result << ", expected " << reference;
+					TCU_FAIL(oss.str().c_str());
+				}
+			}
+		}
+	}
+}
+
 } // anonymous
 
 void FloatFormat_selfTest (void)
 {
 	TestBinary32	test32;
 	test32.runTest();
+
+	testRoundRandom();
 }
 
 } // tcu
@@ -64,6 +64,10 @@ public:
 	double				roundOut		(double d, bool upward, bool roundUnderOverflow) const;
 	Interval			convert			(const Interval& x) const;
 
+	// Batch versions, dst may be equal to src.
+	void				roundOut		(Interval* dst, const Interval* src, int count, bool roundUnderOverflow) const;
+	void				convert			(Interval* dst, const Interval* src, int count) const;
+
 	std::string			floatToHex		(double x) const;
 	std::string			intervalToHex	(const Interval& interval) const;
 
@@ -24,14 +24,262 @@
 #include "tcuInterval.hpp"
 
 #include "deMath.h"
+#include "deMemory.h"
 
 #include <cmath>
 
+// Error-free transformations require every operation to be rounded to
+// double. When doubles are evaluated in extended precision (x87), directed
+// rounding falls back to changing the rounding mode.
+#if defined(__FLT_EVAL_METHOD__) && (__FLT_EVAL_METHOD__ != 0)
+#	define TCU_INTERVAL_USE_ERROR_FREE_TRANSFORMS 0
+#else
+#	define TCU_INTERVAL_USE_ERROR_FREE_TRANSFORMS 1
+#endif
+
 namespace tcu
 {
 
 using std::ldexp;
 
+namespace
+{
+
+enum RoundingDirection
+{
+	ROUND_DOWN = 0,
+	ROUND_UP
+};
+
+// Operations for directed rounding. compute() returns the round-to-nearest
+// result and, when it can be computed exactly, its rounding error.
+// isExact() tells if the round-to-nearest result is exact when there is
+// no error term.
+
+struct AddOp
+{
+	static double	apply	(double x, double y) { return x + y; }
+	static bool		compute	(double x, double y, double& value, double& err);
+	static bool		isExact	(double x, double y);
+};
+
+struct MulOp
+{
+	static double	apply	(double x, double y) { return x * y; }
+	static bool		compute	(double x, double y, double& value, double& err);
+	static bool		isExact	(double x, double y);
+};
+
+struct DivOp
+{
+	static double	apply	(double x, double y) { return x / y; }
+	static bool		compute	(double x, double y, double& value, double& err);
+	static bool		isExact	(double x, double y);
+};
+
+#if TCU_INTERVAL_USE_ERROR_FREE_TRANSFORMS
+
+inline deUint64 doubleToBits (double x)
+{
+	deUint64 bits;
+	deMemcpy(&bits, &x, sizeof(bits));
+	return bits;
+}
+
+inline double bitsToDouble (deUint64 bits)
+{
+	double x;
+	deMemcpy(&x, &bits, sizeof(x));
+	return x;
+}
+
+inline bool isFinite (double x)
+{
+	return x - x == 0.0;
+}
+
+//! Unbiased exponent field. Zero and subnormals give -1023, infinities and NaN 1024.
+inline int getExponent (double x)
+{
+	return (int)((doubleToBits(x) >> 52) & 0x7ffu) - 1023;
+}
+
+//! Smallest double greater than x.
+inline double nextUp (double x)
+{
+	if (deIsNaN(x) || x == TCU_INFINITY)
+		return x;
+
+	if (x == 0.0)
+		return bitsToDouble(1u);
+
+	return bitsToDouble(x > 0.0 ? doubleToBits(x) + 1u : doubleToBits(x) - 1u);
+}
+
+inline double nextDown (double x)
+{
+	return -nextUp(-x);
+}
+
+//! Veltkamp split of x into two halves of at most 26 significant bits.
+inline void split (double x, double& hi, double& lo)
+{
+	const double	factor	= 134217729.0; // 2^27 + 1
+	const double	scaled	= factor * x;
+	const double	diff	= scaled - x;
+
+	hi = scaled - diff;
+	lo = x - hi;
+}
+
+//! True if mulError(x, y, prod) is exact: split doesn't overflow and
+//! partial products don't underflow.
+inline bool canComputeMulError (double x, double y, double prod)
+{
+	return de::inRange(getExponent(x),		-969, 994)	&&
+		   de::inRange(getExponent(y),		-969, 994)	&&
+		   de::inRange(getExponent(prod),	-969, 1023);
+}
+
+//! Exact x * y - prod (Dekker's TwoProduct). Partial products are exact,
+//! so the result doesn't change if they are contracted to FMAs.
+inline double mulError (double x, double y, double prod)
+{
+	double	xHi, xLo;
+	double	yHi, yLo;
+
+	split(x, xHi, xLo);
+	split(y, yHi, yLo);
+
+	return ((xHi*yHi - prod) + xHi*yLo + xLo*yHi) + xLo*yLo;
+}
+
+// TwoSum. Overflow of the sum or non-finite operands make err NaN.
+inline bool AddOp::compute (double x, double y, double& value, double& err)
+{
+	const double	sum			= x + y;
+	const double	yVirtual	= sum - x;
+	const double	xVirtual	= sum - yVirtual;
+
+	value	= sum;
+	err		= (x - xVirtual) + (y - yVirtual);
+
+	return isFinite(err);
+}
+
+inline bool AddOp::isExact (double x, double y)
+{
+	return !isFinite(x) || !isFinite(y);
+}
+
+inline bool MulOp::compute (double x, double y, double& value, double& err)
+{
+	value = x * y;
+
+	if (!canComputeMulError(x, y, value))
+		return false;
+
+	err = mulError(x, y, value);
+	return true;
+}
+
+inline bool MulOp::isExact (double x, double y)
+{
+	return !isFinite(x) || !isFinite(y) || x == 0.0 || y == 0.0;
+}
+
+inline bool DivOp::compute (double x, double y, double& value, double& err)
+{
+	const double	quot	= x / y;
+	const double	prod	= quot * y;
+
+	value = quot;
+
+	if (!canComputeMulError(quot, y, prod))
+		return false;
+
+	// Remainder x - quot*y is representable and x - prod is exact, so rem
+	// is exact. Rounding error of the quotient is rem / y.
+	{
+		const double rem = (x - prod) - mulError(quot, y, prod);
+
+		err = y > 0.0 ? rem : -rem;
+	}
+
+	return true;
+}
+
+inline bool DivOp::isExact (double x, double y)
+{
+	return !isFinite(x) || !isFinite(y) || x == 0.0 || y == 0.0;
+}
+
+template<typename Op>
+double roundDirected (double x, double y, RoundingDirection dir)
+{
+	double	value;
+	double	err;
+
+	if (Op::compute(x, y, value, err))
+	{
+		if (dir == ROUND_DOWN)
+			return err < 0.0 ? nextDown(value) : value;
+		else
+			return err > 0.0 ? nextUp(value) : value;
+	}
+	else if (Op::isExact(x, y))
+		return value;
+	else
+	{
+		// Directed rounding is at most one ulp away from round-to-nearest.
+		return dir == ROUND_DOWN ? nextDown(value) : nextUp(value);
+	}
+}
+
+template<typename Op>
+Interval roundOutward (double x, double y)
+{
+	double	value;
+	double	err;
+
+	if (Op::compute(x, y, value, err))
+		return Interval(false, err < 0.0 ? nextDown(value) : value, err > 0.0 ? nextUp(value) : value);
+	else if (Op::isExact(x, y))
+		return Interval(value);
+	else
+		return Interval(false, nextDown(value), nextUp(value));
+}
+
+#else // TCU_INTERVAL_USE_ERROR_FREE_TRANSFORMS
+
+template<typename Op>
+double roundDirected (double x, double y, RoundingDirection dir)
+{
+	const ScopedRoundingMode	ctx		(dir == ROUND_DOWN ? DE_ROUNDINGMODE_TO_NEGATIVE_INF : DE_ROUNDINGMODE_TO_POSITIVE_INF);
+	const volatile double		value	= Op::apply(x, y);
+
+	return value;
+}
+
+template<typename Op>
+Interval roundOutward (double x, double y)
+{
+	return Interval(roundDirected<Op>(x, y, ROUND_DOWN)) | Interval(roundDirected<Op>(x, y, ROUND_UP));
+}
+
+#endif // TCU_INTERVAL_USE_ERROR_FREE_TRANSFORMS
+
+} // anonymous
+
+double addRoundDown	(double x, double y) { return roundDirected<AddOp>(x, y, ROUND_DOWN);	}
+double addRoundUp	(double x, double y) { return roundDirected<AddOp>(x, y, ROUND_UP);		}
+double subRoundDown	(double x, double y) { return roundDirected<AddOp>(x, -y, ROUND_DOWN);	}
+double subRoundUp	(double x, double y) { return roundDirected<AddOp>(x, -y, ROUND_UP);	}
+double mulRoundDown	(double x, double y) { return roundDirected<MulOp>(x, y, ROUND_DOWN);	}
+double mulRoundUp	(double x, double y) { return roundDirected<MulOp>(x, y, ROUND_UP);		}
+double divRoundDown	(double x, double y) { return roundDirected<DivOp>(x, y, ROUND_DOWN);	}
+double divRoundUp	(double x, double y) { return roundDirected<DivOp>(x, y, ROUND_UP);		}
+
 Interval applyMonotone (DoubleFunc1& func, const Interval& arg0)
 {
 	Interval ret;
@@ -67,7 +315,7 @@ Interval operator+ (const Interval& x, const Interval& y)
 	Interval ret;
 
 	if (!x.empty() && !y.empty())
-		TCU_SET_INTERVAL_BOUNDS(ret, p, p = x.lo() + y.lo(), p = x.hi() + y.hi());
+		ret = Interval(roundDirected<AddOp>(x.lo(), y.lo(), ROUND_DOWN)) | Interval(roundDirected<AddOp>(x.hi(), y.hi(), ROUND_UP));
 	if (x.hasNaN() || y.hasNaN())
 		ret |= TCU_NAN;
 
@@ -79,7 +327,7 @@ Interval operator- (const Interval& x, const Interval& y)
 	Interval ret;
 
 	TCU_INTERVAL_APPLY_MONOTONE2(ret, xp, x, yp, y, val,
-								 TCU_SET_INTERVAL(val, point, point = xp - yp));
+								 val = roundOutward<AddOp>(xp, -yp));
 	return ret;
 }
 
@@ -88,7 +336,7 @@ Interval operator* (const Interval& x, const Interval& y)
 	Interval ret;
 
 	TCU_INTERVAL_APPLY_MONOTONE2(ret, xp, x, yp, y, val,
-								 TCU_SET_INTERVAL(val, point, point = xp * yp));
+								 val = roundOutward<MulOp>(xp, yp));
 	return ret;
 }
 
@@ -105,7 +353,7 @@ Interval operator/ (const Interval& nom, const Interval& den)
 		Interval ret;
 
 		TCU_INTERVAL_APPLY_MONOTONE2(ret, nomp, nom, denp, den, val,
-									 TCU_SET_INTERVAL(val, point, point = nomp / denp));
+									 val = roundOutward<DivOp>(nomp, denp));
 		return ret;
 	}
 }
@@ -165,6 +165,23 @@ Interval		operator-	(const Interval& x,		const Interval& y);
 Interval		operator*	(const Interval& x,		const Interval& y);
 Interval		operator/	(const Interval& nom,	const Interval& den);
 
+// Basic operations rounded toward negative or positive infinity. Results
+// are equal to evaluating the operation under ScopedRoundingMode, but the
+// rounding mode is not changed: the operation is computed in the default
+// round-to-nearest mode and its rounding error is recovered with
+// error-free transformations. If the error can't be represented exactly
+// (overflow or underflow in the transformation), the result is widened by
+// one ulp, which still contains the directed rounding result. Must be
+// called in the default rounding mode.
+double			addRoundDown	(double x, double y);
+double			addRoundUp		(double x, double y);
+double			subRoundDown	(double x, double y);
+double			subRoundUp		(double x, double y);
+double			mulRoundDown	(double x, double y);
+double			mulRoundUp		(double x, double y);
+double			divRoundDown	(double x, double y);
+double			divRoundUp		(double x, double y);
+
 inline Interval& operator+=	(Interval& x,	const Interval& y) { return (x = x + y); }
 inline Interval& operator-=	(Interval& x,	const Interval& y) { return (x = x - y); }
 inline Interval& operator*=	(Interval& x,	const Interval& y) { return (x = x * y); }
@@ -208,7 +225,7 @@ std::ostream&	operator<<	(std::ostream& os, const Interval& interval);
 	::tcu::Interval			VAR##_lo_;									\
 	::tcu::Interval			VAR##_hi_;									\
 	if (VAR##_arg_.empty())												\
-		VAR##_dst_ = Interval();										\
+		VAR##_dst_ = ::tcu::Interval();									\
 	else																\
 	{																	\
 		{																\
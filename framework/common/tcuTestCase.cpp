@@ -72,18 +72,76 @@ void TestNode::getChildren (vector<TestNode*>& res)
 {
 	res.clear();
 	for (int i = 0; i < (int)m_children.size(); i++)
-		res.push_back(m_children[i]);
+		res.push_back(getChild(i));
+}
+
+const char* TestNode::getChildName (int childNdx) const
+{
+	const Child& child = m_children[childNdx];
+	return child.node ? child.node->getName() : child.name.c_str();
+}
+
+TestNodeClass TestNode::getChildClass (int childNdx) const
+{
+	return m_children[childNdx].nodeClass;
+}
+
+TestNode* TestNode::getChild (int childNdx)
+{
+	Child& child = m_children[childNdx];
+
+	if (!child.node)
+	{
+		TestNode* const node = child.factory->createNode(m_testCtx);
+
+		if (!deStringEqual(node->getName(), child.name.c_str()) || getTestNodeTypeClass(node->getNodeType()) != child.nodeClass)
+		{
+			delete node;
+			throw tcu::InternalError(std::string("Lazily registered node '") + child.name + "' in group '" + getName() + "' doesn't match the created node.");
+		}
+
+		delete child.factory;
+		child.factory	= DE_NULL;
+		child.node		= node;
+		child.name.clear();
+	}
+
+	return child.node;
 }
 
 void TestNode::addChild (TestNode* node)
+{
+	addChild(Child(node));
+}
+
+void TestNode::addLazyChild (const char* name, TestNodeClass nodeClass, TestNodeFactory* factory)
+{
+	DE_ASSERT(isValidCaseName(name));
+
+	try
+	{
+		addChild(Child(name, nodeClass, factory));
+	}
+	catch (...)
+	{
+		delete factory;
+		throw;
+	}
+}
+
+void TestNode::addChild (const Child& child)
 {
 	// Child names must be unique!
 	// \todo [petri] O(n^2) algorithm, but shouldn't really matter..
 #if defined(DE_DEBUG)
-	for (int i = 0; i < (int)m_children.size(); i++)
 	{
-		if (deStringEqual(node->getName(), m_children[i]->getName()))
-			throw tcu::InternalError(std::string("Test case with non-unique name '") + node->getName() + "' added to group '" + getName() + "'.");
+		const char* const name = child.node ? child.node->getName() : child.name.c_str();
+
+		for (int i = 0; i < (int)m_children.size(); i++)
+		{
+			if (deStringEqual(name, getChildName(i)))
+				throw tcu::InternalError(std::string("Test case with non-unique name '") + name + "' added to group '" + getName() + "'.");
+		}
 	}
 #endif
 
@@ -92,9 +150,9 @@ void TestNode::addChild (TestNode* node)
 
 	// children must have the same class
 	if (!m_children.empty())
-		DE_ASSERT(getTestNodeTypeClass(m_children.front()->getNodeType()) == getTestNodeTypeClass(node->getNodeType()));
+		DE_ASSERT(m_children.front().nodeClass == child.nodeClass);
 
-	m_children.push_back(node);
+	m_children.push_back(child);
 }
 
 void TestNode::init (void)
@@ -104,7 +162,10 @@ void TestNode::init (void)
 void TestNode::deinit (void)
 {
 	for (int i = 0; i < (int)m_children.size(); i++)
-		delete m_children[i];
+	{
+		delete m_children[i].node;
+		delete m_children[i].factory;
+	}
 	m_children.clear();
 }
 
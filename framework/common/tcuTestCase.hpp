@@ -81,6 +81,36 @@ inline bool isValidTestCaseNameChar (char c)
 		   c == '_' || c == '-';
 }
 
+class TestNode;
+
+/*--------------------------------------------------------------------*//*!
+ * \brief Factory for lazily created test nodes
+ *
+ * Lazily registered child (see TestNode::addLazyChild()) is created only
+ * when it is accessed. Test hierarchy iterator checks the case filter
+ * before accessing a child, so subtrees that are not executed are never
+ * constructed.
+ *//*--------------------------------------------------------------------*/
+class TestNodeFactory
+{
+public:
+	virtual					~TestNodeFactory		(void) {}
+	virtual TestNode*		createNode				(TestContext& testCtx) const = 0;
+};
+
+template<typename NodeType>
+class FunctionTestNodeFactory : public TestNodeFactory
+{
+public:
+	typedef NodeType*		(*CreateFunc)			(TestContext& testCtx);
+
+	explicit				FunctionTestNodeFactory	(CreateFunc createFunc) : m_createFunc(createFunc) {}
+	TestNode*				createNode				(TestContext& testCtx) const { return m_createFunc(testCtx); }
+
+private:
+	const CreateFunc		m_createFunc;
+};
+
 /*--------------------------------------------------------------------*//*!
  * \brief Test case hierarchy node
  *
@@ -93,6 +123,10 @@ inline bool isValidTestCaseNameChar (char c)
  * During test execution TestExecutor iterates the hierarchy. Upon entering
  * the node (both groups and test cases) init() is called. When exiting the
  * node deinit() is called respectively.
+ *
+ * Children can also be registered lazily by name with addLazyChild(). Such
+ * child is created by the factory on first getChild() call. getChildren()
+ * creates all lazily registered children.
  *//*--------------------------------------------------------------------*/
 class TestNode
 {
@@ -114,6 +148,15 @@ public:
 	const char*				getDescription	(void) const	{ return m_description.c_str(); }
 	void					getChildren		(std::vector<TestNode*>& children);
 	void					addChild		(TestNode* node);
+	void					addLazyChild	(const char* name, TestNodeClass nodeClass, TestNodeFactory* factory);
+
+	template<typename NodeType>
+	void					addLazyChild	(const char* name, TestNodeClass nodeClass, NodeType* (*createFunc) (TestContext& testCtx));
+
+	int						getNumChildren	(void) const	{ return (int)m_children.size();	}
+	const char*				getChildName	(int childNdx) const;
+	TestNodeClass			getChildClass	(int childNdx) const;
+	TestNode*				getChild		(int childNdx);
 
 	virtual void			init			(void);
 	virtual void			deinit			(void);
@@ -125,10 +168,29 @@ protected:
 	std::string				m_description;
 
 private:
+	struct Child
+	{
+		TestNode*			node;
+		TestNodeFactory*	factory;	//!< Set until lazily registered child is created.
+		std::string			name;		//!< Name of lazily registered child.
+		TestNodeClass		nodeClass;
+
+		Child (TestNode* node_) : node(node_), factory(DE_NULL), nodeClass(getTestNodeTypeClass(node_->getNodeType())) {}
+		Child (const char* name_, TestNodeClass nodeClass_, TestNodeFactory* factory_) : node(DE_NULL), factory(factory_), name(name_), nodeClass(nodeClass_) {}
+	};
+
+	void					addChild		(const Child& child);
+
 	const TestNodeType		m_nodeType;
-	std::vector<TestNode*>	m_children;
+	std::vector<Child>		m_children;
 };
 
+template<typename NodeType>
+void TestNode::addLazyChild (const char* name, TestNodeClass nodeClass, NodeType* (*createFunc) (TestContext& testCtx))
+{
+	addLazyChild(name, nodeClass, new FunctionTestNodeFactory<NodeType>(createFunc));
+}
+
 /*--------------------------------------------------------------------*//*!
  * \brief Test case group node
  *
@@ -51,7 +51,7 @@ DefaultHierarchyInflater::~DefaultHierarchyInflater (void)
 {
 }
 
-void DefaultHierarchyInflater::enterTestPackage (TestPackage* testPackage, vector<TestNode*>& children)
+void DefaultHierarchyInflater::enterTestPackage (TestPackage* testPackage)
 {
 	{
 		Archive* const	pkgArchive	= testPackage->getArchive();
@@ -63,7 +63,6 @@ void DefaultHierarchyInflater::enterTestPackage (TestPackage* testPackage, vecto
 	}
 
 	testPackage->init();
-	testPackage->getChildren(children);
 }
 
 void DefaultHierarchyInflater::leaveTestPackage (TestPackage* testPackage)
@@ -72,10 +71,9 @@ void DefaultHierarchyInflater::leaveTestPackage (TestPackage* testPackage)
 	testPackage->deinit();
 }
 
-void DefaultHierarchyInflater::enterGroupNode (TestCaseGroup* testGroup, vector<TestNode*>& children)
+void DefaultHierarchyInflater::enterGroupNode (TestCaseGroup* testGroup)
 {
 	testGroup->init();
-	testGroup->getChildren(children);
 }
 
 void DefaultHierarchyInflater::leaveGroupNode (TestCaseGroup* testGroup)
@@ -92,9 +90,7 @@ TestHierarchyIterator::TestHierarchyIterator (TestPackageRoot&			rootNode,
 	, m_cmdLine		(cmdLine)
 {
 	// Init traverse state and "seek" to first reportable node.
-	NodeIter iter(&rootNode);
-	iter.setState(NodeIter::STATE_ENTER); // Root is never reported
-	m_sessionStack.push_back(iter);
+	m_sessionStack.push_back(NodeIter(&rootNode)); // Root is never reported
 	next();
 }
 
@@ -144,6 +140,15 @@ const std::string& TestHierarchyIterator::getNodePath (void) const
 	return m_nodePath;
 }
 
+std::string TestHierarchyIterator::buildChildPath (const std::string& parentPath, const char* childName)
+{
+	// Path of root is empty and it is not included in child paths.
+	if (parentPath.empty())
+		return childName;
+	else
+		return parentPath + "." + childName;
+}
+
 std::string TestHierarchyIterator::buildNodePath (const vector<NodeIter>& nodeStack)
 {
 	string nodePath;
@@ -167,22 +172,6 @@ void TestHierarchyIterator::next (void)
 
 		switch (iter.getState())
 		{
-			case NodeIter::STATE_INIT:
-			{
-				const std::string nodePath = buildNodePath(m_sessionStack);
-
-				// Return to parent if name doesn't match filter.
-				if (!(isLeaf ? m_cmdLine.checkTestCaseName(nodePath.c_str()) : m_cmdLine.checkTestGroupName(nodePath.c_str())))
-				{
-					m_sessionStack.pop_back();
-					break;
-				}
-
-				m_nodePath = nodePath;
-				iter.setState(NodeIter::STATE_ENTER);
-				return; // Yield enter event
-			}
-
 			case NodeIter::STATE_ENTER:
 			{
 				if (isLeaf)
@@ -193,13 +182,12 @@ void TestHierarchyIterator::next (void)
 				else
 				{
 					iter.setState(NodeIter::STATE_TRAVERSE_CHILDREN);
-					iter.children.clear();
 
 					switch (node->getNodeType())
 					{
-						case NODETYPE_ROOT:		static_cast<TestPackageRoot*>(node)->getChildren(iter.children);				break;
-						case NODETYPE_PACKAGE:	m_inflater.enterTestPackage(static_cast<TestPackage*>(node), iter.children);	break;
-						case NODETYPE_GROUP:	m_inflater.enterGroupNode(static_cast<TestCaseGroup*>(node), iter.children);	break;
+						case NODETYPE_ROOT:		/* root children are always available */						break;
+						case NODETYPE_PACKAGE:	m_inflater.enterTestPackage(static_cast<TestPackage*>(node));	break;
+						case NODETYPE_GROUP:	m_inflater.enterGroupNode(static_cast<TestCaseGroup*>(node));	break;
 						default:
 							DE_ASSERT(false);
 					}
@@ -210,20 +198,29 @@ void TestHierarchyIterator::next (void)
 
 			case NodeIter::STATE_TRAVERSE_CHILDREN:
 			{
-				int numChildren = (int)iter.children.size();
-				if (++iter.curChildNdx < numChildren)
-				{
-					// Push child to stack.
-					TestNode* childNode = iter.children[iter.curChildNdx];
-					m_sessionStack.push_back(NodeIter(childNode));
-				}
-				else
+				const int numChildren = node->getNumChildren();
+
+				while (++iter.curChildNdx < numChildren)
 				{
-					iter.setState(NodeIter::STATE_LEAVE);
-					if (node->getNodeType() != NODETYPE_ROOT)
-						return; // Yield leave event
+					const bool		isChildLeaf	= node->getChildClass(iter.curChildNdx) == NODECLASS_EXECUTABLE;
+					const string	childPath	= buildChildPath(m_nodePath, node->getChildName(iter.curChildNdx));
+
+					// Skip child if name doesn't match filter. Child is not created in that case.
+					if (isChildLeaf ? m_cmdLine.checkTestCaseName(childPath.c_str()) : m_cmdLine.checkTestGroupName(childPath.c_str()))
+					{
+						TestNode* const childNode = node->getChild(iter.curChildNdx);
+
+						// \note iter is invalidated by push_back().
+						m_sessionStack.push_back(NodeIter(childNode));
+						m_nodePath = childPath;
+						return; // Yield enter event
+					}
 				}
 
+				iter.setState(NodeIter::STATE_LEAVE);
+				if (node->getNodeType() != NODETYPE_ROOT)
+					return; // Yield leave event
+
 				break;
 			}
 
@@ -46,10 +46,10 @@ class TestHierarchyInflater
 public:
 									TestHierarchyInflater	(void);
 
-	virtual void					enterTestPackage		(TestPackage* testPackage, std::vector<TestNode*>& children) = 0;
+	virtual void					enterTestPackage		(TestPackage* testPackage) = 0;
 	virtual void					leaveTestPackage		(TestPackage* testPackage) = 0;
 
-	virtual void					enterGroupNode			(TestCaseGroup* testGroup, std::vector<TestNode*>& children) = 0;
+	virtual void					enterGroupNode			(TestCaseGroup* testGroup) = 0;
 	virtual void					leaveGroupNode			(TestCaseGroup* testGroup) = 0;
 
 protected:
@@ -63,10 +63,10 @@ public:
 									DefaultHierarchyInflater	(TestContext& testCtx);
 									~DefaultHierarchyInflater	(void);
 
-	virtual void					enterTestPackage			(TestPackage* testPackage, std::vector<TestNode*>& children);
+	virtual void					enterTestPackage			(TestPackage* testPackage);
 	virtual void					leaveTestPackage			(TestPackage* testPackage);
 
-	virtual void					enterGroupNode				(TestCaseGroup* testGroup, std::vector<TestNode*>& children);
+	virtual void					enterGroupNode				(TestCaseGroup* testGroup);
 	virtual void					leaveGroupNode				(TestCaseGroup* testGroup);
 
 protected:
@@ -100,6 +100,9 @@ protected:
  * Test hierarchy is created on demand with help of TestHierarchyInflater.
  * Upon entering a group node, after STATE_ENTER_NODE has been signaled,
  * inflater is called to construct the list of child nodes for that group.
+ * Child names are checked against the case filter before the child is
+ * accessed, so lazily registered children that don't match are never
+ * created.
  * Upon exiting a group node, before STATE_LEAVE_NODE is called, inflater
  * is asked to clean up any resources by calling leaveGroupNode() or
  * leaveTestPackage() depending on the type of the node.
@@ -131,8 +134,7 @@ private:
 	{
 		enum State
 		{
-			STATE_INIT = 0,
-			STATE_ENTER,
+			STATE_ENTER = 0,
 			STATE_TRAVERSE_CHILDREN,
 			STATE_LEAVE,
 
@@ -149,7 +151,7 @@ private:
 		NodeIter (TestNode* node_)
 			: node			(node_)
 			, curChildNdx	(-1)
-			, m_state		(STATE_INIT)
+			, m_state		(STATE_ENTER)
 		{
 		}
 
@@ -174,7 +176,6 @@ private:
 		}
 
 		TestNode*				node;
-		std::vector<TestNode*>	children;
 		int						curChildNdx;
 
 	private:
@@ -188,6 +189,7 @@ private:
 	bool					matchCaseName			(const std::string& caseName) const;
 
 	static std::string		buildNodePath			(const std::vector<NodeIter>& nodeStack);
+	static std::string		buildChildPath			(const std::string& parentPath, const char* childName);
 
 	TestHierarchyInflater&	m_inflater;
 	const CommandLine&		m_cmdLine;
@@ -149,8 +149,9 @@ TestPackageRoot::TestPackageRoot (TestContext& testCtx, const TestPackageRegistr
 {
 	const vector<TestPackageRegistry::PackageInfo*>&	packageInfos	= packageRegistry->getPackageInfos();
 
+	// Packages are created only if case filter matches them.
 	for (int i = 0; i < (int)packageInfos.size(); i++)
-		addChild(packageInfos[i]->createFunc(testCtx));
+		addLazyChild(packageInfos[i]->name.c_str(), NODECLASS_GROUP, packageInfos[i]->createFunc);
 }
 
 TestPackageRoot::~TestPackageRoot (void)
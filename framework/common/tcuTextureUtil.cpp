@@ -25,6 +25,7 @@
 #include "tcuVectorUtil.hpp"
 #include "deRandom.hpp"
 #include "deMath.h"
+#include "deFloat16.h"
 #include "deMemory.h"
 
 #include <limits>
@@ -1074,6 +1075,23 @@ void copy (const PixelBufferAccess& dst, const ConstPixelBufferAccess& src)
 			tcu::clearStencil(dst, 0u);
 		}
 	}
+	else if (src.getFormat().order == dst.getFormat().order && srcTightlyPacked && dstTightlyPacked &&
+			 ((src.getFormat().type == TextureFormat::FLOAT && dst.getFormat().type == TextureFormat::HALF_FLOAT) ||
+			  (src.getFormat().type == TextureFormat::HALF_FLOAT && dst.getFormat().type == TextureFormat::FLOAT)))
+	{
+		// Fast-path for float <-> half conversion, same results as setPixel(getPixel()).
+		const int	rowSize		= width * getNumUsedChannels(src.getFormat().order);
+		const bool	toHalf		= dst.getFormat().type == TextureFormat::HALF_FLOAT;
+
+		for (int z = 0; z < depth; z++)
+		for (int y = 0; y < height; y++)
+		{
+			if (toHalf)
+				deFloat32To16Array((deFloat16*)dst.getPixelPtr(0, y, z), (const float*)src.getPixelPtr(0, y, z), rowSize);
+			else
+				deFloat16To32Array((float*)dst.getPixelPtr(0, y, z), (const deFloat16*)src.getPixelPtr(0, y, z), rowSize);
+		}
+	}
 	else
 	{
 		TextureChannelClass		srcClass	= getTextureChannelClass(src.getFormat().type);
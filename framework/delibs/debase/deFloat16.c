@@ -161,4 +161,104 @@ float deFloat16To32 (deFloat16 val16)
 	return x.f;
 }
 
+/* Array conversions compute every case and select the result, which keeps
+ * the loop body free of branches. */
+
+DE_INLINE deUint32 selectUint32 (deBool cond, deUint32 a, deUint32 b)
+{
+	return cond ? a : b;
+}
+
+DE_INLINE deUint32 float32BitsTo16 (deUint32 bits)
+{
+	const deUint32	sign		= (bits >> 16u) & 0x00008000u;
+	const deUint32	absBits		= bits & 0x7fffffffu;
+	const deUint32	mantissa	= bits & 0x007fffffu;
+	const deUint32	expBits		= absBits >> 23u;
+
+	/* Normalized: rebias exponent and round mantissa to nearest even. Mantissa
+	 * overflow carries to exponent, and exponent overflow is clamped to InF. */
+	const deUint32	normal		= (absBits - ((127u - 15u) << 23u) + 0x00000fffu + ((absBits >> 13u) & 1u)) >> 13u;
+	const deUint32	clamped		= selectUint32(normal < 0x7c00u, normal, 0x7c00u);
+
+	/* Denormalized: shift significand with leading 1 right by 14 - exponent,
+	 * rounding to nearest even. Shift is limited to 25, which rounds all
+	 * smaller values to zero. */
+	const deUint32	denormExp	= selectUint32(expBits <= 127u - 15u, expBits, 127u - 15u);
+	const deUint32	shift		= selectUint32(denormExp < 127u - 15u - 10u, 25u, (127u - 15u) + 14u - denormExp);
+	const deUint32	significand	= mantissa | 0x00800000u;
+	const deUint32	denormal	= (significand + ((1u << (shift - 1u)) - 1u) + ((significand >> shift) & 1u)) >> shift;
+
+	/* InF and NaN. NaN keeps the high mantissa bits, at least one of which is set. */
+	const deUint32	nanMantissa	= mantissa >> 13u;
+	const deUint32	special		= 0x7c00u | nanMantissa | (deUint32)(mantissa != 0u && nanMantissa == 0u);
+
+	deUint32		result		= clamped;
+
+	result = selectUint32(expBits <= 127u - 15u, denormal, result);
+	result = selectUint32(expBits == 0xffu, special, result);
+
+	return sign | result;
+}
+
+DE_INLINE deUint32 float16BitsTo32 (deUint32 bits)
+{
+	const deUint32	sign		= (bits & 0x8000u) << 16u;
+	const deUint32	expotent	= (bits >> 10u) & 0x1fu;
+	const deUint32	mantissa	= bits & 0x03ffu;
+
+	const deUint32	normal		= ((expotent + (127u - 15u)) << 23u) | (mantissa << 13u);
+	const deUint32	special		= 0x7f800000u | (mantissa << 13u);
+
+	/* Denormalized values and zero are mantissa * 2^-24, which is exact in float. */
+	union
+	{
+		float		f;
+		deUint32	u;
+	} denormal;
+
+	deUint32		result		= normal;
+
+	denormal.f = (float)(int)mantissa * (1.0f / 16777216.0f);
+
+	result = selectUint32(expotent == 0u, denormal.u, result);
+	result = selectUint32(expotent == 31u, special, result);
+
+	return sign | result;
+}
+
+void deFloat32To16Array (deFloat16* dst, const float* src, int count)
+{
+	int ndx;
+
+	for (ndx = 0; ndx < count; ndx++)
+	{
+		union
+		{
+			float		f;
+			deUint32	u;
+		} x;
+
+		x.f			= src[ndx];
+		dst[ndx]	= (deFloat16)float32BitsTo16(x.u);
+	}
+}
+
+void deFloat16To32Array (float* dst, const deFloat16* src, int count)
+{
+	int ndx;
+
+	for (ndx = 0; ndx < count; ndx++)
+	{
+		union
+		{
+			float		f;
+			deUint32	u;
+		} x;
+
+		x.u			= float16BitsTo32((deUint32)src[ndx]);
+		dst[ndx]	= x.f;
+	}
+}
+
 DE_END_EXTERN_C
@@ -47,6 +47,30 @@ deFloat16	deFloat32To16		(float val32);
  *//*--------------------------------------------------------------------*/
 float		deFloat16To32		(deFloat16 val16);
 
+/*--------------------------------------------------------------------*//*!
+ * \brief Convert array of 32-bit floating point numbers to 16 bit.
+ * \param dst		Destination array.
+ * \param src		Source array.
+ * \param count	Number of values.
+ *
+ * Results are identical to deFloat32To16(). Conversion is branchless so
+ * that compiler can vectorize it.
+ *//*--------------------------------------------------------------------*/
+void		deFloat32To16Array	(deFloat16* dst, const float* src, int count);
+
+/*--------------------------------------------------------------------*//*!
+ * \brief Convert array of 16-bit floating point numbers to 32 bit.
+ * \param dst		Destination array.
+ * \param src		Source array.
+ * \param count	Number of values.
+ *
+ * Results are identical to deFloat16To32(). Conversion is branchless so
+ * that compiler can vectorize it.
+ *//*--------------------------------------------------------------------*/
+void		deFloat16To32Array	(float* dst, const deFloat16* src, int count);
+
+void		deFloat16_selfTest	(void);
+
 DE_END_EXTERN_C
 
 #endif /* _DEFLOAT16_H */
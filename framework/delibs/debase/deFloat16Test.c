@@ -0,0 +1,107 @@
+/*-------------------------------------------------------------------------
+ * drawElements Base Portability Library
+ * -------------------------------------
+ *
+ * Copyright 2015 The Android Open Source Project
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ *      http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ *
+ *//*!
+ *//*!
+ * \file
+ * \brief Testing of deFloat16 functions.
+ *//*--------------------------------------------------------------------*/
+
+#include "deFloat16.h"
+
+DE_BEGIN_EXTERN_C
+
+static float bitsToFloat (deUint32 bits)
+{
+	union
+	{
+		float		f;
+		deUint32	u;
+	} x;
+
+	x.u = bits;
+	return x.f;
+}
+
+static deUint32 floatToBits (float value)
+{
+	union
+	{
+		float		f;
+		deUint32	u;
+	} x;
+
+	x.f = value;
+	return x.u;
+}
+
+void deFloat16_selfTest (void)
+{
+	enum
+	{
+		BATCH_SIZE	= 1024
+	};
+
+	/* Low bits around rounding positions of normalized results. Upper bits are iterated exhaustively. */
+	static const deUint16	s_lowBits[]	= { 0x0000, 0x0001, 0x0fff, 0x1000, 0x1001, 0x1fff, 0x2000, 0x2001, 0x3000, 0x7fff, 0x8000, 0xefff, 0xf000, 0xffff };
+	float					floats[BATCH_SIZE];
+	deFloat16				halfs[BATCH_SIZE];
+	const deUint32			numLowBits	= (deUint32)DE_LENGTH_OF_ARRAY(s_lowBits);
+	deUint32				ndx;
+
+	/* Basic values. */
+	DE_TEST_ASSERT(deFloat32To16(1.0f) == 0x3c00);
+	DE_TEST_ASSERT(deFloat32To16(-2.0f) == 0xc000);
+	DE_TEST_ASSERT(deFloat32To16(65504.0f) == 0x7bff);
+	DE_TEST_ASSERT(deFloat32To16(65520.0f) == 0x7c00);
+	DE_TEST_ASSERT(deFloat16To32(0x0001) == 1.0f / 16777216.0f);
+	DE_TEST_ASSERT(deFloat16To32(0x3555) == 0.333251953125f);
+
+	/* Array conversion from 16 bits, all values. */
+	for (ndx = 0; ndx < 0x10000u; ndx += BATCH_SIZE)
+	{
+		int i;
+
+		for (i = 0; i < BATCH_SIZE; i++)
+			halfs[i] = (deFloat16)(ndx + (deUint32)i);
+
+		deFloat16To32Array(floats, halfs, BATCH_SIZE);
+
+		for (i = 0; i < BATCH_SIZE; i++)
+			DE_TEST_ASSERT(floatToBits(floats[i]) == floatToBits(deFloat16To32(halfs[i])));
+	}
+
+	/* Array conversion to 16 bits. */
+	for (ndx = 0; ndx < 0x10000u * numLowBits; ndx += BATCH_SIZE)
+	{
+		int i;
+
+		for (i = 0; i < BATCH_SIZE; i++)
+		{
+			const deUint32 valueNdx = ndx + (deUint32)i;
+			floats[i] = bitsToFloat(((valueNdx / numLowBits) << 16u) | s_lowBits[valueNdx % numLowBits]);
+		}
+
+		deFloat32To16Array(halfs, floats, BATCH_SIZE);
+
+		for (i = 0; i < BATCH_SIZE; i++)
+			DE_TEST_ASSERT(halfs[i] == deFloat32To16(floats[i]));
+	}
+}
+
+DE_END_EXTERN_C
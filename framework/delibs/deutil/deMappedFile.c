@@ -0,0 +1,223 @@
+/*-------------------------------------------------------------------------
+ * drawElements Utility Library
+ * ----------------------------
+ *
+ * Copyright 2014 The Android Open Source Project
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ *      http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ *
+ *//*!
+ * \file
+ * \brief Read-only memory-mapped file.
+ *//*--------------------------------------------------------------------*/
+
+#include "deMappedFile.h"
+#include "deMemory.h"
+
+#if (DE_OS == DE_OS_UNIX) || (DE_OS == DE_OS_OSX) || (DE_OS == DE_OS_IOS) || (DE_OS == DE_OS_ANDROID)
+
+#include <sys/types.h>
+#include <sys/stat.h>
+#include <sys/mman.h>
+#include <fcntl.h>
+#include <unistd.h>
+
+struct deMappedFile_s
+{
+	void*		ptr;
+	deInt64		size;
+};
+
+deMappedFile* deMappedFile_create (const char* filename)
+{
+	deMappedFile*	file	= DE_NULL;
+	int				fd		= open(filename, O_RDONLY);
+	struct stat		st;
+
+	if (fd < 0)
+		return DE_NULL;
+
+	if (fstat(fd, &st) != 0)
+	{
+		close(fd);
+		return DE_NULL;
+	}
+
+	file = (deMappedFile*)deCalloc(sizeof(deMappedFile));
+	if (!file)
+	{
+		close(fd);
+		return DE_NULL;
+	}
+
+	file->size = (deInt64)st.st_size;
+
+	/* \note Zero-sized mappings are not allowed. */
+	if (file->size > 0)
+	{
+		file->ptr = mmap(DE_NULL, (size_t)file->size, PROT_READ, MAP_PRIVATE, fd, 0);
+
+		if (file->ptr == MAP_FAILED)
+		{
+			close(fd);
+			deFree(file);
+			return DE_NULL;
+		}
+	}
+
+	/* Mapping keeps its own reference to the file. */
+	close(fd);
+
+	return file;
+}
+
+void deMappedFile_destroy (deMappedFile* file)
+{
+	if (file->ptr)
+		munmap(file->ptr, (size_t)file->size);
+
+	deFree(file);
+}
+
+#elif (DE_OS == DE_OS_WIN32)
+
+#define VC_EXTRALEAN
+#define WIN32_LEAN_AND_MEAN
+#include <windows.h>
+
+struct deMappedFile_s
+{
+	void*		ptr;
+	deInt64		size;
+};
+
+deMappedFile* deMappedFile_create (const char* filename)
+{
+	deMappedFile*	file		= DE_NULL;
+	HANDLE			handle		= CreateFile(filename, GENERIC_READ, FILE_SHARE_DELETE|FILE_SHARE_READ|FILE_SHARE_WRITE, DE_NULL, OPEN_EXISTING, FILE_ATTRIBUTE_NORMAL, DE_NULL);
+	LARGE_INTEGER	size;
+
+	if (handle == INVALID_HANDLE_VALUE)
+		return DE_NULL;
+
+	if (!GetFileSizeEx(handle, &size))
+	{
+		CloseHandle(handle);
+		return DE_NULL;
+	}
+
+	file = (deMappedFile*)deCalloc(sizeof(deMappedFile));
+	if (!file)
+	{
+		CloseHandle(handle);
+		return DE_NULL;
+	}
+
+	file->size = (deInt64)size.QuadPart;
+
+	if (file->size > 0)
+	{
+		HANDLE mapping = CreateFileMapping(handle, DE_NULL, PAGE_READONLY, 0, 0, DE_NULL);
+
+		if (mapping)
+		{
+			file->ptr = MapViewOfFile(mapping, FILE_MAP_READ, 0, 0, 0);
+			CloseHandle(mapping);
+		}
+
+		if (!file->ptr)
+		{
+			CloseHandle(handle);
+			deFree(file);
+			return DE_NULL;
+		}
+	}
+
+	CloseHandle(handle);
+
+	return file;
+}
+
+void deMappedFile_destroy (deMappedFile* file)
+{
+	if (file->ptr)
+		UnmapViewOfFile(file->ptr);
+
+	deFree(file);
+}
+
+#else
+
+#include "deFile.h"
+
+/* No mapping support: read whole file into memory. */
+
+struct deMappedFile_s
+{
+	void*		ptr;
+	deInt64		size;
+};
+
+deMappedFile* deMappedFile_create (const char* filename)
+{
+	deFile*			src		= deFile_create(filename, DE_FILEMODE_READ|DE_FILEMODE_OPEN);
+	deMappedFile*	file	= DE_NULL;
+	deInt64			numRead	= 0;
+
+	if (!src)
+		return DE_NULL;
+
+	file = (deMappedFile*)deCalloc(sizeof(deMappedFile));
+	if (!file)
+	{
+		deFile_destroy(src);
+		return DE_NULL;
+	}
+
+	file->size = deFile_getSize(src);
+
+	if (file->size > 0)
+	{
+		file->ptr = deMalloc((size_t)file->size);
+
+		if (!file->ptr || deFile_read(src, file->ptr, file->size, &numRead) != DE_FILERESULT_SUCCESS || numRead != file->size)
+		{
+			deFile_destroy(src);
+			deFree(file->ptr);
+			deFree(file);
+			return DE_NULL;
+		}
+	}
+
+	deFile_destroy(src);
+
+	return file;
+}
+
+void deMappedFile_destroy (deMappedFile* file)
+{
+	deFree(file->ptr);
+	deFree(file);
+}
+
+#endif
+
+const void* deMappedFile_getPtr (const deMappedFile* file)
+{
+	return file->ptr;
+}
+
+deInt64 deMappedFile_getSize (const deMappedFile* file)
+{
+	return file->size;
+}
@@ -0,0 +1,244 @@
+/*-------------------------------------------------------------------------
+ * drawElements Quality Program OpenGL ES Utilities
+ * ------------------------------------------------
+ *
+ * Copyright 2014 The Android Open Source Project
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ *      http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ *
+ *//*!
+ * \file
+ * \brief Reference context small draw benchmark.
+ *//*--------------------------------------------------------------------*/
+
+#include "sglrReferenceContext.hpp"
+#include "sglrShaderProgram.hpp"
+#include "tcuTexture.hpp"
+#include "tcuTextureUtil.hpp"
+#include "deClock.h"
+#include "deString.h"
+#include "deArrayUtil.hpp"
+#include "glwEnums.hpp"
+
+#include <vector>
+#include <algorithm>
+#include <cstdio>
+#include <cstdlib>
+
+using std::vector;
+
+namespace
+{
+
+enum DrawCase
+{
+	DRAWCASE_FLAT = 0,		//!< Uniform color, location looked up for every draw
+	DRAWCASE_TEXTURED,		//!< Flat color modulated by 2D texture
+	DRAWCASE_DEPTH_TEST,	//!< Flat color with depth test
+
+	DRAWCASE_LAST
+};
+
+const char* getDrawCaseName (DrawCase drawCase)
+{
+	static const char* const s_names[] =
+	{
+		"flat",
+		"textured",
+		"depth_test"
+	};
+
+	return de::getSizedArrayElement<DRAWCASE_LAST>(s_names, drawCase);
+}
+
+class BenchShader : public sglr::ShaderProgram
+{
+public:
+	BenchShader (void)
+		: sglr::ShaderProgram(sglr::pdec::ShaderProgramDeclaration()
+							  << sglr::pdec::VertexAttribute("a_position", rr::GENERICVECTYPE_FLOAT)
+							  << sglr::pdec::VertexAttribute("a_coord", rr::GENERICVECTYPE_FLOAT)
+							  << sglr::pdec::VertexToFragmentVarying(rr::GENERICVECTYPE_FLOAT)
+							  << sglr::pdec::FragmentOutput(rr::GENERICVECTYPE_FLOAT)
+							  << sglr::pdec::Uniform("u_color", glu::TYPE_FLOAT_VEC4)
+							  << sglr::pdec::Uniform("u_useTexture", glu::TYPE_INT)
+							  << sglr::pdec::Uniform("u_sampler", glu::TYPE_SAMPLER_2D)
+							  << sglr::pdec::VertexSource("")
+							  << sglr::pdec::FragmentSource(""))
+	{
+	}
+
+	void shadeVertices (const rr::VertexAttrib* inputs, rr::VertexPacket* const* packets, const int numPackets) const
+	{
+		for (int packetNdx = 0; packetNdx < numPackets; ++packetNdx)
+		{
+			rr::VertexPacket& packet = *packets[packetNdx];
+
+			packet.position		= rr::readVertexAttribFloat(inputs[0], packet.instanceNdx, packet.vertexNdx);
+			packet.outputs[0]	= rr::readVertexAttribFloat(inputs[1], packet.instanceNdx, packet.vertexNdx);
+		}
+	}
+
+	void shadeFragments (rr::FragmentPacket* packets, const int numPackets, const rr::FragmentShadingContext& context) const
+	{
+		const tcu::Vec4		color		= tcu::Vec4(m_uniforms[0].value.f4);
+		const bool			useTexture	= m_uniforms[1].value.i != 0;
+
+		for (int packetNdx = 0; packetNdx < numPackets; ++packetNdx)
+		for (int fragNdx = 0; fragNdx < rr::NUM_FRAGMENTS_PER_PACKET; ++fragNdx)
+		{
+			tcu::Vec4 result = color;
+
+			if (useTexture)
+			{
+				const tcu::Vec4 coord = rr::readTriangleVarying<float>(packets[packetNdx], context, 0, fragNdx);
+				result = result * m_uniforms[2].sampler.tex2D->sample(coord.x(), coord.y(), 0.0f);
+			}
+
+			rr::writeFragmentOutput(context, packetNdx, fragNdx, 0, result);
+		}
+	}
+};
+
+//! Draws per second for numDraws small quads
+double runDrawCase (DrawCase drawCase, int numDraws)
+{
+	const int							size		= 128;
+	const int							quadSize	= 4;
+	const sglr::ReferenceContextLimits	limits;
+	sglr::ReferenceContextBuffers		buffers		(tcu::PixelFormat(8,8,8,8), 24, 8, size, size);
+	sglr::ReferenceContext				ctx			(limits, buffers.getColorbuffer(), buffers.getDepthbuffer(), buffers.getStencilbuffer());
+	BenchShader							shader;
+	const deUint32						program		= ctx.createProgram(&shader);
+	deUint32							texture		= 0;
+	vector<float>						positions	(numDraws*6*4);
+	vector<float>						coords		(numDraws*6*4);
+
+	// Quads on a grid, each with its own vertex data
+	for (int drawNdx = 0; drawNdx < numDraws; ++drawNdx)
+	{
+		const int	cellsPerRow	= size / quadSize;
+		const float	x0			= 2.0f * (float)((drawNdx % cellsPerRow) * quadSize) / (float)size - 1.0f;
+		const float	y0			= 2.0f * (float)(((drawNdx / cellsPerRow) % cellsPerRow) * quadSize) / (float)size - 1.0f;
+		const float	x1			= x0 + 2.0f * (float)quadSize / (float)size;
+		const float	y1			= y0 + 2.0f * (float)quadSize / (float)size;
+		const float	z			= (float)(drawNdx % 7) / 7.0f - 0.5f;
+		const float	vertices[]	=
+		{
+			x0, y0, z, 1.0f,	x1, y0, z, 1.0f,	x0, y1, z, 1.0f,
+			x0, y1, z, 1.0f,	x1, y0, z, 1.0f,	x1, y1, z, 1.0f
+		};
+		const float	texCoords[]	=
+		{
+			0.0f, 0.0f, 0.0f, 0.0f,		1.0f, 0.0f, 0.0f, 0.0f,		0.0f, 1.0f, 0.0f, 0.0f,
+			0.0f, 1.0f, 0.0f, 0.0f,		1.0f, 0.0f, 0.0f, 0.0f,		1.0f, 1.0f, 0.0f, 0.0f
+		};
+
+		std::copy(DE_ARRAY_BEGIN(vertices), DE_ARRAY_END(vertices), positions.begin() + drawNdx*6*4);
+		std::copy(DE_ARRAY_BEGIN(texCoords), DE_ARRAY_END(texCoords), coords.begin() + drawNdx*6*4);
+	}
+
+	if (drawCase == DRAWCASE_TEXTURED)
+	{
+		tcu::TextureLevel texData (tcu::TextureFormat(tcu::TextureFormat::RGBA, tcu::TextureFormat::UNORM_INT8), 16, 16);
+
+		tcu::fillWithComponentGradients(texData.getAccess(), tcu::Vec4(0.0f), tcu::Vec4(1.0f));
+
+		ctx.genTextures(1, &texture);
+		ctx.bindTexture(GL_TEXTURE_2D, texture);
+		ctx.texImage2D(GL_TEXTURE_2D, 0, GL_RGBA, 16, 16, 0, GL_RGBA, GL_UNSIGNED_BYTE, texData.getAccess().getDataPtr());
+		ctx.texParameteri(GL_TEXTURE_2D, GL_TEXTURE_MIN_FILTER, GL_NEAREST);
+		ctx.texParameteri(GL_TEXTURE_2D, GL_TEXTURE_MAG_FILTER, GL_NEAREST);
+	}
+
+	if (drawCase == DRAWCASE_DEPTH_TEST)
+	{
+		ctx.enable(GL_DEPTH_TEST);
+		ctx.depthFunc(GL_LESS);
+	}
+
+	ctx.viewport(0, 0, size, size);
+	ctx.clearColor(0.0f, 0.0f, 0.0f, 1.0f);
+	ctx.clear(GL_COLOR_BUFFER_BIT|GL_DEPTH_BUFFER_BIT|GL_STENCIL_BUFFER_BIT);
+	ctx.useProgram(program);
+	ctx.uniform1i(ctx.getUniformLocation(program, "u_useTexture"), (drawCase == DRAWCASE_TEXTURED) ? 1 : 0);
+	ctx.uniform1i(ctx.getUniformLocation(program, "u_sampler"), 0);
+	ctx.enableVertexAttribArray(0);
+	ctx.enableVertexAttribArray(1);
+
+	{
+		const deUint64 startTime = deGetMicroseconds();
+
+		for (int drawNdx = 0; drawNdx < numDraws; ++drawNdx)
+		{
+			const float color[] = { (float)(drawNdx % 3) / 2.0f, (float)(drawNdx % 5) / 4.0f, 1.0f, 1.0f };
+
+			// Same call pattern as tests: look up location, set uniform, set pointers, draw
+			ctx.uniform4fv(ctx.getUniformLocation(program, "u_color"), 1, color);
+			ctx.vertexAttribPointer(0, 4, GL_FLOAT, GL_FALSE, 0, &positions[drawNdx*6*4]);
+			ctx.vertexAttribPointer(1, 4, GL_FLOAT, GL_FALSE, 0, &coords[drawNdx*6*4]);
+			ctx.drawArrays(GL_TRIANGLES, 0, 6);
+		}
+
+		ctx.finish();
+
+		{
+			const double seconds = (double)(deGetMicroseconds() - startTime) / 1000000.0;
+
+			if (texture)
+				ctx.deleteTextures(1, &texture);
+			ctx.deleteProgram(program);
+
+			return (double)numDraws / seconds;
+		}
+	}
+}
+
+} // anonymous
+
+int main (int argc, const char* const* argv)
+{
+	int numDraws = 20000;
+
+	for (int argNdx = 1; argNdx < argc; argNdx++)
+	{
+		if (deStringBeginsWith(argv[argNdx], "--draws="))
+			numDraws = atoi(argv[argNdx] + 8);
+		else
+		{
+			printf("Usage: %s [--draws=<count per case>]\n", argv[0]);
+			return -1;
+		}
+	}
+
+	numDraws = de::max(numDraws, 1);
+
+	printf("%-20s %14s\n", "Case", "Draws/s");
+
+	for (int caseNdx = 0; caseNdx < DRAWCASE_LAST; caseNdx++)
+	{
+		try
+		{
+			printf("%-20s %14.1f\n", getDrawCaseName((DrawCase)caseNdx), runDrawCase((DrawCase)caseNdx, numDraws));
+		}
+		catch (const std::exception& e)
+		{
+			printf("%-20s FAIL: %s\n", getDrawCaseName((DrawCase)caseNdx), e.what());
+			return 1;
+		}
+	}
+
+	printf("\n%d draws of %dx%d pixels per case\n", numDraws, 4, 4);
+
+	return 0;
+}
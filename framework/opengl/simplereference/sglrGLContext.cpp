@@ -23,6 +23,7 @@
 
 #include "sglrGLContext.hpp"
 #include "sglrShaderProgram.hpp"
+#include "sglrReferenceRenderContext.hpp"
 #include "gluPixelTransfer.hpp"
 #include "gluTexture.hpp"
 #include "gluCallLogWrapper.hpp"
@@ -30,6 +31,8 @@
 #include "glwFunctions.hpp"
 #include "glwEnums.hpp"
 
+#include <algorithm>
+
 namespace sglr
 {
 
@@ -108,6 +111,12 @@ GLContext::~GLContext (void)
 		delete *i;
 	}
 
+	if (const ReferenceRenderContext* refRenderCtx = dynamic_cast<const ReferenceRenderContext*>(&m_context))
+	{
+		for (std::vector<deUint32>::const_iterator i = m_referencePrograms.begin(); i != m_referencePrograms.end(); i++)
+			refRenderCtx->getReferenceContext().deleteProgram(*i);
+	}
+
 	gl.useProgram(0);
 
 	delete m_wrapper;
@@ -849,6 +858,17 @@ void GLContext::multiDrawElementsBaseVertex (deUint32 mode, const int* count, de
 
 deUint32 GLContext::createProgram (ShaderProgram* shader)
 {
+	// Reference-backed render context can't compile GLSL, but can execute the C++ shader directly.
+	if (const ReferenceRenderContext* refRenderCtx = dynamic_cast<const ReferenceRenderContext*>(&m_context))
+	{
+		m_referencePrograms.reserve(m_referencePrograms.size()+1);
+
+		const deUint32 program = refRenderCtx->getReferenceContext().createProgram(shader);
+
+		m_referencePrograms.push_back(program);
+		return program;
+	}
+
 	m_programs.reserve(m_programs.size()+1);
 
 	glu::ShaderProgram* program = DE_NULL;
@@ -877,6 +897,17 @@ deUint32 GLContext::createProgram (ShaderProgram* shader)
 
 void GLContext::deleteProgram (deUint32 program)
 {
+	{
+		const std::vector<deUint32>::iterator i = std::find(m_referencePrograms.begin(), m_referencePrograms.end(), program);
+
+		if (i != m_referencePrograms.end())
+		{
+			dynamic_cast<const ReferenceRenderContext&>(m_context).getReferenceContext().deleteProgram(program);
+			m_referencePrograms.erase(i);
+			return;
+		}
+	}
+
 	for (std::vector<glu::ShaderProgram*>::iterator i = m_programs.begin(); i != m_programs.end(); i++)
 	{
 		if ((*i)->getProgram() == program)
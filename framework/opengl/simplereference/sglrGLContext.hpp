@@ -243,6 +243,7 @@ private:
 	std::set<deUint32>					m_allocatedBuffers;
 	std::set<deUint32>					m_allocatedVaos;
 	std::vector<glu::ShaderProgram*>	m_programs;
+	std::vector<deUint32>				m_referencePrograms;	//!< Programs created directly in ReferenceRenderContext.
 } DE_WARN_UNUSED_TYPE;
 
 } // sglr
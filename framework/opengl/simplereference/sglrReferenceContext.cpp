@@ -1018,6 +1018,33 @@ static void clearToTextureInitialValue (PixelBufferAccess access)
 		tcu::clear(access, Vec4(0.0f, 0.0f, 0.0f, 1.0f));
 }
 
+const rc::LevelStorage& ReferenceContext::getInitialLevelData (const tcu::TextureFormat& format, int numPixels)
+{
+	const InitialLevelDataKey						key	((deUint32)(format.order << 16) | (deUint32)format.type, numPixels);
+	std::map<InitialLevelDataKey, rc::LevelStorage>::iterator	pos	= m_initialLevelData.find(key);
+
+	if (pos != m_initialLevelData.end())
+		return pos->second;
+
+	// Drop entries no level refers to anymore
+	for (std::map<InitialLevelDataKey, rc::LevelStorage>::iterator iter = m_initialLevelData.begin(); iter != m_initialLevelData.end();)
+	{
+		if (!iter->second.isShared())
+			m_initialLevelData.erase(iter++);
+		else
+			++iter;
+	}
+
+	{
+		rc::LevelStorage& storage = m_initialLevelData[key];
+
+		storage.setStorage((size_t)format.getPixelSize() * (size_t)numPixels);
+		clearToTextureInitialValue(PixelBufferAccess(format, numPixels, 1, 1, storage.getWritablePtr()));
+
+		return storage;
+	}
+}
+
 void ReferenceContext::texImage3D (deUint32 target, int level, deUint32 internalFormat, int width, int height, int depth, int border, deUint32 format, deUint32 type, const void* data)
 {
 	TextureUnit&		unit					= m_textureUnits[m_activeTexture];
@@ -1055,7 +1082,7 @@ void ReferenceContext::texImage3D (deUint32 target, int level, deUint32 internal
 			RC_IF_ERROR(storageFmt	!= dst.getFormat()	||
 						width		!= dst.getWidth(), GL_INVALID_OPERATION, RC_RET_VOID);
 		}
-		else
+		else if (unpackPtr)
 			texture->allocLevel(level, storageFmt, width);
 
 		if (unpackPtr)
@@ -1070,8 +1097,8 @@ void ReferenceContext::texImage3D (deUint32 target, int level, deUint32 internal
 		}
 		else
 		{
-			// No data supplied, clear to initial
-			clearToTextureInitialValue(texture->getLevel(level));
+			// No data supplied, share storage cleared to initial value
+			texture->allocLevel(level, storageFmt, width, &getInitialLevelData(storageFmt, width));
 		}
 	}
 	else if (target == GL_TEXTURE_2D)
@@ -1091,7 +1118,7 @@ void ReferenceContext::texImage3D (deUint32 target, int level, deUint32 internal
 						width		!= dst.getWidth()	||
 						height		!= dst.getHeight(), GL_INVALID_OPERATION, RC_RET_VOID);
 		}
-		else
+		else if (unpackPtr)
 			texture->allocLevel(level, storageFmt, width, height);
 
 		if (unpackPtr)
@@ -1106,8 +1133,8 @@ void ReferenceContext::texImage3D (deUint32 target, int level, deUint32 internal
 		}
 		else
 		{
-			// No data supplied, clear to initial
-			clearToTextureInitialValue(texture->getLevel(level));
+			// No data supplied, share storage cleared to initial value
+			texture->allocLevel(level, storageFmt, width, height, &getInitialLevelData(storageFmt, width*height));
 		}
 	}
 	else if (target == GL_TEXTURE_CUBE_MAP_NEGATIVE_X ||
@@ -1133,7 +1160,7 @@ void ReferenceContext::texImage3D (deUint32 target, int level, deUint32 internal
 						width		!= dst.getWidth()	||
 						height		!= dst.getHeight(), GL_INVALID_OPERATION, RC_RET_VOID);
 		}
-		else
+		else if (unpackPtr)
 			texture->allocFace(level, face, storageFmt, width, height);
 
 		if (unpackPtr)
@@ -1148,8 +1175,8 @@ void ReferenceContext::texImage3D (deUint32 target, int level, deUint32 internal
 		}
 		else
 		{
-			// No data supplied, clear to initial
-			clearToTextureInitialValue(texture->getFace(level, face));
+			// No data supplied, share storage cleared to initial value
+			texture->allocFace(level, face, storageFmt, width, height, &getInitialLevelData(storageFmt, width*height));
 		}
 	}
 	else if (target == GL_TEXTURE_2D_ARRAY)
@@ -1172,7 +1199,7 @@ void ReferenceContext::texImage3D (deUint32 target, int level, deUint32 internal
 						height		!= dst.getHeight()	||
 						depth		!= dst.getDepth(), GL_INVALID_OPERATION, RC_RET_VOID);
 		}
-		else
+		else if (unpackPtr)
 			texture->allocLevel(level, storageFmt, width, height, depth);
 
 		if (unpackPtr)
@@ -1187,8 +1214,8 @@ void ReferenceContext::texImage3D (deUint32 target, int level, deUint32 internal
 		}
 		else
 		{
-			// No data supplied, clear to initial
-			clearToTextureInitialValue(texture->getLevel(level));
+			// No data supplied, share storage cleared to initial value
+			texture->allocLevel(level, storageFmt, width, height, depth, &getInitialLevelData(storageFmt, width*height*depth));
 		}
 	}
 	else if (target == GL_TEXTURE_3D)
@@ -1211,7 +1238,7 @@ void ReferenceContext::texImage3D (deUint32 target, int level, deUint32 internal
 						height		!= dst.getHeight()	||
 						depth		!= dst.getDepth(), GL_INVALID_OPERATION, RC_RET_VOID);
 		}
-		else
+		else if (unpackPtr)
 			texture->allocLevel(level, storageFmt, width, height, depth);
 
 		if (unpackPtr)
@@ -1226,8 +1253,8 @@ void ReferenceContext::texImage3D (deUint32 target, int level, deUint32 internal
 		}
 		else
 		{
-			// No data supplied, clear to initial
-			clearToTextureInitialValue(texture->getLevel(level));
+			// No data supplied, share storage cleared to initial value
+			texture->allocLevel(level, storageFmt, width, height, depth, &getInitialLevelData(storageFmt, width*height*depth));
 		}
 	}
 	else if (target == GL_TEXTURE_CUBE_MAP_ARRAY)
@@ -1251,7 +1278,7 @@ void ReferenceContext::texImage3D (deUint32 target, int level, deUint32 internal
 						height		!= dst.getHeight()	||
 						depth		!= dst.getDepth(), GL_INVALID_OPERATION, RC_RET_VOID);
 		}
-		else
+		else if (unpackPtr)
 			texture->allocLevel(level, storageFmt, width, height, depth);
 
 		if (unpackPtr)
@@ -1266,8 +1293,8 @@ void ReferenceContext::texImage3D (deUint32 target, int level, deUint32 internal
 		}
 		else
 		{
-			// No data supplied, clear to initial
-			clearToTextureInitialValue(texture->getLevel(level));
+			// No data supplied, share storage cleared to initial value
+			texture->allocLevel(level, storageFmt, width, height, depth, &getInitialLevelData(storageFmt, width*height*depth));
 		}
 	}
 	else
@@ -2317,7 +2344,7 @@ void ReferenceContext::renderbufferStorage (deUint32 target, deUint32 internalfo
 	RC_IF_ERROR(format.order == TextureFormat::CHANNELORDER_LAST ||
 				format.type == TextureFormat::CHANNELTYPE_LAST, GL_INVALID_ENUM, RC_RET_VOID);
 
-	m_renderbufferBinding->setStorage(format, (int)width, (int)height);
+	m_renderbufferBinding->setStorage(format, (int)width, (int)height, &getInitialLevelData(format, width*height));
 }
 
 void ReferenceContext::renderbufferStorageMultisample (deUint32 target, int samples, deUint32 internalFormat, int width, int height)
@@ -4658,6 +4685,88 @@ const char* ReferenceContext::getString (deUint32 pname)
 namespace rc
 {
 
+LevelStorage::LevelStorage (void)
+	: m_buffer(DE_NULL)
+{
+}
+
+LevelStorage::LevelStorage (const LevelStorage& other)
+	: m_buffer(other.m_buffer)
+{
+	if (m_buffer)
+		m_buffer->refCount += 1;
+}
+
+LevelStorage::~LevelStorage (void)
+{
+	release();
+}
+
+LevelStorage& LevelStorage::operator= (const LevelStorage& other)
+{
+	if (other.m_buffer)
+		other.m_buffer->refCount += 1;
+
+	release();
+	m_buffer = other.m_buffer;
+
+	return *this;
+}
+
+void LevelStorage::setStorage (size_t size)
+{
+	Buffer* const buffer = new Buffer();
+
+	try
+	{
+		buffer->data.setStorage(size);
+		buffer->refCount = 1;
+	}
+	catch (...)
+	{
+		delete buffer;
+		throw;
+	}
+
+	release();
+	m_buffer = buffer;
+}
+
+void LevelStorage::clear (void)
+{
+	release();
+}
+
+void* LevelStorage::getWritablePtr (void)
+{
+	if (isShared())
+	{
+		LevelStorage copy;
+
+		copy.setStorage(size());
+		deMemcpy(copy.m_buffer->data.getPtr(), getPtr(), size());
+
+		*this = copy;
+	}
+
+	return m_buffer ? m_buffer->data.getPtr() : DE_NULL;
+}
+
+void LevelStorage::release (void)
+{
+	if (m_buffer)
+	{
+		DE_ASSERT(m_buffer->refCount > 0);
+
+		m_buffer->refCount -= 1;
+
+		if (m_buffer->refCount == 0)
+			delete m_buffer;
+
+		m_buffer = DE_NULL;
+	}
+}
+
 TextureLevelArray::TextureLevelArray (void)
 {
 }
@@ -4678,7 +4787,30 @@ void TextureLevelArray::clear (void)
 	}
 }
 
-void TextureLevelArray::allocLevel (int level, const tcu::TextureFormat& format, int width, int height, int depth)
+const tcu::PixelBufferAccess& TextureLevelArray::getLevel (int level)
+{
+	DE_ASSERT(hasLevel(level));
+
+	if (m_data[level].isShared())
+	{
+		const void* const	prevPtr		= m_data[level].getPtr();
+		void* const			dataPtr		= m_data[level].getWritablePtr();
+		const PixelBufferAccess	prev	= m_access[level];
+
+		m_access[level] = PixelBufferAccess(prev.getFormat(), prev.getSize(), prev.getPitch(), dataPtr);
+
+		// Sampler view refers to the same data, possibly with a different format
+		if (m_effectiveAccess[level].getDataPtr() == prevPtr)
+		{
+			const ConstPixelBufferAccess prevEffective = m_effectiveAccess[level];
+			m_effectiveAccess[level] = ConstPixelBufferAccess(prevEffective.getFormat(), prevEffective.getSize(), prevEffective.getPitch(), dataPtr);
+		}
+	}
+
+	return m_access[level];
+}
+
+void TextureLevelArray::allocLevel (int level, const tcu::TextureFormat& format, int width, int height, int depth, const LevelStorage* sharedData)
 {
 	const int dataSize = format.getPixelSize()*width*height*depth;
 
@@ -4687,8 +4819,16 @@ void TextureLevelArray::allocLevel (int level, const tcu::TextureFormat& format,
 	if (hasLevel(level))
 		clearLevel(level);
 
-	m_data[level].setStorage(dataSize);
-	m_access[level] = PixelBufferAccess(format, width, height, depth, m_data[level].getPtr());
+	if (sharedData)
+	{
+		DE_ASSERT(sharedData->size() == (size_t)dataSize);
+		m_data[level] = *sharedData;
+	}
+	else
+		m_data[level].setStorage(dataSize);
+
+	// \note Shared data is only written through getLevel(), which detaches it first.
+	m_access[level] = PixelBufferAccess(format, width, height, depth, const_cast<void*>(m_data[level].getPtr()));
 }
 
 void TextureLevelArray::clearLevel (int level)
@@ -4736,9 +4876,9 @@ Texture1D::~Texture1D (void)
 {
 }
 
-void Texture1D::allocLevel (int level, const tcu::TextureFormat& format, int width)
+void Texture1D::allocLevel (int level, const tcu::TextureFormat& format, int width, const LevelStorage* sharedData)
 {
-	m_levels.allocLevel(level, format, width, 1, 1);
+	m_levels.allocLevel(level, format, width, 1, 1, sharedData);
 }
 
 bool Texture1D::isComplete (void) const
@@ -4833,9 +4973,9 @@ Texture2D::~Texture2D (void)
 {
 }
 
-void Texture2D::allocLevel (int level, const tcu::TextureFormat& format, int width, int height)
+void Texture2D::allocLevel (int level, const tcu::TextureFormat& format, int width, int height, const LevelStorage* sharedData)
 {
-	m_levels.allocLevel(level, format, width, height, 1);
+	m_levels.allocLevel(level, format, width, height, 1, sharedData);
 }
 
 bool Texture2D::isComplete (void) const
@@ -4942,9 +5082,9 @@ void TextureCube::clearLevels (void)
 		m_levels[face].clear();
 }
 
-void TextureCube::allocFace (int level, tcu::CubeFace face, const tcu::TextureFormat& format, int width, int height)
+void TextureCube::allocFace (int level, tcu::CubeFace face, const tcu::TextureFormat& format, int width, int height, const LevelStorage* sharedData)
 {
-	m_levels[face].allocLevel(level, format, width, height, 1);
+	m_levels[face].allocLevel(level, format, width, height, 1, sharedData);
 }
 
 bool TextureCube::isComplete (void) const
@@ -5065,9 +5205,9 @@ Texture2DArray::~Texture2DArray (void)
 {
 }
 
-void Texture2DArray::allocLevel (int level, const tcu::TextureFormat& format, int width, int height, int numLayers)
+void Texture2DArray::allocLevel (int level, const tcu::TextureFormat& format, int width, int height, int numLayers, const LevelStorage* sharedData)
 {
-	m_levels.allocLevel(level, format, width, height, numLayers);
+	m_levels.allocLevel(level, format, width, height, numLayers, sharedData);
 }
 
 bool Texture2DArray::isComplete (void) const
@@ -5170,10 +5310,10 @@ TextureCubeArray::~TextureCubeArray (void)
 {
 }
 
-void TextureCubeArray::allocLevel (int level, const tcu::TextureFormat& format, int width, int height, int numLayers)
+void TextureCubeArray::allocLevel (int level, const tcu::TextureFormat& format, int width, int height, int numLayers, const LevelStorage* sharedData)
 {
 	DE_ASSERT(numLayers % 6 == 0);
-	m_levels.allocLevel(level, format, width, height, numLayers);
+	m_levels.allocLevel(level, format, width, height, numLayers, sharedData);
 }
 
 bool TextureCubeArray::isComplete (void) const
@@ -5291,9 +5431,9 @@ Texture3D::~Texture3D (void)
 {
 }
 
-void Texture3D::allocLevel (int level, const tcu::TextureFormat& format, int width, int height, int depth)
+void Texture3D::allocLevel (int level, const tcu::TextureFormat& format, int width, int height, int depth, const LevelStorage* sharedData)
 {
-	m_levels.allocLevel(level, format, width, height, depth);
+	m_levels.allocLevel(level, format, width, height, depth, sharedData);
 }
 
 bool Texture3D::isComplete (void) const
@@ -5392,6 +5532,8 @@ void Texture3D::updateView (tcu::Sampler::DepthStencilMode mode)
 
 Renderbuffer::Renderbuffer (deUint32 name)
 	: NamedObject		(name)
+	, m_width			(0)
+	, m_height			(0)
 {
 }
 
@@ -5399,9 +5541,31 @@ Renderbuffer::~Renderbuffer (void)
 {
 }
 
-void Renderbuffer::setStorage (const TextureFormat& format, int width, int height)
+void Renderbuffer::setStorage (const TextureFormat& format, int width, int height, const LevelStorage* sharedData)
+{
+	const size_t dataSize = (size_t)(format.getPixelSize()*width*height);
+
+	if (sharedData)
+	{
+		DE_ASSERT(sharedData->size() == dataSize);
+		m_data = *sharedData;
+	}
+	else
+		m_data.setStorage(dataSize);
+
+	m_format	= format;
+	m_width		= width;
+	m_height	= height;
+}
+
+tcu::PixelBufferAccess Renderbuffer::getAccess (void)
+{
+	return PixelBufferAccess(m_format, m_width, m_height, 1, m_data.getWritablePtr());
+}
+
+tcu::ConstPixelBufferAccess Renderbuffer::getAccess (void) const
 {
-	m_data.setStorage(format, width, height);
+	return ConstPixelBufferAccess(m_format, m_width, m_height, 1, m_data.getPtr());
 }
 
 Framebuffer::Framebuffer (deUint32 name)
@@ -39,6 +39,7 @@
 
 #include <map>
 #include <vector>
+#include <string>
 
 namespace sglr
 {
@@ -111,6 +112,44 @@ private:
 	int							m_maxLevel;
 };
 
+/*--------------------------------------------------------------------*//*!
+ * \brief Copy-on-write image data storage.
+ *
+ * Copies share the same reference-counted buffer. getWritablePtr() makes
+ * a private copy of the data first if the buffer is shared, so writing
+ * through one copy never changes the others.
+ *//*--------------------------------------------------------------------*/
+class LevelStorage
+{
+public:
+								LevelStorage		(void);
+								LevelStorage		(const LevelStorage& other);
+								~LevelStorage		(void);
+
+	LevelStorage&				operator=			(const LevelStorage& other);
+
+	void						setStorage			(size_t size); //!< \note Contents are undefined after call
+	void						clear				(void);
+
+	bool						empty				(void) const	{ return !m_buffer;								}
+	bool						isShared			(void) const	{ return m_buffer && m_buffer->refCount > 1;	}
+	size_t						size				(void) const	{ return m_buffer ? m_buffer->data.size() : 0;	}
+
+	const void*					getPtr				(void) const	{ return m_buffer ? m_buffer->data.getPtr() : DE_NULL;	}
+	void*						getWritablePtr		(void);
+
+private:
+	struct Buffer
+	{
+		de::ArrayBuffer<deUint8>	data;
+		int							refCount;
+	};
+
+	void						release				(void);
+
+	Buffer*						m_buffer;
+};
+
 //! Class for managing list of texture levels.
 class TextureLevelArray
 {
@@ -119,13 +158,14 @@ public:
 										~TextureLevelArray	(void);
 
 	bool								hasLevel			(int level) const	{ return deInBounds32(level, 0, DE_LENGTH_OF_ARRAY(m_data)) && !m_data[level].empty();	}
-	const tcu::PixelBufferAccess&		getLevel			(int level)			{ DE_ASSERT(hasLevel(level)); return m_access[level];									}
+	const tcu::PixelBufferAccess&		getLevel			(int level);		//!< Detaches level from shared storage
 	const tcu::ConstPixelBufferAccess&	getLevel			(int level) const	{ DE_ASSERT(hasLevel(level)); return m_access[level];									}
 
 	const tcu::ConstPixelBufferAccess*	getLevels			(void) const		{ return &m_access[0];																	}
 	const tcu::ConstPixelBufferAccess*	getEffectiveLevels	(void) const		{ return &m_effectiveAccess[0];															}
 
-	void								allocLevel			(int level, const tcu::TextureFormat& format, int width, int height, int depth);
+	//! Allocate level, shares data with sharedData if given. Otherwise contents are undefined.
+	void								allocLevel			(int level, const tcu::TextureFormat& format, int width, int height, int depth, const LevelStorage* sharedData = DE_NULL);
 	void								clearLevel			(int level);
 
 	void								clear				(void);
@@ -133,7 +173,7 @@ public:
 	void								updateSamplerMode	(tcu::Sampler::DepthStencilMode);
 
 private:
-	de::ArrayBuffer<deUint8>			m_data[MAX_TEXTURE_SIZE_LOG2];
+	LevelStorage						m_data[MAX_TEXTURE_SIZE_LOG2];
 	tcu::PixelBufferAccess				m_access[MAX_TEXTURE_SIZE_LOG2];
 	tcu::ConstPixelBufferAccess			m_effectiveAccess[MAX_TEXTURE_SIZE_LOG2];	//!< the currently effective sampling mode. For Depth-stencil texture always either Depth or stencil.
 };
@@ -150,7 +190,7 @@ public:
 	const tcu::ConstPixelBufferAccess&	getLevel		(int level) const	{ return m_levels.getLevel(level);	}
 	const tcu::PixelBufferAccess&		getLevel		(int level)			{ return m_levels.getLevel(level);	}
 
-	void								allocLevel		(int level, const tcu::TextureFormat& format, int width);
+	void								allocLevel		(int level, const tcu::TextureFormat& format, int width, const LevelStorage* sharedData = DE_NULL);
 
 	bool								isComplete		(void) const;
 
@@ -176,7 +216,7 @@ public:
 	const tcu::ConstPixelBufferAccess&	getLevel		(int level) const	{ return m_levels.getLevel(level);	}
 	const tcu::PixelBufferAccess&		getLevel		(int level)			{ return m_levels.getLevel(level);	}
 
-	void								allocLevel		(int level, const tcu::TextureFormat& format, int width, int height);
+	void								allocLevel		(int level, const tcu::TextureFormat& format, int width, int height, const LevelStorage* sharedData = DE_NULL);
 
 	bool								isComplete		(void) const;
 
@@ -202,7 +242,7 @@ public:
 	const tcu::PixelBufferAccess&		getFace			(int level, tcu::CubeFace face)			{ return m_levels[face].getLevel(level);	}
 	const tcu::ConstPixelBufferAccess&	getFace			(int level, tcu::CubeFace face) const	{ return m_levels[face].getLevel(level);	}
 
-	void								allocFace		(int level, tcu::CubeFace face, const tcu::TextureFormat& format, int width, int height);
+	void								allocFace		(int level, tcu::CubeFace face, const tcu::TextureFormat& format, int width, int height, const LevelStorage* sharedData = DE_NULL);
 
 	bool								isComplete		(void) const;
 	void								updateView		(tcu::Sampler::DepthStencilMode mode); // \note View must be refreshed after texture parameter/size changes, before calling sample*()
@@ -227,7 +267,7 @@ public:
 	const tcu::ConstPixelBufferAccess&	getLevel		(int level) const	{ return m_levels.getLevel(level);	}
 	const tcu::PixelBufferAccess&		getLevel		(int level)			{ return m_levels.getLevel(level);	}
 
-	void								allocLevel		(int level, const tcu::TextureFormat& format, int width, int height, int numLayers);
+	void								allocLevel		(int level, const tcu::TextureFormat& format, int width, int height, int numLayers, const LevelStorage* sharedData = DE_NULL);
 
 	bool								isComplete		(void) const;
 
@@ -253,7 +293,7 @@ public:
 	const tcu::ConstPixelBufferAccess&	getLevel		(int level) const	{ return m_levels.getLevel(level);	}
 	const tcu::PixelBufferAccess&		getLevel		(int level)			{ return m_levels.getLevel(level);	}
 
-	void								allocLevel		(int level, const tcu::TextureFormat& format, int width, int height, int numLayers);
+	void								allocLevel		(int level, const tcu::TextureFormat& format, int width, int height, int numLayers, const LevelStorage* sharedData = DE_NULL);
 
 	bool								isComplete		(void) const;
 
@@ -279,7 +319,7 @@ public:
 	const tcu::ConstPixelBufferAccess&	getLevel			(int level) const	{ return m_levels.getLevel(level);	}
 	const tcu::PixelBufferAccess&		getLevel			(int level)			{ return m_levels.getLevel(level);	}
 
-	void								allocLevel			(int level, const tcu::TextureFormat& format, int width, int height, int numLayers);
+	void								allocLevel			(int level, const tcu::TextureFormat& format, int width, int height, int numLayers, const LevelStorage* sharedData = DE_NULL);
 
 	bool								isComplete			(void) const;
 
@@ -310,17 +350,21 @@ public:
 								Renderbuffer		(deUint32 name);
 	virtual						~Renderbuffer		(void);
 
-	void						setStorage			(const tcu::TextureFormat& format, int width, int height);
+	//! Shares data with sharedData if given. Otherwise contents are undefined.
+	void						setStorage			(const tcu::TextureFormat& format, int width, int height, const LevelStorage* sharedData = DE_NULL);
 
-	int							getWidth			(void) const	{ return m_data.getWidth();		}
-	int							getHeight			(void) const	{ return m_data.getHeight();	}
-	tcu::TextureFormat			getFormat			(void) const	{ return m_data.getFormat();	}
+	int							getWidth			(void) const	{ return m_width;		}
+	int							getHeight			(void) const	{ return m_height;		}
+	tcu::TextureFormat			getFormat			(void) const	{ return m_format;		}
 
-	tcu::PixelBufferAccess		getAccess			(void)			{ return m_data.getAccess();	}
-	tcu::ConstPixelBufferAccess	getAccess			(void) const	{ return m_data.getAccess();	}
+	tcu::PixelBufferAccess		getAccess			(void);			//!< Detaches from shared storage
+	tcu::ConstPixelBufferAccess	getAccess			(void) const;
 
 private:
-	tcu::TextureLevel			m_data;
+	tcu::TextureFormat			m_format;
+	int							m_width;
+	int							m_height;
+	LevelStorage				m_data;
 };
 
 class Framebuffer : public NamedObject
@@ -449,6 +493,12 @@ public:
 
 	ShaderProgram*					m_program;
 	bool							m_deleteFlag;
+
+	// Linked state, program declaration can not change after creation
+	const rr::Program				m_linkedProgram;
+	std::map<std::string, int>		m_attribLocations;
+	std::map<std::string, int>		m_uniformLocations;
+	std::vector<int>				m_samplerUniforms;	//!< Locations of sampler uniforms
 };
 
 template <typename T>
@@ -782,6 +832,7 @@ private:
 	void					acquireFboAttachmentReference	(const rc::Framebuffer::Attachment& attachment);
 	void					releaseFboAttachmentReference	(const rc::Framebuffer::Attachment& attachment);
 	tcu::PixelBufferAccess	getFboAttachment		(const rc::Framebuffer& framebuffer, rc::Framebuffer::AttachmentPoint point);
+	const rc::LevelStorage&	getInitialLevelData		(const tcu::TextureFormat& format, int numPixels);
 
 	deUint32				blitResolveMultisampleFramebuffer (deUint32 mask, const tcu::IVec4& srcRect, const tcu::IVec4& dstRect, bool flipX, bool flipY);
 
@@ -892,6 +943,9 @@ private:
 	rc::Texture3D								m_emptyTex3D;
 	rc::TextureCubeArray						m_emptyTexCubeArray;
 
+	typedef std::pair<deUint32, int>			InitialLevelDataKey;		//!< (format order<<16 | type, pixel count)
+	std::map<InitialLevelDataKey, rc::LevelStorage>	m_initialLevelData;	//!< Cleared storage shared by levels specified without data.
+
 	int											m_pixelUnpackRowLength;
 	int											m_pixelUnpackSkipRows;
 	int											m_pixelUnpackSkipPixels;
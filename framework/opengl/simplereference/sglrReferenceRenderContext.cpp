@@ -0,0 +1,557 @@
+/*-------------------------------------------------------------------------
+ * drawElements Quality Program OpenGL ES Utilities
+ * ------------------------------------------------
+ *
+ * Copyright 2014 The Android Open Source Project
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ *      http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ *
+ *//*!
+ * \file
+ * \brief glu::RenderContext that renders with ReferenceContext.
+ *//*--------------------------------------------------------------------*/
+
+#include "sglrReferenceRenderContext.hpp"
+#include "tcuRenderTarget.hpp"
+#include "deThreadLocal.hpp"
+#include "glwEnums.hpp"
+
+namespace sglr
+{
+
+using namespace glw;
+
+namespace
+{
+
+de::ThreadLocal s_currentCtx;
+
+inline const ReferenceRenderContext& getCurrent (void)
+{
+	const ReferenceRenderContext* const ctx = (const ReferenceRenderContext*)s_currentCtx.get();
+	DE_ASSERT(ctx);
+	return *ctx;
+}
+
+inline ReferenceContext& getRef (void)
+{
+	return getCurrent().getReferenceContext();
+}
+
+// Entry points dispatched to ReferenceContext
+
+GLW_APICALL void GLW_APIENTRY refActiveTexture (GLenum texture)																	{ getRef().activeTexture(texture);									}
+GLW_APICALL void GLW_APIENTRY refViewport (GLint x, GLint y, GLsizei width, GLsizei height)										{ getRef().viewport(x, y, width, height);							}
+
+GLW_APICALL void GLW_APIENTRY refBindTexture (GLenum target, GLuint texture)													{ getRef().bindTexture(target, texture);							}
+GLW_APICALL void GLW_APIENTRY refGenTextures (GLsizei n, GLuint* textures)														{ getRef().genTextures(n, textures);								}
+GLW_APICALL void GLW_APIENTRY refDeleteTextures (GLsizei n, const GLuint* textures)												{ getRef().deleteTextures(n, textures);								}
+
+GLW_APICALL void GLW_APIENTRY refBindFramebuffer (GLenum target, GLuint framebuffer)											{ getRef().bindFramebuffer(target, framebuffer);					}
+GLW_APICALL void GLW_APIENTRY refGenFramebuffers (GLsizei n, GLuint* framebuffers)												{ getRef().genFramebuffers(n, framebuffers);						}
+GLW_APICALL void GLW_APIENTRY refDeleteFramebuffers (GLsizei n, const GLuint* framebuffers)										{ getRef().deleteFramebuffers(n, framebuffers);						}
+
+GLW_APICALL void GLW_APIENTRY refBindRenderbuffer (GLenum target, GLuint renderbuffer)											{ getRef().bindRenderbuffer(target, renderbuffer);					}
+GLW_APICALL void GLW_APIENTRY refGenRenderbuffers (GLsizei n, GLuint* renderbuffers)											{ getRef().genRenderbuffers(n, renderbuffers);						}
+GLW_APICALL void GLW_APIENTRY refDeleteRenderbuffers (GLsizei n, const GLuint* renderbuffers)									{ getRef().deleteRenderbuffers(n, renderbuffers);					}
+
+GLW_APICALL void GLW_APIENTRY refPixelStorei (GLenum pname, GLint param)														{ getRef().pixelStorei(pname, param);								}
+
+// \note ReferenceContext can't represent zero-sized levels. Those are only used for releasing
+//		 level storage (glu::resetState() does that for default textures) and are ignored.
+
+GLW_APICALL void GLW_APIENTRY refTexImage2D (GLenum target, GLint level, GLint internalformat, GLsizei width, GLsizei height, GLint border, GLenum format, GLenum type, const void* pixels)
+{
+	if (width == 0 || height == 0)
+		return;
+
+	getRef().texImage2D(target, level, (deUint32)internalformat, width, height, border, format, type, pixels);
+}
+
+GLW_APICALL void GLW_APIENTRY refTexImage3D (GLenum target, GLint level, GLint internalformat, GLsizei width, GLsizei height, GLsizei depth, GLint border, GLenum format, GLenum type, const void* pixels)
+{
+	if (width == 0 || height == 0 || depth == 0)
+		return;
+
+	getRef().texImage3D(target, level, (deUint32)internalformat, width, height, depth, border, format, type, pixels);
+}
+
+GLW_APICALL void GLW_APIENTRY refTexSubImage2D (GLenum target, GLint level, GLint xoffset, GLint yoffset, GLsizei width, GLsizei height, GLenum format, GLenum type, const void* pixels)
+{
+	getRef().texSubImage2D(target, level, xoffset, yoffset, width, height, format, type, pixels);
+}
+
+GLW_APICALL void GLW_APIENTRY refTexSubImage3D (GLenum target, GLint level, GLint xoffset, GLint yoffset, GLint zoffset, GLsizei width, GLsizei height, GLsizei depth, GLenum format, GLenum type, const void* pixels)
+{
+	getRef().texSubImage3D(target, level, xoffset, yoffset, zoffset, width, height, depth, format, type, pixels);
+}
+
+GLW_APICALL void GLW_APIENTRY refCopyTexImage2D (GLenum target, GLint level, GLenum internalformat, GLint x, GLint y, GLsizei width, GLsizei height, GLint border)
+{
+	getRef().copyTexImage2D(target, level, internalformat, x, y, width, height, border);
+}
+
+GLW_APICALL void GLW_APIENTRY refCopyTexSubImage2D (GLenum target, GLint level, GLint xoffset, GLint yoffset, GLint x, GLint y, GLsizei width, GLsizei height)
+{
+	getRef().copyTexSubImage2D(target, level, xoffset, yoffset, x, y, width, height);
+}
+
+GLW_APICALL void GLW_APIENTRY refCopyTexSubImage3D (GLenum target, GLint level, GLint xoffset, GLint yoffset, GLint zoffset, GLint x, GLint y, GLsizei width, GLsizei height)
+{
+	getRef().copyTexSubImage3D(target, level, xoffset, yoffset, zoffset, x, y, width, height);
+}
+
+GLW_APICALL void GLW_APIENTRY refTexStorage2D (GLenum target, GLsizei levels, GLenum internalformat, GLsizei width, GLsizei height)
+{
+	getRef().texStorage2D(target, levels, internalformat, width, height);
+}
+
+GLW_APICALL void GLW_APIENTRY refTexStorage3D (GLenum target, GLsizei levels, GLenum internalformat, GLsizei width, GLsizei height, GLsizei depth)
+{
+	getRef().texStorage3D(target, levels, internalformat, width, height, depth);
+}
+
+GLW_APICALL void GLW_APIENTRY refTexParameteri (GLenum target, GLenum pname, GLint param)										{ getRef().texParameteri(target, pname, param);						}
+
+GLW_APICALL void GLW_APIENTRY refFramebufferTexture2D (GLenum target, GLenum attachment, GLenum textarget, GLuint texture, GLint level)
+{
+	getRef().framebufferTexture2D(target, attachment, textarget, texture, level);
+}
+
+GLW_APICALL void GLW_APIENTRY refFramebufferTextureLayer (GLenum target, GLenum attachment, GLuint texture, GLint level, GLint layer)
+{
+	getRef().framebufferTextureLayer(target, attachment, texture, level, layer);
+}
+
+GLW_APICALL void GLW_APIENTRY refFramebufferRenderbuffer (GLenum target, GLenum attachment, GLenum renderbuffertarget, GLuint renderbuffer)
+{
+	getRef().framebufferRenderbuffer(target, attachment, renderbuffertarget, renderbuffer);
+}
+
+GLW_APICALL GLenum GLW_APIENTRY refCheckFramebufferStatus (GLenum target)														{ return getRef().checkFramebufferStatus(target);					}
+
+GLW_APICALL void GLW_APIENTRY refGetFramebufferAttachmentParameteriv (GLenum target, GLenum attachment, GLenum pname, GLint* params)
+{
+	getRef().getFramebufferAttachmentParameteriv(target, attachment, pname, params);
+}
+
+GLW_APICALL void GLW_APIENTRY refRenderbufferStorage (GLenum target, GLenum internalformat, GLsizei width, GLsizei height)
+{
+	getRef().renderbufferStorage(target, internalformat, width, height);
+}
+
+GLW_APICALL void GLW_APIENTRY refRenderbufferStorageMultisample (GLenum target, GLsizei samples, GLenum internalformat, GLsizei width, GLsizei height)
+{
+	getRef().renderbufferStorageMultisample(target, samples, internalformat, width, height);
+}
+
+GLW_APICALL void GLW_APIENTRY refBindBuffer (GLenum target, GLuint buffer)														{ getRef().bindBuffer(target, buffer);								}
+GLW_APICALL void GLW_APIENTRY refGenBuffers (GLsizei n, GLuint* buffers)														{ getRef().genBuffers(n, buffers);									}
+GLW_APICALL void GLW_APIENTRY refDeleteBuffers (GLsizei n, const GLuint* buffers)												{ getRef().deleteBuffers(n, buffers);								}
+GLW_APICALL void GLW_APIENTRY refBufferData (GLenum target, GLsizeiptr size, const void* data, GLenum usage)					{ getRef().bufferData(target, (deIntptr)size, data, usage);			}
+GLW_APICALL void GLW_APIENTRY refBufferSubData (GLenum target, GLintptr offset, GLsizeiptr size, const void* data)				{ getRef().bufferSubData(target, (deIntptr)offset, (deIntptr)size, data);	}
+
+GLW_APICALL void GLW_APIENTRY refClearColor (GLfloat red, GLfloat green, GLfloat blue, GLfloat alpha)							{ getRef().clearColor(red, green, blue, alpha);						}
+GLW_APICALL void GLW_APIENTRY refClearDepthf (GLfloat d)																		{ getRef().clearDepthf(d);											}
+GLW_APICALL void GLW_APIENTRY refClearStencil (GLint s)																			{ getRef().clearStencil(s);											}
+GLW_APICALL void GLW_APIENTRY refClear (GLbitfield mask)																		{ getRef().clear(mask);												}
+GLW_APICALL void GLW_APIENTRY refClearBufferiv (GLenum buffer, GLint drawbuffer, const GLint* value)							{ getRef().clearBufferiv(buffer, drawbuffer, value);				}
+GLW_APICALL void GLW_APIENTRY refClearBufferfv (GLenum buffer, GLint drawbuffer, const GLfloat* value)							{ getRef().clearBufferfv(buffer, drawbuffer, value);				}
+GLW_APICALL void GLW_APIENTRY refClearBufferuiv (GLenum buffer, GLint drawbuffer, const GLuint* value)							{ getRef().clearBufferuiv(buffer, drawbuffer, value);				}
+GLW_APICALL void GLW_APIENTRY refClearBufferfi (GLenum buffer, GLint drawbuffer, GLfloat depth, GLint stencil)					{ getRef().clearBufferfi(buffer, drawbuffer, depth, stencil);		}
+GLW_APICALL void GLW_APIENTRY refScissor (GLint x, GLint y, GLsizei width, GLsizei height)										{ getRef().scissor(x, y, width, height);							}
+
+// Capabilities that ReferenceContext doesn't implement (culling, rasterizer discard, ...) are ignored by fallback context.
+
+bool isReferenceCap (GLenum cap)
+{
+	switch (cap)
+	{
+		case GL_BLEND:
+		case GL_SCISSOR_TEST:
+		case GL_DEPTH_TEST:
+		case GL_STENCIL_TEST:
+		case GL_POLYGON_OFFSET_FILL:
+		case GL_FRAMEBUFFER_SRGB:
+		case GL_DEPTH_CLAMP:
+		case GL_DITHER:
+		case GL_PRIMITIVE_RESTART_FIXED_INDEX:
+		case GL_PRIMITIVE_RESTART:
+			return true;
+
+		default:
+			return false;
+	}
+}
+
+GLW_APICALL void GLW_APIENTRY refEnable (GLenum cap)
+{
+	if (isReferenceCap(cap))
+		getRef().enable(cap);
+	else
+		getCurrent().getFallbackFunctions().enable(cap);
+}
+
+GLW_APICALL void GLW_APIENTRY refDisable (GLenum cap)
+{
+	if (isReferenceCap(cap))
+		getRef().disable(cap);
+	else
+		getCurrent().getFallbackFunctions().disable(cap);
+}
+
+GLW_APICALL void GLW_APIENTRY refStencilFunc (GLenum func, GLint ref, GLuint mask)												{ getRef().stencilFunc(func, ref, mask);							}
+GLW_APICALL void GLW_APIENTRY refStencilOp (GLenum fail, GLenum zfail, GLenum zpass)											{ getRef().stencilOp(fail, zfail, zpass);							}
+GLW_APICALL void GLW_APIENTRY refStencilFuncSeparate (GLenum face, GLenum func, GLint ref, GLuint mask)							{ getRef().stencilFuncSeparate(face, func, ref, mask);				}
+GLW_APICALL void GLW_APIENTRY refStencilOpSeparate (GLenum face, GLenum sfail, GLenum dpfail, GLenum dppass)					{ getRef().stencilOpSeparate(face, sfail, dpfail, dppass);			}
+
+GLW_APICALL void GLW_APIENTRY refDepthFunc (GLenum func)																		{ getRef().depthFunc(func);											}
+GLW_APICALL void GLW_APIENTRY refDepthRangef (GLfloat n, GLfloat f)																{ getRef().depthRangef(n, f);										}
+GLW_APICALL void GLW_APIENTRY refPolygonOffset (GLfloat factor, GLfloat units)													{ getRef().polygonOffset(factor, units);							}
+
+GLW_APICALL void GLW_APIENTRY refBlendEquation (GLenum mode)																	{ getRef().blendEquation(mode);										}
+GLW_APICALL void GLW_APIENTRY refBlendEquationSeparate (GLenum modeRGB, GLenum modeAlpha)										{ getRef().blendEquationSeparate(modeRGB, modeAlpha);				}
+GLW_APICALL void GLW_APIENTRY refBlendFunc (GLenum sfactor, GLenum dfactor)														{ getRef().blendFunc(sfactor, dfactor);								}
+GLW_APICALL void GLW_APIENTRY refBlendFuncSeparate (GLenum srcRGB, GLenum dstRGB, GLenum srcAlpha, GLenum dstAlpha)				{ getRef().blendFuncSeparate(srcRGB, dstRGB, srcAlpha, dstAlpha);	}
+GLW_APICALL void GLW_APIENTRY refBlendColor (GLfloat red, GLfloat green, GLfloat blue, GLfloat alpha)							{ getRef().blendColor(red, green, blue, alpha);						}
+
+GLW_APICALL void GLW_APIENTRY refColorMask (GLboolean red, GLboolean green, GLboolean blue, GLboolean alpha)					{ getRef().colorMask(red, green, blue, alpha);						}
+GLW_APICALL void GLW_APIENTRY refDepthMask (GLboolean flag)																		{ getRef().depthMask(flag);											}
+GLW_APICALL void GLW_APIENTRY refStencilMask (GLuint mask)																		{ getRef().stencilMask(mask);										}
+GLW_APICALL void GLW_APIENTRY refStencilMaskSeparate (GLenum face, GLuint mask)													{ getRef().stencilMaskSeparate(face, mask);							}
+
+GLW_APICALL void GLW_APIENTRY refBlitFramebuffer (GLint srcX0, GLint srcY0, GLint srcX1, GLint srcY1, GLint dstX0, GLint dstY0, GLint dstX1, GLint dstY1, GLbitfield mask, GLenum filter)
+{
+	getRef().blitFramebuffer(srcX0, srcY0, srcX1, srcY1, dstX0, dstY0, dstX1, dstY1, mask, filter);
+}
+
+GLW_APICALL void GLW_APIENTRY refInvalidateSubFramebuffer (GLenum target, GLsizei numAttachments, const GLenum* attachments, GLint x, GLint y, GLsizei width, GLsizei height)
+{
+	getRef().invalidateSubFramebuffer(target, numAttachments, attachments, x, y, width, height);
+}
+
+GLW_APICALL void GLW_APIENTRY refInvalidateFramebuffer (GLenum target, GLsizei numAttachments, const GLenum* attachments)
+{
+	getRef().invalidateFramebuffer(target, numAttachments, attachments);
+}
+
+GLW_APICALL void GLW_APIENTRY refBindVertexArray (GLuint array)																	{ getRef().bindVertexArray(array);									}
+GLW_APICALL void GLW_APIENTRY refGenVertexArrays (GLsizei n, GLuint* arrays)													{ getRef().genVertexArrays(n, arrays);								}
+GLW_APICALL void GLW_APIENTRY refDeleteVertexArrays (GLsizei n, const GLuint* arrays)											{ getRef().deleteVertexArrays(n, arrays);							}
+
+GLW_APICALL void GLW_APIENTRY refVertexAttribPointer (GLuint index, GLint size, GLenum type, GLboolean normalized, GLsizei stride, const void* pointer)
+{
+	getRef().vertexAttribPointer(index, size, type, normalized, stride, pointer);
+}
+
+GLW_APICALL void GLW_APIENTRY refVertexAttribIPointer (GLuint index, GLint size, GLenum type, GLsizei stride, const void* pointer)
+{
+	getRef().vertexAttribIPointer(index, size, type, stride, pointer);
+}
+
+GLW_APICALL void GLW_APIENTRY refEnableVertexAttribArray (GLuint index)															{ getRef().enableVertexAttribArray(index);							}
+GLW_APICALL void GLW_APIENTRY refDisableVertexAttribArray (GLuint index)														{ getRef().disableVertexAttribArray(index);							}
+GLW_APICALL void GLW_APIENTRY refVertexAttribDivisor (GLuint index, GLuint divisor)												{ getRef().vertexAttribDivisor(index, divisor);						}
+
+GLW_APICALL void GLW_APIENTRY refVertexAttrib1f (GLuint index, GLfloat x)														{ getRef().vertexAttrib1f(index, x);								}
+GLW_APICALL void GLW_APIENTRY refVertexAttrib2f (GLuint index, GLfloat x, GLfloat y)											{ getRef().vertexAttrib2f(index, x, y);								}
+GLW_APICALL void GLW_APIENTRY refVertexAttrib3f (GLuint index, GLfloat x, GLfloat y, GLfloat z)									{ getRef().vertexAttrib3f(index, x, y, z);							}
+GLW_APICALL void GLW_APIENTRY refVertexAttrib4f (GLuint index, GLfloat x, GLfloat y, GLfloat z, GLfloat w)						{ getRef().vertexAttrib4f(index, x, y, z, w);						}
+GLW_APICALL void GLW_APIENTRY refVertexAttribI4i (GLuint index, GLint x, GLint y, GLint z, GLint w)								{ getRef().vertexAttribI4i(index, x, y, z, w);						}
+GLW_APICALL void GLW_APIENTRY refVertexAttribI4ui (GLuint index, GLuint x, GLuint y, GLuint z, GLuint w)						{ getRef().vertexAttribI4ui(index, x, y, z, w);						}
+
+GLW_APICALL GLint GLW_APIENTRY refGetAttribLocation (GLuint program, const GLchar* name)										{ return getRef().getAttribLocation(program, name);					}
+GLW_APICALL GLint GLW_APIENTRY refGetUniformLocation (GLuint program, const GLchar* name)										{ return getRef().getUniformLocation(program, name);				}
+
+GLW_APICALL void GLW_APIENTRY refUniform1f (GLint location, GLfloat v0)															{ getRef().uniform1f(location, v0);									}
+GLW_APICALL void GLW_APIENTRY refUniform1i (GLint location, GLint v0)															{ getRef().uniform1i(location, v0);									}
+GLW_APICALL void GLW_APIENTRY refUniform1fv (GLint location, GLsizei count, const GLfloat* value)								{ getRef().uniform1fv(location, count, value);						}
+GLW_APICALL void GLW_APIENTRY refUniform2fv (GLint location, GLsizei count, const GLfloat* value)								{ getRef().uniform2fv(location, count, value);						}
+GLW_APICALL void GLW_APIENTRY refUniform3fv (GLint location, GLsizei count, const GLfloat* value)								{ getRef().uniform3fv(location, count, value);						}
+GLW_APICALL void GLW_APIENTRY refUniform4fv (GLint location, GLsizei count, const GLfloat* value)								{ getRef().uniform4fv(location, count, value);						}
+GLW_APICALL void GLW_APIENTRY refUniform1iv (GLint location, GLsizei count, const GLint* value)									{ getRef().uniform1iv(location, count, value);						}
+GLW_APICALL void GLW_APIENTRY refUniform2iv (GLint location, GLsizei count, const GLint* value)									{ getRef().uniform2iv(location, count, value);						}
+GLW_APICALL void GLW_APIENTRY refUniform3iv (GLint location, GLsizei count, const GLint* value)									{ getRef().uniform3iv(location, count, value);						}
+GLW_APICALL void GLW_APIENTRY refUniform4iv (GLint location, GLsizei count, const GLint* value)									{ getRef().uniform4iv(location, count, value);						}
+GLW_APICALL void GLW_APIENTRY refUniformMatrix3fv (GLint location, GLsizei count, GLboolean transpose, const GLfloat* value)	{ getRef().uniformMatrix3fv(location, count, transpose, value);		}
+GLW_APICALL void GLW_APIENTRY refUniformMatrix4fv (GLint location, GLsizei count, GLboolean transpose, const GLfloat* value)	{ getRef().uniformMatrix4fv(location, count, transpose, value);		}
+
+GLW_APICALL void GLW_APIENTRY refLineWidth (GLfloat width)																		{ getRef().lineWidth(width);										}
+
+GLW_APICALL void GLW_APIENTRY refDrawArrays (GLenum mode, GLint first, GLsizei count)											{ getRef().drawArrays(mode, first, count);							}
+
+GLW_APICALL void GLW_APIENTRY refDrawArraysInstanced (GLenum mode, GLint first, GLsizei count, GLsizei instancecount)
+{
+	getRef().drawArraysInstanced(mode, first, count, instancecount);
+}
+
+GLW_APICALL void GLW_APIENTRY refDrawElements (GLenum mode, GLsizei count, GLenum type, const void* indices)
+{
+	getRef().drawElements(mode, count, type, indices);
+}
+
+GLW_APICALL void GLW_APIENTRY refDrawElementsInstanced (GLenum mode, GLsizei count, GLenum type, const void* indices, GLsizei instancecount)
+{
+	getRef().drawElementsInstanced(mode, count, type, indices, instancecount);
+}
+
+GLW_APICALL void GLW_APIENTRY refDrawElementsBaseVertex (GLenum mode, GLsizei count, GLenum type, const void* indices, GLint basevertex)
+{
+	getRef().drawElementsBaseVertex(mode, count, type, indices, basevertex);
+}
+
+GLW_APICALL void GLW_APIENTRY refDrawElementsInstancedBaseVertex (GLenum mode, GLsizei count, GLenum type, const void* indices, GLsizei instancecount, GLint basevertex)
+{
+	getRef().drawElementsInstancedBaseVertex(mode, count, type, indices, instancecount, basevertex);
+}
+
+GLW_APICALL void GLW_APIENTRY refDrawRangeElements (GLenum mode, GLuint start, GLuint end, GLsizei count, GLenum type, const void* indices)
+{
+	getRef().drawRangeElements(mode, start, end, count, type, indices);
+}
+
+GLW_APICALL void GLW_APIENTRY refDrawRangeElementsBaseVertex (GLenum mode, GLuint start, GLuint end, GLsizei count, GLenum type, const void* indices, GLint basevertex)
+{
+	getRef().drawRangeElementsBaseVertex(mode, start, end, count, type, indices, basevertex);
+}
+
+GLW_APICALL void GLW_APIENTRY refDrawArraysIndirect (GLenum mode, const void* indirect)											{ getRef().drawArraysIndirect(mode, indirect);						}
+GLW_APICALL void GLW_APIENTRY refDrawElementsIndirect (GLenum mode, GLenum type, const void* indirect)							{ getRef().drawElementsIndirect(mode, type, indirect);				}
+
+GLW_APICALL void GLW_APIENTRY refUseProgram (GLuint program)																	{ getRef().useProgram(program);										}
+
+GLW_APICALL void GLW_APIENTRY refReadPixels (GLint x, GLint y, GLsizei width, GLsizei height, GLenum format, GLenum type, void* pixels)
+{
+	getRef().readPixels(x, y, width, height, format, type, pixels);
+}
+
+GLW_APICALL GLenum GLW_APIENTRY refGetError (void)																				{ return getRef().getError();										}
+GLW_APICALL void GLW_APIENTRY refFinish (void)																					{ getRef().finish();												}
+
+// Queries answered from ReferenceContext limits, rest go to fallback context
+
+GLW_APICALL void GLW_APIENTRY refGetIntegerv (GLenum pname, GLint* params)
+{
+	const ReferenceRenderContext& ctx = getCurrent();
+
+	switch (pname)
+	{
+		case GL_MAX_TEXTURE_SIZE:
+		case GL_MAX_CUBE_MAP_TEXTURE_SIZE:
+		case GL_MAX_ARRAY_TEXTURE_LAYERS:
+		case GL_MAX_3D_TEXTURE_SIZE:
+		case GL_MAX_RENDERBUFFER_SIZE:
+		case GL_MAX_TEXTURE_IMAGE_UNITS:
+		case GL_MAX_VERTEX_ATTRIBS:
+			ctx.getReferenceContext().getIntegerv(pname, params);
+			break;
+
+		case GL_NUM_EXTENSIONS:
+			*params = (GLint)ctx.getLimits().extensionList.size();
+			break;
+
+		default:
+			ctx.getFallbackFunctions().getIntegerv(pname, params);
+			break;
+	}
+}
+
+GLW_APICALL const GLubyte* GLW_APIENTRY refGetString (GLenum name)
+{
+	const ReferenceRenderContext& ctx = getCurrent();
+
+	if (name == GL_EXTENSIONS)
+		return (const GLubyte*)ctx.getLimits().extensionStr.c_str();
+	else
+		return ctx.getFallbackFunctions().getString(name);
+}
+
+GLW_APICALL const GLubyte* GLW_APIENTRY refGetStringi (GLenum name, GLuint index)
+{
+	const ReferenceRenderContext& ctx = getCurrent();
+
+	if (name == GL_EXTENSIONS)
+	{
+		if (index < (GLuint)ctx.getLimits().extensionList.size())
+			return (const GLubyte*)ctx.getLimits().extensionList[index].c_str();
+		else
+			return DE_NULL;
+	}
+	else
+		return ctx.getFallbackFunctions().getStringi(name, index);
+}
+
+// GLSL is not supported, so every shader fails to compile and every program fails to link.
+
+GLW_APICALL void GLW_APIENTRY refGetShaderiv (GLuint shader, GLenum pname, GLint* params)
+{
+	if (pname == GL_COMPILE_STATUS)
+		*params = GL_FALSE;
+	else
+		getCurrent().getFallbackFunctions().getShaderiv(shader, pname, params);
+}
+
+GLW_APICALL void GLW_APIENTRY refGetProgramiv (GLuint program, GLenum pname, GLint* params)
+{
+	if (pname == GL_LINK_STATUS)
+		*params = GL_FALSE;
+	else
+		getCurrent().getFallbackFunctions().getProgramiv(program, pname, params);
+}
+
+void initFunctions (glw::Functions* gl)
+{
+	gl->activeTexture							= refActiveTexture;
+	gl->viewport								= refViewport;
+	gl->bindTexture								= refBindTexture;
+	gl->genTextures								= refGenTextures;
+	gl->deleteTextures							= refDeleteTextures;
+	gl->bindFramebuffer							= refBindFramebuffer;
+	gl->genFramebuffers							= refGenFramebuffers;
+	gl->deleteFramebuffers						= refDeleteFramebuffers;
+	gl->bindRenderbuffer						= refBindRenderbuffer;
+	gl->genRenderbuffers						= refGenRenderbuffers;
+	gl->deleteRenderbuffers						= refDeleteRenderbuffers;
+	gl->pixelStorei								= refPixelStorei;
+	gl->texImage2D								= refTexImage2D;
+	gl->texImage3D								= refTexImage3D;
+	gl->texSubImage2D							= refTexSubImage2D;
+	gl->texSubImage3D							= refTexSubImage3D;
+	gl->copyTexImage2D							= refCopyTexImage2D;
+	gl->copyTexSubImage2D						= refCopyTexSubImage2D;
+	gl->copyTexSubImage3D						= refCopyTexSubImage3D;
+	gl->texStorage2D							= refTexStorage2D;
+	gl->texStorage3D							= refTexStorage3D;
+	gl->texParameteri							= refTexParameteri;
+	gl->framebufferTexture2D					= refFramebufferTexture2D;
+	gl->framebufferTextureLayer					= refFramebufferTextureLayer;
+	gl->framebufferRenderbuffer					= refFramebufferRenderbuffer;
+	gl->checkFramebufferStatus					= refCheckFramebufferStatus;
+	gl->getFramebufferAttachmentParameteriv		= refGetFramebufferAttachmentParameteriv;
+	gl->renderbufferStorage						= refRenderbufferStorage;
+	gl->renderbufferStorageMultisample			= refRenderbufferStorageMultisample;
+	gl->bindBuffer								= refBindBuffer;
+	gl->genBuffers								= refGenBuffers;
+	gl->deleteBuffers							= refDeleteBuffers;
+	gl->bufferData								= refBufferData;
+	gl->bufferSubData							= refBufferSubData;
+	gl->clearColor								= refClearColor;
+	gl->clearDepthf								= refClearDepthf;
+	gl->clearStencil							= refClearStencil;
+	gl->clear									= refClear;
+	gl->clearBufferiv							= refClearBufferiv;
+	gl->clearBufferfv							= refClearBufferfv;
+	gl->clearBufferuiv							= refClearBufferuiv;
+	gl->clearBufferfi							= refClearBufferfi;
+	gl->scissor									= refScissor;
+	gl->enable									= refEnable;
+	gl->disable									= refDisable;
+	gl->stencilFunc								= refStencilFunc;
+	gl->stencilOp								= refStencilOp;
+	gl->stencilFuncSeparate						= refStencilFuncSeparate;
+	gl->stencilOpSeparate						= refStencilOpSeparate;
+	gl->depthFunc								= refDepthFunc;
+	gl->depthRangef								= refDepthRangef;
+	gl->polygonOffset							= refPolygonOffset;
+	gl->blendEquation							= refBlendEquation;
+	gl->blendEquationSeparate					= refBlendEquationSeparate;
+	gl->blendFunc								= refBlendFunc;
+	gl->blendFuncSeparate						= refBlendFuncSeparate;
+	gl->blendColor								= refBlendColor;
+	gl->colorMask								= refColorMask;
+	gl->depthMask								= refDepthMask;
+	gl->stencilMask								= refStencilMask;
+	gl->stencilMaskSeparate						= refStencilMaskSeparate;
+	gl->blitFramebuffer							= refBlitFramebuffer;
+	gl->invalidateSubFramebuffer				= refInvalidateSubFramebuffer;
+	gl->invalidateFramebuffer					= refInvalidateFramebuffer;
+	gl->bindVertexArray							= refBindVertexArray;
+	gl->genVertexArrays							= refGenVertexArrays;
+	gl->deleteVertexArrays						= refDeleteVertexArrays;
+	gl->vertexAttribPointer						= refVertexAttribPointer;
+	gl->vertexAttribIPointer					= refVertexAttribIPointer;
+	gl->enableVertexAttribArray					= refEnableVertexAttribArray;
+	gl->disableVertexAttribArray				= refDisableVertexAttribArray;
+	gl->vertexAttribDivisor						= refVertexAttribDivisor;
+	gl->vertexAttrib1f							= refVertexAttrib1f;
+	gl->vertexAttrib2f							= refVertexAttrib2f;
+	gl->vertexAttrib3f							= refVertexAttrib3f;
+	gl->vertexAttrib4f							= refVertexAttrib4f;
+	gl->vertexAttribI4i							= refVertexAttribI4i;
+	gl->vertexAttribI4ui						= refVertexAttribI4ui;
+	gl->getAttribLocation						= refGetAttribLocation;
+	gl->getUniformLocation						= refGetUniformLocation;
+	gl->uniform1f								= refUniform1f;
+	gl->uniform1i								= refUniform1i;
+	gl->uniform1fv								= refUniform1fv;
+	gl->uniform2fv								= refUniform2fv;
+	gl->uniform3fv								= refUniform3fv;
+	gl->uniform4fv								= refUniform4fv;
+	gl->uniform1iv								= refUniform1iv;
+	gl->uniform2iv								= refUniform2iv;
+	gl->uniform3iv								= refUniform3iv;
+	gl->uniform4iv								= refUniform4iv;
+	gl->uniformMatrix3fv						= refUniformMatrix3fv;
+	gl->uniformMatrix4fv						= refUniformMatrix4fv;
+	gl->lineWidth								= refLineWidth;
+	gl->drawArrays								= refDrawArrays;
+	gl->drawArraysInstanced						= refDrawArraysInstanced;
+	gl->drawElements							= refDrawElements;
+	gl->drawElementsInstanced					= refDrawElementsInstanced;
+	gl->drawElementsBaseVertex					= refDrawElementsBaseVertex;
+	gl->drawElementsInstancedBaseVertex			= refDrawElementsInstancedBaseVertex;
+	gl->drawRangeElements						= refDrawRangeElements;
+	gl->drawRangeElementsBaseVertex				= refDrawRangeElementsBaseVertex;
+	gl->drawArraysIndirect						= refDrawArraysIndirect;
+	gl->drawElementsIndirect					= refDrawElementsIndirect;
+	gl->useProgram								= refUseProgram;
+	gl->readPixels								= refReadPixels;
+	gl->getError								= refGetError;
+	gl->finish									= refFinish;
+	gl->getIntegerv								= refGetIntegerv;
+	gl->getString								= refGetString;
+	gl->getStringi								= refGetStringi;
+	gl->getShaderiv								= refGetShaderiv;
+	gl->getProgramiv							= refGetProgramiv;
+}
+
+} // anonymous
+
+ReferenceRenderContext::ReferenceRenderContext (glu::RenderContext* fallbackCtx)
+	: m_fallbackCtx	(fallbackCtx)
+	, m_limits		(*fallbackCtx)
+	, m_buffers		(fallbackCtx->getRenderTarget().getPixelFormat(),
+					 fallbackCtx->getRenderTarget().getDepthBits(),
+					 fallbackCtx->getRenderTarget().getStencilBits(),
+					 fallbackCtx->getRenderTarget().getWidth(),
+					 fallbackCtx->getRenderTarget().getHeight(),
+					 de::max(1, fallbackCtx->getRenderTarget().getNumSamples()))
+	, m_context		(new ReferenceContext(m_limits, m_buffers.getColorbuffer(), m_buffers.getDepthbuffer(), m_buffers.getStencilbuffer()))
+	, m_functions	(fallbackCtx->getFunctions())
+{
+	initFunctions(&m_functions);
+	s_currentCtx.set((void*)this);
+}
+
+ReferenceRenderContext::~ReferenceRenderContext (void)
+{
+	if (s_currentCtx.get() == (void*)this)
+		s_currentCtx.set(DE_NULL);
+}
+
+void ReferenceRenderContext::postIterate (void)
+{
+	m_context->finish();
+}
+
+} // sglr
@@ -0,0 +1,82 @@
+#ifndef _SGLRREFERENCERENDERCONTEXT_HPP
+#define _SGLRREFERENCERENDERCONTEXT_HPP
+/*-------------------------------------------------------------------------
+ * drawElements Quality Program OpenGL ES Utilities
+ * ------------------------------------------------
+ *
+ * Copyright 2014 The Android Open Source Project
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ *      http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ *
+ *//*!
+ * \file
+ * \brief glu::RenderContext that renders with ReferenceContext.
+ *//*--------------------------------------------------------------------*/
+
+#include "tcuDefs.hpp"
+#include "gluRenderContext.hpp"
+#include "glwFunctions.hpp"
+#include "sglrReferenceContext.hpp"
+#include "deUniquePtr.hpp"
+
+namespace sglr
+{
+
+/*--------------------------------------------------------------------*//*!
+ * \brief Render context backed by ReferenceContext.
+ *
+ * GL entry points that have a ReferenceContext equivalent are dispatched
+ * to the reference context, which renders into a software default
+ * framebuffer. Remaining entry points and queries go to the fallback
+ * context, typically a null context that only manages object names.
+ *
+ * GLSL is not supported: shaders never compile and programs never link.
+ * GLContext detects this context and creates programs from the
+ * ShaderProgram C++ implementation instead, so tests rendering through
+ * sglr::Context run end-to-end.
+ *
+ * Function table dispatches to the most recently created context in
+ * the calling thread.
+ *//*--------------------------------------------------------------------*/
+class ReferenceRenderContext : public glu::RenderContext
+{
+public:
+	//! Takes ownership of fallbackCtx. Context type and render target are taken from it.
+	explicit							ReferenceRenderContext	(glu::RenderContext* fallbackCtx);
+	virtual								~ReferenceRenderContext	(void);
+
+	virtual glu::ContextType			getType					(void) const	{ return m_fallbackCtx->getType();			}
+	virtual const glw::Functions&		getFunctions			(void) const	{ return m_functions;						}
+	virtual const tcu::RenderTarget&	getRenderTarget			(void) const	{ return m_fallbackCtx->getRenderTarget();	}
+	virtual deUint32					getDefaultFramebuffer	(void) const	{ return 0;									}
+
+	virtual void						postIterate				(void);
+
+	ReferenceContext&					getReferenceContext		(void) const	{ return *m_context;						}
+	const ReferenceContextLimits&		getLimits				(void) const	{ return m_limits;							}
+	const glw::Functions&				getFallbackFunctions	(void) const	{ return m_fallbackCtx->getFunctions();		}
+
+private:
+										ReferenceRenderContext	(const ReferenceRenderContext&);
+	ReferenceRenderContext&				operator=				(const ReferenceRenderContext&);
+
+	const de::UniquePtr<glu::RenderContext>	m_fallbackCtx;
+	const ReferenceContextLimits			m_limits;
+	ReferenceContextBuffers					m_buffers;
+	const de::UniquePtr<ReferenceContext>	m_context;
+	glw::Functions							m_functions;
+};
+
+} // sglr
+
+#endif // _SGLRREFERENCERENDERCONTEXT_HPP
@@ -30,6 +30,7 @@ namespace pdec
 
 ShaderProgramDeclaration::ShaderProgramDeclaration (void)
 	: m_geometryDecl		(rr::GEOMETRYSHADERINPUTTYPE_LAST, rr::GEOMETRYSHADEROUTPUTTYPE_LAST, 0, 0)
+	, m_fragmentDecl		(FRAGMENTFLAG_NONE)
 	, m_vertexShaderSet		(false)
 	, m_fragmentShaderSet	(false)
 	, m_geometryShaderSet	(false)
@@ -102,6 +103,12 @@ ShaderProgramDeclaration& pdec::ShaderProgramDeclaration::operator<< (const Geom
 	return *this;
 }
 
+ShaderProgramDeclaration& pdec::ShaderProgramDeclaration::operator<< (const FragmentShaderDeclaration& c)
+{
+	m_fragmentDecl = c;
+	return *this;
+}
+
 bool ShaderProgramDeclaration::valid (void) const
 {
 	if (!m_vertexShaderSet || !m_fragmentShaderSet)
@@ -187,6 +194,9 @@ ShaderProgram::ShaderProgram (const pdec::ShaderProgramDeclaration& decl)
 	for (size_t ndx = 0; ndx < decl.m_fragmentOutputs.size(); ++ndx)
 		this->rr::FragmentShader::m_outputs[ndx].type = decl.m_fragmentOutputs[ndx].type;
 
+	this->rr::FragmentShader::m_writesFragmentDepth	= decl.m_fragmentDecl.writesDepth;
+	this->rr::FragmentShader::m_discardsFragments	= decl.m_fragmentDecl.discards;
+
 	// Set up uniforms
 
 	for (size_t ndx = 0; ndx < decl.m_uniforms.size(); ++ndx)
@@ -41,6 +41,7 @@ class TextureCube;
 class Texture2DArray;
 class Texture3D;
 class TextureCubeArray;
+class ShaderProgramObjectContainer;
 } // rc
 
 class ShaderProgram;
@@ -54,6 +55,13 @@ enum VaryingFlags
 	VARYINGFLAG_FLATSHADE	= (1 << 0),
 };
 
+enum FragmentFlags
+{
+	FRAGMENTFLAG_NONE			= 0,
+	FRAGMENTFLAG_WRITES_DEPTH	= (1 << 0),
+	FRAGMENTFLAG_DISCARDS		= (1 << 1),
+};
+
 struct VertexAttribute
 {
 						VertexAttribute				(const std::string& name_, rr::GenericVecType type_) : name(name_), type(type_) { }
@@ -141,6 +149,18 @@ struct GeometryShaderDeclaration
 	size_t							numInvocations;
 };
 
+struct FragmentShaderDeclaration
+{
+									FragmentShaderDeclaration	(int flags)
+									: writesDepth	((flags & FRAGMENTFLAG_WRITES_DEPTH) != 0)
+									, discards		((flags & FRAGMENTFLAG_DISCARDS) != 0)
+									{
+									}
+
+	bool							writesDepth;
+	bool							discards;
+};
+
 class ShaderProgramDeclaration
 {
 public:
@@ -156,6 +176,7 @@ public:
 	ShaderProgramDeclaration&				operator<<						(const FragmentSource&);
 	ShaderProgramDeclaration&				operator<<						(const GeometrySource&);
 	ShaderProgramDeclaration&				operator<<						(const GeometryShaderDeclaration&);
+	ShaderProgramDeclaration&				operator<<						(const FragmentShaderDeclaration&);
 
 private:
 	inline bool								hasGeometryShader				(void) const							{ return m_geometryShaderSet; }
@@ -178,6 +199,7 @@ private:
 	std::string								m_fragmentSource;
 	std::string								m_geometrySource;
 	GeometryShaderDeclaration				m_geometryDecl;
+	FragmentShaderDeclaration				m_fragmentDecl;
 
 	bool									m_vertexShaderSet;
 	bool									m_fragmentShaderSet;
@@ -250,8 +272,9 @@ private:
 	const std::string						m_geomSrc;
 	const bool								m_hasGeometryShader;
 
-	friend class ReferenceContext;	// for uniform access
-	friend class GLContext;			// for source string access
+	friend class ReferenceContext;					// for uniform access
+	friend class GLContext;							// for source string access
+	friend class rc::ShaderProgramObjectContainer;	// for linked state
 } DE_WARN_UNUSED_TYPE;
 
 } // sglr
@@ -23,6 +23,7 @@
 
 #include "tcuNullContextFactory.hpp"
 #include "tcuNullRenderContext.hpp"
+#include "sglrReferenceRenderContext.hpp"
 
 namespace tcu
 {
@@ -39,5 +40,15 @@ glu::RenderContext* NullGLContextFactory::createContext (const glu::RenderConfig
 	return new RenderContext(config);
 }
 
+ReferenceGLContextFactory::ReferenceGLContextFactory (void)
+	: glu::ContextFactory("reference", "Null Render Context with reference renderer")
+{
+}
+
+glu::RenderContext* ReferenceGLContextFactory::createContext (const glu::RenderConfig& config, const tcu::CommandLine&) const
+{
+	return new sglr::ReferenceRenderContext(new RenderContext(config));
+}
+
 } // null
 } // tcu
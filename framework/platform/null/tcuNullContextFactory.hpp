@@ -38,6 +38,14 @@ public:
 	glu::RenderContext*	createContext			(const glu::RenderConfig& config, const tcu::CommandLine&) const;
 };
 
+//! Null context where rendering is done with sglr::ReferenceContext.
+class ReferenceGLContextFactory : public glu::ContextFactory
+{
+public:
+						ReferenceGLContextFactory	(void);
+	glu::RenderContext*	createContext				(const glu::RenderConfig& config, const tcu::CommandLine&) const;
+};
+
 } // null
 } // tcu
 
@@ -29,6 +29,7 @@
 #include "deMemory.h"
 #include "deInt32.h"
 #include "deString.h"
+#include "deClock.h"
 
 #include "deMutex.h"
 
@@ -132,6 +133,11 @@ struct qpTestLog_s
 	deBool					isSessionOpen;
 	deBool					isCaseOpen;
 
+	FILE*					indexFile;			/*!< Case index (QP_TEST_LOG_WRITE_INDEX).	*/
+	char*					casePath;			/*!< Path of currently open case.		*/
+	deInt64					caseDataOffset;		/*!< Log offset of current case data.	*/
+	deUint64				caseStartTime;		/*!< Start time of current case (us).	*/
+
 #if defined(DE_DEBUG)
 	ContainerStack			containerStack;		/*!< For container usage verification.	*/
 #endif
@@ -258,6 +264,17 @@ static void qpTestLog_flushFile (qpTestLog* log)
 #endif
 }
 
+static deInt64 getFilePosition (FILE* file)
+{
+#if (DE_OS == DE_OS_WIN32) && (DE_COMPILER == DE_COMPILER_MSC)
+	return (deInt64)_ftelli64(file);
+#elif (DE_OS == DE_OS_UNIX) || (DE_OS == DE_OS_OSX) || (DE_OS == DE_OS_ANDROID)
+	return (deInt64)ftello(file);
+#else
+	return (deInt64)ftell(file);
+#endif
+}
+
 #define QP_LOOKUP_STRING(KEYMAP, KEY)	qpLookupString(KEYMAP, DE_LENGTH_OF_ARRAY(KEYMAP), (int)(KEY))
 
 static const char* qpLookupString (const qpKeyStringMap* keyMap, int keyMapSize, int key)
@@ -289,6 +306,34 @@ DE_INLINE void doubleToString (double value, char* buf, size_t bufSize)
 	deSprintf(buf, bufSize, "%f", value);
 }
 
+/*--------------------------------------------------------------------*//*!
+ * \brief Write case index entry
+ *
+ * Index file is a text file with one line per test case:
+ * <data offset> <data size> <status code> <duration in us> <case path>
+ *
+ * Data offset and size refer to the XML data of the case in the log
+ * file, i.e. the bytes between #beginTestCaseResult and
+ * #endTestCaseResult (or #terminateTestCaseResult) lines.
+ *//*--------------------------------------------------------------------*/
+static void writeIndexEntry (qpTestLog* log, deInt64 dataEnd, const char* statusStr)
+{
+	DE_ASSERT(log->indexFile && log->casePath);
+
+	fprintf(log->indexFile, "%lld %lld %s %lld %s\n",
+			(long long int)log->caseDataOffset,
+			(long long int)(dataEnd - log->caseDataOffset),
+			statusStr,
+			(long long int)(deGetMicroseconds() - log->caseStartTime),
+			log->casePath);
+
+	if (!(log->flags & QP_TEST_LOG_NO_FLUSH))
+		fflush(log->indexFile);
+
+	deFree(log->casePath);
+	log->casePath = DE_NULL;
+}
+
 static deBool beginSession (qpTestLog* log)
 {
 	DE_ASSERT(log && !log->isSessionOpen);
@@ -371,6 +416,29 @@ qpTestLog* qpTestLog_createFileLog (const char* fileName, deUint32 flags)
 		return DE_NULL;
 	}
 
+	if (flags & QP_TEST_LOG_WRITE_INDEX)
+	{
+		const size_t	indexNameSize	= strlen(fileName) + 5;
+		char*			indexName		= (char*)deMalloc(indexNameSize);
+
+		if (indexName)
+		{
+			deSprintf(indexName, indexNameSize, "%s.idx", fileName);
+			log->indexFile = fopen(indexName, "wb");
+		}
+
+		if (!log->indexFile)
+			qpPrintf("ERROR: Unable to open test log index file '%s.idx'.\n", fileName);
+
+		deFree(indexName);
+
+		if (!log->indexFile)
+		{
+			qpTestLog_destroy(log);
+			return DE_NULL;
+		}
+	}
+
 	beginSession(log);
 
 	return log;
@@ -393,6 +461,11 @@ void qpTestLog_destroy (qpTestLog* log)
 	if (log->outputFile)
 		fclose(log->outputFile);
 
+	if (log->indexFile)
+		fclose(log->indexFile);
+
+	deFree(log->casePath);
+
 	if (log->lock)
 		deMutex_destroy(log->lock);
 
@@ -426,6 +499,14 @@ deBool qpTestLog_startCase (qpTestLog* log, const char* testCasePath, qpTestCase
 
 	log->isCaseOpen = DE_TRUE;
 
+	if (log->indexFile)
+	{
+		deFree(log->casePath);
+		log->casePath	= deStrdup(testCasePath);
+		log->caseDataOffset	= getFilePosition(log->outputFile);
+		log->caseStartTime	= deGetMicroseconds();
+	}
+
 	/* Fill in attributes. */
 	resultAttribs[numResultAttribs++] = qpSetStringAttrib("Version", LOG_FORMAT_VERSION);
 	resultAttribs[numResultAttribs++] = qpSetStringAttrib("CasePath", testCasePath);
@@ -476,7 +557,12 @@ deBool qpTestLog_endCase (qpTestLog* log, qpTestResult result, const char* resul
 
 	/* Flush XML and write #endTestCaseResult. */
 	qpXmlWriter_flush(log->writer);
-	fprintf(log->outputFile, "\n#endTestCaseResult\n");
+	fprintf(log->outputFile, "\n");
+
+	if (log->indexFile && log->casePath)
+		writeIndexEntry(log, getFilePosition(log->outputFile), statusStr);
+
+	fprintf(log->outputFile, "#endTestCaseResult\n");
 	if (!(log->flags & QP_TEST_LOG_NO_FLUSH))
 		qpTestLog_flushFile(log);
 
@@ -509,7 +595,12 @@ deBool qpTestLog_terminateCase (qpTestLog* log, qpTestResult result)
 
 	/* Flush XML and write #terminateTestCaseResult. */
 	qpXmlWriter_flush(log->writer);
-	fprintf(log->outputFile, "\n#terminateTestCaseResult %s\n", resultStr);
+	fprintf(log->outputFile, "\n");
+
+	if (log->indexFile && log->casePath)
+		writeIndexEntry(log, getFilePosition(log->outputFile), resultStr);
+
+	fprintf(log->outputFile, "#terminateTestCaseResult %s\n", resultStr);
 	qpTestLog_flushFile(log);
 
 	log->isCaseOpen = DE_FALSE;
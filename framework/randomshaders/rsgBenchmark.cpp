@@ -0,0 +1,249 @@
+/*-------------------------------------------------------------------------
+ * drawElements Quality Program Random Shader Generator
+ * ----------------------------------------------------
+ *
+ * Copyright 2014 The Android Open Source Project
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ *      http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ *
+ *//*!
+ * \file
+ * \brief Random Shader Generator program generation benchmark.
+ *//*--------------------------------------------------------------------*/
+
+#include "rsgProgramGenerator.hpp"
+#include "deClock.h"
+#include "deString.h"
+#include "deThread.h"
+
+#if (DE_OS == DE_OS_UNIX) || (DE_OS == DE_OS_OSX)
+#	include <sys/resource.h>
+#endif
+
+#include <vector>
+#include <cstdio>
+#include <cstdlib>
+
+using std::vector;
+
+namespace
+{
+
+struct ParameterSet
+{
+	const char*				name;
+	rsg::ProgramParameters	params;
+
+	ParameterSet (const char* name_)
+		: name(name_)
+	{
+		params.vertexParameters.randomize	= true;
+		params.fragmentParameters.randomize	= true;
+	}
+};
+
+// Same parameters as in the random shader test groups, with both shaders randomized.
+vector<ParameterSet> getParameterSets (void)
+{
+	vector<ParameterSet> sets;
+
+	sets.push_back(ParameterSet("basic_expression"));
+
+	{
+		ParameterSet set("scalar_conversion");
+		set.params.useScalarConversions	= true;
+		sets.push_back(set);
+	}
+
+	{
+		ParameterSet set("swizzle");
+		set.params.useScalarConversions	= true;
+		set.params.useSwizzle			= true;
+		sets.push_back(set);
+	}
+
+	{
+		ParameterSet set("comparison_ops");
+		set.params.useScalarConversions	= true;
+		set.params.useComparisonOps		= true;
+		sets.push_back(set);
+	}
+
+	{
+		ParameterSet set("conditionals");
+		set.params.useScalarConversions							= true;
+		set.params.useSwizzle									= true;
+		set.params.useComparisonOps								= true;
+		set.params.useConditionals								= true;
+		set.params.vertexParameters.maxStatementDepth			= 4;
+		set.params.vertexParameters.maxStatementsPerBlock		= 5;
+		set.params.fragmentParameters.maxStatementDepth			= 4;
+		set.params.fragmentParameters.maxStatementsPerBlock		= 5;
+		sets.push_back(set);
+	}
+
+	{
+		ParameterSet set("trigonometric");
+		set.params.useScalarConversions		= true;
+		set.params.useSwizzle				= true;
+		set.params.trigonometricBaseWeight	= 4.0f;
+		sets.push_back(set);
+	}
+
+	{
+		ParameterSet set("exponential");
+		set.params.useScalarConversions		= true;
+		set.params.useSwizzle				= true;
+		set.params.exponentialBaseWeight	= 4.0f;
+		sets.push_back(set);
+	}
+
+	{
+		ParameterSet set("texture");
+		set.params.useScalarConversions						= true;
+		set.params.useSwizzle								= true;
+		set.params.vertexParameters.texLookupBaseWeight		= 10.0f;
+		set.params.vertexParameters.useTexture2D			= true;
+		set.params.vertexParameters.useTextureCube			= true;
+		set.params.fragmentParameters.texLookupBaseWeight	= 10.0f;
+		set.params.fragmentParameters.useTexture2D			= true;
+		set.params.fragmentParameters.useTextureCube		= true;
+		sets.push_back(set);
+	}
+
+	{
+		ParameterSet set("all_features");
+		set.params.useScalarConversions							= true;
+		set.params.useSwizzle									= true;
+		set.params.useComparisonOps								= true;
+		set.params.useConditionals								= true;
+		set.params.trigonometricBaseWeight						= 1.0f;
+		set.params.exponentialBaseWeight						= 1.0f;
+		set.params.vertexParameters.maxStatementDepth			= 4;
+		set.params.vertexParameters.maxStatementsPerBlock		= 7;
+		set.params.vertexParameters.maxExpressionDepth			= 7;
+		set.params.vertexParameters.maxCombinedVariableScalars	= 64;
+		set.params.fragmentParameters.maxStatementDepth			= 4;
+		set.params.fragmentParameters.maxStatementsPerBlock		= 7;
+		set.params.fragmentParameters.maxExpressionDepth		= 7;
+		set.params.fragmentParameters.maxCombinedVariableScalars	= 64;
+		set.params.fragmentParameters.texLookupBaseWeight		= 4.0f;
+		set.params.fragmentParameters.useTexture2D				= true;
+		set.params.fragmentParameters.useTextureCube			= true;
+		sets.push_back(set);
+	}
+
+	return sets;
+}
+
+//! Peak resident set size in kilobytes, or -1 if not available.
+long getPeakMemoryUsageKB (void)
+{
+#if (DE_OS == DE_OS_UNIX)
+	struct rusage usage;
+	if (getrusage(RUSAGE_SELF, &usage) == 0)
+		return usage.ru_maxrss;
+#elif (DE_OS == DE_OS_OSX)
+	struct rusage usage;
+	if (getrusage(RUSAGE_SELF, &usage) == 0)
+		return usage.ru_maxrss / 1024;
+#endif
+	return -1;
+}
+
+double generate (const vector<rsg::ProgramParameters>& params, vector<rsg::GeneratedProgramSp>& programs, int numThreads)
+{
+	const deUint64 startTime = deGetMicroseconds();
+
+	rsg::generatePrograms(params, programs, numThreads);
+
+	return (double)params.size() / ((double)(deGetMicroseconds() - startTime) / 1000000.0);
+}
+
+bool isSameProgram (const rsg::GeneratedProgram& a, const rsg::GeneratedProgram& b)
+{
+	return deStringEqual(a.getVertexShader().getSource(), b.getVertexShader().getSource()) &&
+		   deStringEqual(a.getFragmentShader().getSource(), b.getFragmentShader().getSource());
+}
+
+} // anonymous
+
+int main (int argc, const char* const* argv)
+{
+	int		numThreads		= (int)deGetNumAvailableLogicalCores();
+	int		numPrograms		= 200;
+	bool	allOk			= true;
+
+	for (int argNdx = 1; argNdx < argc; argNdx++)
+	{
+		if (deStringBeginsWith(argv[argNdx], "--threads="))
+			numThreads = atoi(argv[argNdx] + 10);
+		else if (deStringBeginsWith(argv[argNdx], "--programs="))
+			numPrograms = atoi(argv[argNdx] + 11);
+		else
+		{
+			printf("Usage: %s [--threads=<count>] [--programs=<count per set>]\n", argv[0]);
+			return -1;
+		}
+	}
+
+	numThreads	= de::max(numThreads, 1);
+	numPrograms	= de::max(numPrograms, 1);
+
+	{
+		const vector<ParameterSet> sets = getParameterSets();
+
+		printf("%-20s %12s %14s %10s %14s\n", "Parameter set", "1 thread", "threads", "Speedup", "Peak mem (KB)");
+		printf("%-20s %12s %14s %10s %14s\n", "", "(prog/s)", "(prog/s)", "", "");
+
+		for (vector<ParameterSet>::const_iterator set = sets.begin(); set != sets.end(); ++set)
+		{
+			vector<rsg::ProgramParameters>	params		(numPrograms, set->params);
+			vector<rsg::GeneratedProgramSp>	serial;
+			vector<rsg::GeneratedProgramSp>	parallel;
+
+			for (int programNdx = 0; programNdx < numPrograms; programNdx++)
+				params[programNdx].seed = (deUint32)programNdx;
+
+			try
+			{
+				const double	serialRate		= generate(params, serial, 1);
+				const double	parallelRate	= generate(params, parallel, numThreads);
+				int				numMismatches	= 0;
+
+				for (int programNdx = 0; programNdx < numPrograms; programNdx++)
+				{
+					if (!isSameProgram(*serial[programNdx], *parallel[programNdx]))
+						numMismatches += 1;
+				}
+
+				printf("%-20s %12.1f %14.1f %9.2fx %14ld\n", set->name, serialRate, parallelRate, parallelRate / serialRate, getPeakMemoryUsageKB());
+
+				if (numMismatches > 0)
+				{
+					printf("  FAIL: %d programs differ from serially generated ones\n", numMismatches);
+					allOk = false;
+				}
+			}
+			catch (const std::exception& e)
+			{
+				printf("%-20s FAIL: %s\n", set->name, e.what());
+				allOk = false;
+			}
+		}
+
+		printf("\n%d programs per set, %d threads\n", numPrograms, numThreads);
+	}
+
+	return allOk ? 0 : 1;
+}
@@ -22,6 +22,7 @@
  *//*--------------------------------------------------------------------*/
 
 #include "rsgBinaryOps.hpp"
+#include "rsgCompiledShader.hpp"
 #include "rsgVariableManager.hpp"
 #include "rsgUtils.hpp"
 #include "deMath.h"
@@ -110,6 +111,50 @@ void BinaryOp<Precedence, Assoc>::evaluate (ExecutionContext& execCtx)
 	evaluate(dst, leftVal, rightVal);
 }
 
+template <int Precedence, Associativity Assoc>
+int BinaryOp<Precedence, Assoc>::compile (ShaderCompiler& compiler) const
+{
+	const int	dst		= compiler.allocateTemp(m_type);
+	const int	tempTop	= compiler.getTempTop();
+	const int	left	= m_leftValueExpr->compile(compiler);
+	const int	right	= m_rightValueExpr->compile(compiler);
+
+	compile(compiler, dst, left, right);
+
+	compiler.releaseTemps(tempTop);
+	return dst;
+}
+
+namespace
+{
+
+template <typename T, class EvaluateComp>
+void execBinaryVecOp (const ExecInstruction& instr, ExecRegisters& regs)
+{
+	for (int elemNdx = 0; elemNdx < instr.numScalars; elemNdx++)
+	{
+		const Scalar* const	a	= regs.slots[instr.src[0]+elemNdx];
+		const Scalar* const	b	= regs.slots[instr.src[1]+elemNdx];
+		Scalar* const		dst	= regs.slots[instr.dst+elemNdx];
+
+		for (int compNdx = 0; compNdx < EXEC_VEC_WIDTH; compNdx++)
+			dst[compNdx].as<T>() = EvaluateComp()(a[compNdx].as<T>(), b[compNdx].as<T>());
+	}
+}
+
+template <typename T, class EvaluateComp>
+void execRelationalOp (const ExecInstruction& instr, ExecRegisters& regs)
+{
+	const Scalar* const	a	= regs.slots[instr.src[0]];
+	const Scalar* const	b	= regs.slots[instr.src[1]];
+	Scalar* const		dst	= regs.slots[instr.dst];
+
+	for (int compNdx = 0; compNdx < EXEC_VEC_WIDTH; compNdx++)
+		dst[compNdx].as<bool>() = EvaluateComp()(a[compNdx].as<T>(), b[compNdx].as<T>());
+}
+
+} // anonymous
+
 template <int Precedence, bool Float, bool Int, bool Bool, class ComputeValueRange, class EvaluateComp>
 BinaryVecOp<Precedence, Float, Int, Bool, ComputeValueRange, EvaluateComp>::BinaryVecOp (GeneratorState& state, Token::Type operatorToken, ConstValueRangeAccess inValueRange)
 	: BinaryOp<Precedence, ASSOCIATIVITY_LEFT>(operatorToken)
@@ -210,6 +255,20 @@ void BinaryVecOp<Precedence, Float, Int, Bool, ComputeValueRange, EvaluateComp>:
 	}
 }
 
+template <int Precedence, bool Float, bool Int, bool Bool, class ComputeValueRange, class EvaluateComp>
+void BinaryVecOp<Precedence, Float, Int, Bool, ComputeValueRange, EvaluateComp>::compile (ShaderCompiler& compiler, int dst, int a, int b) const
+{
+	const int numElements = this->m_type.getNumElements();
+
+	switch (this->m_type.getBaseType())
+	{
+		case VariableType::TYPE_FLOAT:	compiler.emit(ExecInstruction(execBinaryVecOp<float, EvaluateComp>,	dst, a, b, -1, numElements));	break;
+		case VariableType::TYPE_INT:	compiler.emit(ExecInstruction(execBinaryVecOp<int, EvaluateComp>,	dst, a, b, -1, numElements));	break;
+		default:
+			DE_ASSERT(DE_FALSE);
+	}
+}
+
 void ComputeMulRange::operator() (de::Random& rnd, float dstMin, float dstMax, float& aMin, float& aMax, float& bMin, float& bMax) const
 {
 	const float minScale	 = 0.25f;
@@ -461,6 +520,18 @@ void RelationalOp<ComputeValueRange, EvaluateComp>::evaluate (ExecValueAccess ds
 	}
 }
 
+template <class ComputeValueRange, class EvaluateComp>
+void RelationalOp<ComputeValueRange, EvaluateComp>::compile (ShaderCompiler& compiler, int dst, int a, int b) const
+{
+	switch (m_leftValueRange.getType().getBaseType())
+	{
+		case VariableType::TYPE_FLOAT:	compiler.emit(ExecInstruction(execRelationalOp<float, EvaluateComp>,	dst, a, b));	break;
+		case VariableType::TYPE_INT:	compiler.emit(ExecInstruction(execRelationalOp<int, EvaluateComp>,		dst, a, b));	break;
+		default:
+			DE_ASSERT(DE_FALSE);
+	}
+}
+
 template <class ComputeValueRange, class EvaluateComp>
 float RelationalOp<ComputeValueRange, EvaluateComp>::getWeight (const GeneratorState& state, ConstValueRangeAccess valueRange)
 {
@@ -781,6 +852,24 @@ inline bool EqualityCompare<false>::compare	(T a, T b)			{ return a != b; }
 template <>
 inline bool EqualityCompare<false>::combine	(bool a, bool b)	{ return a || b; }
 
+template <bool IsEqual, typename T>
+void execEqualityComparison (const ExecInstruction& instr, ExecRegisters& regs)
+{
+	Scalar* const dst = regs.slots[instr.dst];
+
+	for (int compNdx = 0; compNdx < EXEC_VEC_WIDTH; compNdx++)
+		dst[compNdx].as<bool>() = IsEqual ? true : false;
+
+	for (int elemNdx = 0; elemNdx < instr.numScalars; elemNdx++)
+	{
+		const Scalar* const	a	= regs.slots[instr.src[0]+elemNdx];
+		const Scalar* const	b	= regs.slots[instr.src[1]+elemNdx];
+
+		for (int compNdx = 0; compNdx < EXEC_VEC_WIDTH; compNdx++)
+			dst[compNdx].as<bool>() = EqualityCompare<IsEqual>::combine(dst[compNdx].as<bool>(), EqualityCompare<IsEqual>::compare(a[compNdx].as<T>(), b[compNdx].as<T>()));
+	}
+}
+
 } // anonymous
 
 template <bool IsEqual>
@@ -832,6 +921,22 @@ void EqualityComparisonOp<IsEqual>::evaluate (ExecValueAccess dst, ExecConstValu
 	}
 }
 
+template <bool IsEqual>
+void EqualityComparisonOp<IsEqual>::compile (ShaderCompiler& compiler, int dst, int a, int b) const
+{
+	const VariableType&	type		= m_leftValueRange.getType();
+	const int			numElements	= type.getNumElements();
+
+	switch (type.getBaseType())
+	{
+		case VariableType::TYPE_FLOAT:	compiler.emit(ExecInstruction(execEqualityComparison<IsEqual, float>,	dst, a, b, -1, numElements));	break;
+		case VariableType::TYPE_INT:	compiler.emit(ExecInstruction(execEqualityComparison<IsEqual, int>,		dst, a, b, -1, numElements));	break;
+		case VariableType::TYPE_BOOL:	compiler.emit(ExecInstruction(execEqualityComparison<IsEqual, bool>,	dst, a, b, -1, numElements));	break;
+		default:
+			DE_ASSERT(DE_FALSE);
+	}
+}
+
 EqualOp::EqualOp (GeneratorState& state, ConstValueRangeAccess valueRange)
 	: EqualityComparisonOp<true>(state, valueRange)
 {
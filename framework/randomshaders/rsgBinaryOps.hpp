@@ -48,8 +48,10 @@ public:
 	void						tokenize			(GeneratorState& state, TokenStream& str) const;
 	void						evaluate			(ExecutionContext& execCtx);
 	ExecConstValueAccess		getValue			(void) const { return m_value.getValue(m_type); }
+	int							compile				(ShaderCompiler& compiler) const;
 
 	virtual void				evaluate			(ExecValueAccess dst, ExecConstValueAccess a, ExecConstValueAccess b) = DE_NULL;
+	virtual void				compile				(ShaderCompiler& compiler, int dst, int a, int b) const = DE_NULL;
 
 protected:
 	static float				getWeight			(const GeneratorState& state, ConstValueRangeAccess valueRange);
@@ -73,6 +75,7 @@ public:
 	virtual						~BinaryVecOp		(void);
 
 	void						evaluate			(ExecValueAccess dst, ExecConstValueAccess a, ExecConstValueAccess b);
+	void						compile				(ShaderCompiler& compiler, int dst, int a, int b) const;
 };
 
 struct ComputeMulRange
@@ -152,6 +155,7 @@ public:
 	virtual						~RelationalOp		(void);
 
 	void						evaluate			(ExecValueAccess dst, ExecConstValueAccess a, ExecConstValueAccess b);
+	void						compile				(ShaderCompiler& compiler, int dst, int a, int b) const;
 
 	static float				getWeight			(const GeneratorState& state, ConstValueRangeAccess valueRange);
 };
@@ -268,6 +272,7 @@ public:
 	virtual						~EqualityComparisonOp		(void) {}
 
 	void						evaluate					(ExecValueAccess dst, ExecConstValueAccess a, ExecConstValueAccess b);
+	void						compile						(ShaderCompiler& compiler, int dst, int a, int b) const;
 
 	static float				getWeight					(const GeneratorState& state, ConstValueRangeAccess valueRange);
 };
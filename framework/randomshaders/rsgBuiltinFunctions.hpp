@@ -25,6 +25,7 @@
 
 #include "rsgDefs.hpp"
 #include "rsgExpression.hpp"
+#include "rsgCompiledShader.hpp"
 #include "rsgUtils.hpp"
 #include "deMath.h"
 
@@ -44,6 +45,7 @@ public:
 
 	void						evaluate				(ExecutionContext& execCtx);
 	ExecConstValueAccess		getValue				(void) const { return m_value.getValue(m_inValueRange.getType()); }
+	int							compile					(ShaderCompiler& compiler) const;
 
 	static float				getWeight				(const GeneratorState& state, ConstValueRangeAccess valueRange);
 
@@ -117,6 +119,33 @@ void UnaryBuiltinVecFunc<GetValueRangeWeight, ComputeValueRange, Evaluate>::eval
 	}
 }
 
+template <class Evaluate>
+void execUnaryBuiltinVecFunc (const ExecInstruction& instr, ExecRegisters& regs)
+{
+	for (int elemNdx = 0; elemNdx < instr.numScalars; elemNdx++)
+	{
+		const Scalar* const	src	= regs.slots[instr.src[0]+elemNdx];
+		Scalar* const		dst	= regs.slots[instr.dst+elemNdx];
+
+		for (int compNdx = 0; compNdx < EXEC_VEC_WIDTH; compNdx++)
+			dst[compNdx].floatVal = Evaluate()(src[compNdx].floatVal);
+	}
+}
+
+template <class GetValueRangeWeight, class ComputeValueRange, class Evaluate>
+int UnaryBuiltinVecFunc<GetValueRangeWeight, ComputeValueRange, Evaluate>::compile (ShaderCompiler& compiler) const
+{
+	const VariableType&	type	= m_inValueRange.getType();
+	const int			dst		= compiler.allocateTemp(type);
+	const int			tempTop	= compiler.getTempTop();
+	const int			src		= m_child->compile(compiler);
+
+	compiler.emit(ExecInstruction(execUnaryBuiltinVecFunc<Evaluate>, dst, src, -1, -1, type.getNumElements()));
+
+	compiler.releaseTemps(tempTop);
+	return dst;
+}
+
 template <class GetValueRangeWeight, class ComputeValueRange, class Evaluate>
 float UnaryBuiltinVecFunc<GetValueRangeWeight, ComputeValueRange, Evaluate>::getWeight (const GeneratorState& state, ConstValueRangeAccess valueRange)
 {
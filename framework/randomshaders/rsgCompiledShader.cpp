@@ -0,0 +1,320 @@
+/*-------------------------------------------------------------------------
+ * drawElements Quality Program Random Shader Generator
+ * ----------------------------------------------------
+ *
+ * Copyright 2014 The Android Open Source Project
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ *      http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ *
+ *//*!
+ * \file
+ * \brief Compiled shader execution.
+ *//*--------------------------------------------------------------------*/
+
+#include "rsgCompiledShader.hpp"
+#include "rsgShader.hpp"
+
+#include <algorithm>
+
+using std::vector;
+
+namespace rsg
+{
+
+namespace
+{
+
+const ExecMask ALL_LANES = ~(ExecMask)0;
+
+inline ExecMask getLaneBit (int laneNdx)
+{
+	return ((ExecMask)1) << laneNdx;
+}
+
+ExecMask toExecMask (const Scalar* value)
+{
+	ExecMask mask = 0;
+
+	for (int laneNdx = 0; laneNdx < EXEC_VEC_WIDTH; laneNdx++)
+	{
+		if (value[laneNdx].boolVal)
+			mask |= getLaneBit(laneNdx);
+	}
+
+	return mask;
+}
+
+void execCopy (const ExecInstruction& instr, ExecRegisters& regs)
+{
+	for (int compNdx = 0; compNdx < instr.numScalars; compNdx++)
+	{
+		const Scalar* const	src	= regs.slots[instr.src[0]+compNdx];
+		Scalar* const		dst	= regs.slots[instr.dst+compNdx];
+
+		std::copy(src, src+EXEC_VEC_WIDTH, dst);
+	}
+}
+
+void execAssignMasked (const ExecInstruction& instr, ExecRegisters& regs)
+{
+	const ExecMask mask = regs.masks[instr.maskLevel];
+
+	if (mask == ALL_LANES)
+	{
+		execCopy(instr, regs);
+		return;
+	}
+
+	for (int compNdx = 0; compNdx < instr.numScalars; compNdx++)
+	{
+		const Scalar* const	src	= regs.slots[instr.src[0]+compNdx];
+		Scalar* const		dst	= regs.slots[instr.dst+compNdx];
+
+		for (int laneNdx = 0; laneNdx < EXEC_VEC_WIDTH; laneNdx++)
+		{
+			if (mask & getLaneBit(laneNdx))
+				dst[laneNdx] = src[laneNdx];
+		}
+	}
+}
+
+// Mask level L+1 = level L & condition. Jumps to else block or end if no lane is active.
+void execBeginConditional (const ExecInstruction& instr, ExecRegisters& regs)
+{
+	const int		level		= instr.maskLevel;
+	const ExecMask	condMask	= toExecMask(regs.slots[instr.src[0]]);
+
+	regs.condMasks[level]	= condMask;
+	regs.masks[level+1]		= regs.masks[level] & condMask;
+
+	if (regs.masks[level+1] == 0)
+		regs.pc = instr.jumpTarget;
+}
+
+// Mask level L+1 = level L & !condition. Jumps to end if no lane is active.
+void execBeginElse (const ExecInstruction& instr, ExecRegisters& regs)
+{
+	const int level = instr.maskLevel;
+
+	regs.masks[level+1] = regs.masks[level] & ~regs.condMasks[level];
+
+	if (regs.masks[level+1] == 0)
+		regs.pc = instr.jumpTarget;
+}
+
+} // anonymous
+
+// ShaderCompiler
+
+ShaderCompiler::ShaderCompiler (void)
+	: m_numVariableSlots	(0)
+	, m_numTempSlots		(0)
+	, m_maxTempSlots		(0)
+	, m_maskLevel			(0)
+	, m_maxMaskLevel		(0)
+{
+}
+
+ShaderCompiler::~ShaderCompiler (void)
+{
+}
+
+int ShaderCompiler::getVariableSlot (const Variable* variable)
+{
+	std::map<const Variable*, int>::const_iterator pos = m_variableSlots.find(variable);
+
+	if (pos != m_variableSlots.end())
+		return pos->second;
+
+	const int slot = (SLOTKIND_VARIABLE << SLOT_KIND_SHIFT) | m_numVariableSlots;
+
+	m_variableSlots[variable]	 = slot;
+	m_numVariableSlots			+= variable->getType().getScalarSize();
+	m_variables.push_back(variable);
+
+	return slot;
+}
+
+int ShaderCompiler::allocateConstant (ExecConstValueAccess value)
+{
+	const int		numScalars	= value.getType().getScalarSize();
+	const Scalar*	valuePtr	= value.value().getValuePtr();
+	const int		slot		= (SLOTKIND_CONSTANT << SLOT_KIND_SHIFT) | (int)(m_constants.size() / EXEC_VEC_WIDTH);
+
+	m_constants.insert(m_constants.end(), valuePtr, valuePtr + numScalars*EXEC_VEC_WIDTH);
+
+	return slot;
+}
+
+int ShaderCompiler::allocateTemp (const VariableType& type)
+{
+	const int slot = (SLOTKIND_TEMP << SLOT_KIND_SHIFT) | m_numTempSlots;
+
+	m_numTempSlots	+= type.getScalarSize();
+	m_maxTempSlots	 = de::max(m_maxTempSlots, m_numTempSlots);
+
+	return slot;
+}
+
+void ShaderCompiler::releaseTemps (int top)
+{
+	DE_ASSERT(de::inRange(top, 0, m_numTempSlots));
+	m_numTempSlots = top;
+}
+
+void ShaderCompiler::emit (const ExecInstruction& instr)
+{
+	DE_ASSERT(instr.func);
+	m_instructions.push_back(instr);
+}
+
+void ShaderCompiler::emitCopy (int dst, int src, int numScalars)
+{
+	if (numScalars > 0 && dst != src)
+		emit(ExecInstruction(execCopy, dst, src, -1, -1, numScalars));
+}
+
+void ShaderCompiler::emitAssignMasked (int dst, int src, int numScalars)
+{
+	ExecInstruction instr(execAssignMasked, dst, src, -1, -1, numScalars);
+
+	if (numScalars == 0)
+		return;
+
+	instr.maskLevel = m_maskLevel;
+	emit(instr);
+}
+
+void ShaderCompiler::beginConditional (int condSlot)
+{
+	ExecInstruction instr(execBeginConditional, -1, condSlot);
+
+	instr.maskLevel = m_maskLevel;
+
+	m_pendingJumps.push_back((int)m_instructions.size());
+	emit(instr);
+
+	m_maskLevel		+= 1;
+	m_maxMaskLevel	 = de::max(m_maxMaskLevel, m_maskLevel);
+}
+
+void ShaderCompiler::beginElse (void)
+{
+	m_maskLevel -= 1;
+
+	ExecInstruction instr(execBeginElse);
+
+	instr.maskLevel = m_maskLevel;
+
+	m_instructions[m_pendingJumps.back()].jumpTarget	= (int)m_instructions.size();
+	m_pendingJumps.back()							= (int)m_instructions.size();
+	emit(instr);
+
+	m_maskLevel += 1;
+}
+
+void ShaderCompiler::endConditional (void)
+{
+	m_maskLevel -= 1;
+
+	m_instructions[m_pendingJumps.back()].jumpTarget = (int)m_instructions.size();
+	m_pendingJumps.pop_back();
+}
+
+// CompiledShader
+
+CompiledShader::CompiledShader (const Shader& shader)
+{
+	ShaderCompiler compiler;
+
+	shader.compile(compiler);
+
+	DE_ASSERT(compiler.m_maskLevel == 0 && compiler.m_pendingJumps.empty());
+
+	// Slot layout: variables, constants, temporaries.
+	const int	numConstantSlots	= (int)compiler.m_constants.size() / EXEC_VEC_WIDTH;
+	const int	slotBase[]			=
+	{
+		0,
+		compiler.m_numVariableSlots,
+		compiler.m_numVariableSlots + numConstantSlots
+	};
+	DE_STATIC_ASSERT(DE_LENGTH_OF_ARRAY(slotBase) == ShaderCompiler::SLOTKIND_LAST);
+
+	const int	numSlots			= slotBase[ShaderCompiler::SLOTKIND_TEMP] + compiler.m_maxTempSlots;
+
+	m_instructions.swap(compiler.m_instructions);
+
+	for (vector<ExecInstruction>::iterator instr = m_instructions.begin(); instr != m_instructions.end(); ++instr)
+	{
+		int* const slots[] = { &instr->dst, &instr->src[0], &instr->src[1], &instr->src[2] };
+
+		for (int ndx = 0; ndx < DE_LENGTH_OF_ARRAY(slots); ndx++)
+		{
+			if (*slots[ndx] >= 0)
+				*slots[ndx] = slotBase[*slots[ndx] >> ShaderCompiler::SLOT_KIND_SHIFT] + (*slots[ndx] & ShaderCompiler::SLOT_NDX_MASK);
+		}
+	}
+
+	for (vector<const Variable*>::const_iterator var = compiler.m_variables.begin(); var != compiler.m_variables.end(); ++var)
+		m_variables.push_back(VariableSlot(*var, compiler.m_variableSlots[*var] & ShaderCompiler::SLOT_NDX_MASK));
+
+	// Constant and temporary slots point to register storage, variable slots are bound in execute().
+	m_registers.resize((size_t)(numConstantSlots + compiler.m_maxTempSlots) * EXEC_VEC_WIDTH);
+	std::copy(compiler.m_constants.begin(), compiler.m_constants.end(), m_registers.begin());
+
+	m_slots.resize(numSlots, DE_NULL);
+	for (int slotNdx = slotBase[ShaderCompiler::SLOTKIND_CONSTANT]; slotNdx < numSlots; slotNdx++)
+		m_slots[slotNdx] = &m_registers[(size_t)(slotNdx - slotBase[ShaderCompiler::SLOTKIND_CONSTANT]) * EXEC_VEC_WIDTH];
+
+	m_masks.resize(compiler.m_maxMaskLevel+1);
+	m_condMasks.resize(compiler.m_maxMaskLevel+1);
+}
+
+CompiledShader::~CompiledShader (void)
+{
+}
+
+void CompiledShader::execute (ExecutionContext& execCtx)
+{
+	// Bind variables.
+	for (vector<VariableSlot>::const_iterator var = m_variables.begin(); var != m_variables.end(); ++var)
+	{
+		Scalar* const	valuePtr	= execCtx.getValue(var->first).getValuePtr();
+		const int		numScalars	= var->first->getType().getScalarSize();
+
+		for (int compNdx = 0; compNdx < numScalars; compNdx++)
+			m_slots[var->second + compNdx] = valuePtr + compNdx*EXEC_VEC_WIDTH;
+	}
+
+	m_masks[0] = toExecMask(execCtx.getExecutionMask().value().getValuePtr());
+
+	{
+		ExecRegisters	regs;
+		const int		numInstructions	= (int)m_instructions.size();
+
+		regs.slots		= m_slots.empty() ? DE_NULL : &m_slots[0];
+		regs.masks		= &m_masks[0];
+		regs.condMasks	= &m_condMasks[0];
+		regs.context	= &execCtx;
+		regs.pc			= 0;
+
+		while (regs.pc < numInstructions)
+		{
+			const ExecInstruction& instr = m_instructions[regs.pc++];
+			instr.func(instr, regs);
+		}
+	}
+}
+
+} // rsg
@@ -0,0 +1,187 @@
+#ifndef _RSGCOMPILEDSHADER_HPP
+#define _RSGCOMPILEDSHADER_HPP
+/*-------------------------------------------------------------------------
+ * drawElements Quality Program Random Shader Generator
+ * ----------------------------------------------------
+ *
+ * Copyright 2014 The Android Open Source Project
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ *      http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ *
+ *//*!
+ * \file
+ * \brief Compiled shader execution.
+ *
+ * Shader tree is lowered once into a flat instruction list that operates
+ * on a register file of slots. A slot holds one scalar component for all
+ * EXEC_VEC_WIDTH lanes, and a value of N scalars occupies N consecutive
+ * slots, which is the same layout ExecValueStorage uses. Variable slots
+ * point directly to ExecutionContext storage, so compiled shaders and
+ * Shader::execute() produce identical results on the same context.
+ *
+ * Each instruction is a kernel function bound to its operand slots.
+ * Kernels are provided by the tree nodes that emit them. Execution masks
+ * are kept as bitmasks with one bit per lane, and conditional blocks
+ * with an empty mask are skipped.
+ *//*--------------------------------------------------------------------*/
+
+#include "rsgDefs.hpp"
+#include "rsgVariable.hpp"
+#include "rsgExecutionContext.hpp"
+
+#include <vector>
+#include <map>
+
+namespace rsg
+{
+
+class Shader;
+
+DE_STATIC_ASSERT(EXEC_VEC_WIDTH == 64);
+
+typedef deUint64 ExecMask;
+
+struct ExecRegisters
+{
+	Scalar* const*				slots;			//!< Slot pointers, slot has EXEC_VEC_WIDTH values.
+	ExecMask*					masks;			//!< Execution mask stack.
+	ExecMask*					condMasks;		//!< Condition mask per conditional nesting level.
+	ExecutionContext*			context;
+	int							pc;				//!< Index of next instruction.
+};
+
+struct ExecInstruction
+{
+	typedef void (*Func) (const ExecInstruction& instr, ExecRegisters& regs);
+
+	Func						func;
+	int							dst;			//!< First destination slot.
+	int							src[3];			//!< First source slots.
+	int							numScalars;		//!< Number of consecutive slots processed.
+	int							maskLevel;		//!< Execution mask level.
+	int							jumpTarget;		//!< Instruction to continue from when block is skipped.
+	const Variable*				variable;		//!< Sampler for texture lookups.
+
+	ExecInstruction (Func func_ = DE_NULL, int dst_ = -1, int src0 = -1, int src1 = -1, int src2 = -1, int numScalars_ = 1)
+		: func			(func_)
+		, dst			(dst_)
+		, numScalars	(numScalars_)
+		, maskLevel		(0)
+		, jumpTarget	(-1)
+		, variable		(DE_NULL)
+	{
+		src[0] = src0;
+		src[1] = src1;
+		src[2] = src2;
+	}
+};
+
+/*--------------------------------------------------------------------*//*!
+ * \brief Shader tree to instruction list compiler.
+ *
+ * Expression::compile() returns the first slot of the expression value.
+ * Temporaries are allocated from a stack: a node allocates its result,
+ * compiles its children and releases their temporaries after emitting
+ * its own instructions.
+ *//*--------------------------------------------------------------------*/
+class ShaderCompiler
+{
+public:
+								ShaderCompiler		(void);
+								~ShaderCompiler		(void);
+
+	int							getVariableSlot		(const Variable* variable);
+	int							allocateConstant	(ExecConstValueAccess value);
+	int							allocateTemp		(const VariableType& type);
+
+	int							getTempTop			(void) const	{ return m_numTempSlots;	}
+	void						releaseTemps		(int top);
+
+	void						emit				(const ExecInstruction& instr);
+	void						emitCopy			(int dst, int src, int numScalars);
+	void						emitAssignMasked	(int dst, int src, int numScalars);
+
+	void						beginConditional	(int condSlot);
+	void						beginElse			(void);
+	void						endConditional		(void);
+
+private:
+	friend class CompiledShader;
+
+								ShaderCompiler		(const ShaderCompiler&);
+	ShaderCompiler&				operator=			(const ShaderCompiler&);
+
+	enum SlotKind
+	{
+		SLOTKIND_VARIABLE = 0,
+		SLOTKIND_CONSTANT,
+		SLOTKIND_TEMP,
+
+		SLOTKIND_LAST
+	};
+
+	enum
+	{
+		SLOT_KIND_SHIFT	= 28,
+		SLOT_NDX_MASK	= (1<<SLOT_KIND_SHIFT)-1
+	};
+
+	std::vector<ExecInstruction>				m_instructions;
+
+	std::map<const Variable*, int>				m_variableSlots;
+	std::vector<const Variable*>				m_variables;
+	int											m_numVariableSlots;
+
+	std::vector<Scalar>							m_constants;
+	int											m_numTempSlots;
+	int											m_maxTempSlots;
+
+	int											m_maskLevel;
+	int											m_maxMaskLevel;
+	std::vector<int>							m_pendingJumps;
+};
+
+/*--------------------------------------------------------------------*//*!
+ * \brief Shader compiled to instruction list.
+ *
+ * Executes same as Shader::execute() but without walking the tree. Shader
+ * must outlive compiled shader since variables are bound to execution
+ * context on each execute().
+ *//*--------------------------------------------------------------------*/
+class CompiledShader
+{
+public:
+	explicit					CompiledShader		(const Shader& shader);
+								~CompiledShader		(void);
+
+	void						execute				(ExecutionContext& execCtx);
+
+	int							getNumInstructions	(void) const	{ return (int)m_instructions.size();	}
+
+private:
+								CompiledShader		(const CompiledShader&);
+	CompiledShader&				operator=			(const CompiledShader&);
+
+	typedef std::pair<const Variable*, int>		VariableSlot;
+
+	std::vector<ExecInstruction>				m_instructions;
+	std::vector<VariableSlot>					m_variables;		//!< Variable and its first slot.
+	std::vector<Scalar>							m_registers;		//!< Constants and temporaries.
+	std::vector<Scalar*>						m_slots;
+	std::vector<ExecMask>						m_masks;
+	std::vector<ExecMask>						m_condMasks;
+};
+
+} // rsg
+
+#endif // _RSGCOMPILEDSHADER_HPP
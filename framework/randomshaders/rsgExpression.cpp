@@ -22,6 +22,7 @@
  *//*--------------------------------------------------------------------*/
 
 #include "rsgExpression.hpp"
+#include "rsgCompiledShader.hpp"
 #include "rsgVariableManager.hpp"
 #include "rsgBinaryOps.hpp"
 #include "rsgBuiltinFunctions.hpp"
@@ -414,6 +415,11 @@ void FloatLiteral::tokenize (GeneratorState& state, TokenStream& str) const
 	str << Token(m_value.getValue(VariableType::getScalarType(VariableType::TYPE_FLOAT)).asFloat(0));
 }
 
+int FloatLiteral::compile (ShaderCompiler& compiler) const
+{
+	return compiler.allocateConstant(getValue());
+}
+
 IntLiteral::IntLiteral (GeneratorState& state, ConstValueRangeAccess valueRange)
 	: m_value(VariableType::getScalarType(VariableType::TYPE_INT))
 {
@@ -468,6 +474,11 @@ void IntLiteral::tokenize (GeneratorState& state, TokenStream& str) const
 	str << Token(m_value.getValue(VariableType::getScalarType(VariableType::TYPE_INT)).asInt(0));
 }
 
+int IntLiteral::compile (ShaderCompiler& compiler) const
+{
+	return compiler.allocateConstant(getValue());
+}
+
 BoolLiteral::BoolLiteral (GeneratorState& state, ConstValueRangeAccess valueRange)
 	: m_value(VariableType::getScalarType(VariableType::TYPE_BOOL))
 {
@@ -505,6 +516,11 @@ void BoolLiteral::tokenize (GeneratorState& state, TokenStream& str) const
 	str << Token(m_value.getValue(VariableType::getScalarType(VariableType::TYPE_BOOL)).asBool(0));
 }
 
+int BoolLiteral::compile (ShaderCompiler& compiler) const
+{
+	return compiler.allocateConstant(getValue());
+}
+
 namespace
 {
 
@@ -669,6 +685,32 @@ void convertExecValue (ExecConstValueAccess src, ExecValueAccess dst)
 	convTable[getBaseTypeConvNdx(src.getType().getBaseType())][getBaseTypeConvNdx(dst.getType().getBaseType())](src, dst);
 }
 
+template <typename SrcType, typename DstType>
+void execConvertTempl (const ExecInstruction& instr, ExecRegisters& regs)
+{
+	for (int compNdx = 0; compNdx < instr.numScalars; compNdx++)
+	{
+		const Scalar* const	src	= regs.slots[instr.src[0]+compNdx];
+		Scalar* const		dst	= regs.slots[instr.dst+compNdx];
+
+		for (int ndx = 0; ndx < EXEC_VEC_WIDTH; ndx++)
+			dst[ndx].as<DstType>() = convert<SrcType, DstType>(src[ndx].as<SrcType>());
+	}
+}
+
+ExecInstruction::Func getExecConvertFunc (VariableType::Type srcType, VariableType::Type dstType)
+{
+	// [src][dst]
+	static const ExecInstruction::Func convTable[3][3] =
+	{
+		{ execConvertTempl<float,	float>,	execConvertTempl<float,	int>,	execConvertTempl<float,	bool>	},
+		{ execConvertTempl<int,		float>,	execConvertTempl<int,	int>,	execConvertTempl<int,	bool>	},
+		{ execConvertTempl<bool,	float>,	execConvertTempl<bool,	int>,	execConvertTempl<bool,	bool>	}
+	};
+
+	return convTable[getBaseTypeConvNdx(srcType)][getBaseTypeConvNdx(dstType)];
+}
+
 } // anonymous
 
 ConstructorOp::ConstructorOp (GeneratorState& state, ConstValueRangeAccess valueRange)
@@ -695,6 +737,9 @@ ConstructorOp::ConstructorOp (GeneratorState& state, ConstValueRangeAccess value
 
 	bool scalarConversions = state.getProgramParameters().useScalarConversions;
 
+	m_inputValueRanges.reserve(numScalars);
+	m_inputExpressions.reserve(numScalars);
+
 	while (curScalarNdx < numScalars)
 	{
 		ConstValueRangeAccess comp = m_valueRange.asAccess().component(curScalarNdx);
@@ -714,9 +759,8 @@ ConstructorOp::ConstructorOp (GeneratorState& state, ConstValueRangeAccess value
 			VariableType::Type inType = state.getRandom().choose<VariableType::Type>(&inTypes[0], &inTypes[0] + numInTypes);
 
 			// Compute converted value range
-			ValueRange inValueRange(VariableType(inType, 1));
-			convertValueRange(comp, inValueRange);
-			m_inputValueRanges.push_back(inValueRange);
+			m_inputValueRanges.push_back(ValueRange(VariableType::getScalarType(inType)));
+			convertValueRange(comp, m_inputValueRanges.back());
 
 			curScalarNdx += 1;
 		}
@@ -812,6 +856,34 @@ void ConstructorOp::evaluate (ExecutionContext& evalCtx)
 	}
 }
 
+int ConstructorOp::compile (ShaderCompiler& compiler) const
+{
+	const VariableType&	type			= m_valueRange.getType();
+	const int			dst				= compiler.allocateTemp(type);
+	const int			tempTop			= compiler.getTempTop();
+	const int			numInputs		= (int)m_inputExpressions.size();
+	vector<int>			srcSlots		(numInputs);
+	int					curScalarNdx	= 0;
+
+	// Children are stored in reverse order, see createNextChild().
+	for (int inputNdx = numInputs-1; inputNdx >= 0; inputNdx--)
+		srcSlots[inputNdx] = m_inputExpressions[inputNdx]->compile(compiler);
+
+	for (int inputNdx = numInputs-1; inputNdx >= 0; inputNdx--)
+	{
+		const VariableType&	srcType		= m_inputValueRanges[numInputs-1-inputNdx].getType();
+		const int			numElements	= srcType.getNumElements();
+
+		compiler.emit(ExecInstruction(getExecConvertFunc(srcType.getBaseType(), type.getBaseType()), dst+curScalarNdx, srcSlots[inputNdx], -1, -1, numElements));
+		curScalarNdx += numElements;
+	}
+
+	DE_ASSERT(curScalarNdx == type.getNumElements());
+
+	compiler.releaseTemps(tempTop);
+	return dst;
+}
+
 AssignOp::AssignOp (GeneratorState& state, ConstValueRangeAccess valueRange)
 	: m_valueRange	(valueRange)
 	, m_lvalueExpr	(DE_NULL)
@@ -947,6 +1019,22 @@ void AssignOp::evaluate (ExecutionContext& evalCtx)
 	assignMasked(m_lvalueExpr->getLValue(), m_value.getValue(m_valueRange.getType()), evalCtx.getExecutionMask());
 }
 
+int AssignOp::compile (ShaderCompiler& compiler) const
+{
+	const VariableType&	type		= m_valueRange.getType();
+	const int			numScalars	= type.getScalarSize();
+	const int			dst			= compiler.allocateTemp(type);
+	const int			tempTop		= compiler.getTempTop();
+	const int			lvalue		= m_lvalueExpr->compile(compiler);
+	const int			rvalue		= m_rvalueExpr->compile(compiler);
+
+	compiler.emitCopy(dst, rvalue, numScalars);
+	compiler.emitAssignMasked(lvalue, dst, numScalars);
+
+	compiler.releaseTemps(tempTop);
+	return dst;
+}
+
 namespace
 {
 
@@ -1220,6 +1308,16 @@ void VariableAccess::evaluate (ExecutionContext& evalCtx)
 	m_valueAccess = evalCtx.getValue(m_variable);
 }
 
+int VariableAccess::compile (ShaderCompiler& compiler) const
+{
+	return compiler.getVariableSlot(m_variable);
+}
+
+int ParenOp::compile (ShaderCompiler& compiler) const
+{
+	return m_child->compile(compiler);
+}
+
 ParenOp::ParenOp (GeneratorState& state, ConstValueRangeAccess valueRange)
 	: m_valueRange	(valueRange)
 	, m_child		(DE_NULL)
@@ -1391,6 +1489,20 @@ void SwizzleOp::evaluate (ExecutionContext& execCtx)
 	}
 }
 
+int SwizzleOp::compile (ShaderCompiler& compiler) const
+{
+	const VariableType&	outType		= m_outValueRange.getType();
+	const int			dst			= compiler.allocateTemp(outType);
+	const int			tempTop		= compiler.getTempTop();
+	const int			src			= m_child->compile(compiler);
+
+	for (int outElemNdx = 0; outElemNdx < outType.getNumElements(); outElemNdx++)
+		compiler.emitCopy(dst+outElemNdx, src+m_swizzle[outElemNdx], 1);
+
+	compiler.releaseTemps(tempTop);
+	return dst;
+}
+
 static int countSamplers (const VariableManager& varManager, VariableType::Type samplerType)
 {
 	int numSamplers = 0;
@@ -1619,6 +1731,77 @@ float TexLookup::getWeight (const GeneratorState& state, ConstValueRangeAccess v
 	return state.getShaderParameters().texLookupBaseWeight;
 }
 
+namespace
+{
+
+template <bool Projected, bool Lod>
+void execTexture2D (const ExecInstruction& instr, ExecRegisters& regs)
+{
+	const Sampler2D&	tex		= regs.context->getSampler2D(instr.variable);
+	const Scalar* const	s		= regs.slots[instr.src[0]+0];
+	const Scalar* const	t		= regs.slots[instr.src[0]+1];
+	const Scalar* const	w		= Projected	? regs.slots[instr.src[0]+2]	: DE_NULL;
+	const Scalar* const	lod		= Lod		? regs.slots[instr.src[1]]		: DE_NULL;
+	Scalar* const		dst[]	= { regs.slots[instr.dst+0], regs.slots[instr.dst+1], regs.slots[instr.dst+2], regs.slots[instr.dst+3] };
+
+	for (int i = 0; i < EXEC_VEC_WIDTH; i++)
+	{
+		const float		l	= Lod ? lod[i].floatVal : 0.0f;
+		const tcu::Vec4	p	= Projected ? tex.sample(s[i].floatVal/w[i].floatVal, t[i].floatVal/w[i].floatVal, l)
+										: tex.sample(s[i].floatVal, t[i].floatVal, l);
+
+		for (int comp = 0; comp < 4; comp++)
+			dst[comp][i].floatVal = p[comp];
+	}
+}
+
+template <bool Lod>
+void execTextureCube (const ExecInstruction& instr, ExecRegisters& regs)
+{
+	const SamplerCube&	tex		= regs.context->getSamplerCube(instr.variable);
+	const Scalar* const	s		= regs.slots[instr.src[0]+0];
+	const Scalar* const	t		= regs.slots[instr.src[0]+1];
+	const Scalar* const	r		= regs.slots[instr.src[0]+2];
+	const Scalar* const	lod		= Lod ? regs.slots[instr.src[1]] : DE_NULL;
+	Scalar* const		dst[]	= { regs.slots[instr.dst+0], regs.slots[instr.dst+1], regs.slots[instr.dst+2], regs.slots[instr.dst+3] };
+
+	for (int i = 0; i < EXEC_VEC_WIDTH; i++)
+	{
+		const tcu::Vec4 p = tex.sample(s[i].floatVal, t[i].floatVal, r[i].floatVal, Lod ? lod[i].floatVal : 0.0f);
+
+		for (int comp = 0; comp < 4; comp++)
+			dst[comp][i].floatVal = p[comp];
+	}
+}
+
+} // anonymous
+
+int TexLookup::compile (ShaderCompiler& compiler) const
+{
+	static const ExecInstruction::Func funcs[] =
+	{
+		execTexture2D<false, false>,	// TYPE_TEXTURE2D
+		execTexture2D<false, true>,		// TYPE_TEXTURE2D_LOD
+		execTexture2D<true, false>,		// TYPE_TEXTURE2D_PROJ
+		execTexture2D<true, true>,		// TYPE_TEXTURE2D_PROJ_LOD
+		execTextureCube<false>,			// TYPE_TEXTURECUBE
+		execTextureCube<true>			// TYPE_TEXTURECUBE_LOD
+	};
+	DE_STATIC_ASSERT(DE_LENGTH_OF_ARRAY(funcs) == TYPE_LAST);
+
+	const int		dst		= compiler.allocateTemp(m_valueType);
+	const int		tempTop	= compiler.getTempTop();
+	const int		coords	= m_coordExpr->compile(compiler);
+	const int		lodBias	= m_lodBiasExpr ? m_lodBiasExpr->compile(compiler) : -1;
+	ExecInstruction	instr	(funcs[m_type], dst, coords, lodBias, -1, 4);
+
+	instr.variable = m_sampler;
+	compiler.emit(instr);
+
+	compiler.releaseTemps(tempTop);
+	return dst;
+}
+
 void TexLookup::evaluate (ExecutionContext& execCtx)
 {
 	// Evaluate coord and bias.
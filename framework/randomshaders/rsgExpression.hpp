@@ -44,6 +44,8 @@
 namespace rsg
 {
 
+class ShaderCompiler;
+
 // \todo [2011-06-10 pyry] Declare in ShaderParameters?
 const float unusedValueWeight = 0.05f;
 
@@ -61,6 +63,9 @@ public:
 	virtual ExecConstValueAccess	getValue			(void) const			= DE_NULL;
 	virtual ExecValueAccess			getLValue			(void) const { DE_ASSERT(DE_FALSE); throw Exception("Expression::getLValue(): not L-value node"); }
 
+	// Compilation API, returns first slot of value. Value of L-value node is its storage.
+	virtual int						compile				(ShaderCompiler& compiler) const = DE_NULL;
+
 	static Expression*				createRandom		(GeneratorState& state, ConstValueRangeAccess valueRange);
 	static Expression*				createRandomLValue	(GeneratorState& state, ConstValueRangeAccess valueRange);
 };
@@ -77,6 +82,8 @@ public:
 	ExecConstValueAccess		getValue			(void) const									{ return m_valueAccess;									}
 	ExecValueAccess				getLValue			(void) const									{ return m_valueAccess;									}
 
+	int							compile				(ShaderCompiler& compiler) const;
+
 protected:
 								VariableAccess		(void) : m_variable(DE_NULL) {}
 
@@ -116,6 +123,7 @@ public:
 
 	void						evaluate			(ExecutionContext& ctx) { DE_UNREF(ctx); }
 	ExecConstValueAccess		getValue			(void) const { return m_value.getValue(VariableType::getScalarType(VariableType::TYPE_FLOAT)); }
+	int							compile				(ShaderCompiler& compiler) const;
 
 private:
 	ExecValueStorage			m_value;
@@ -134,6 +142,7 @@ public:
 
 	void						evaluate			(ExecutionContext& ctx) { DE_UNREF(ctx); }
 	ExecConstValueAccess		getValue			(void) const { return m_value.getValue(VariableType::getScalarType(VariableType::TYPE_INT)); }
+	int							compile				(ShaderCompiler& compiler) const;
 
 private:
 	ExecValueStorage			m_value;
@@ -152,6 +161,7 @@ public:
 
 	void						evaluate			(ExecutionContext& ctx) { DE_UNREF(ctx); }
 	ExecConstValueAccess		getValue			(void) const { return m_value.getValue(VariableType::getScalarType(VariableType::TYPE_BOOL)); }
+	int							compile				(ShaderCompiler& compiler) const;
 
 private:
 	ExecValueStorage			m_value;
@@ -170,6 +180,7 @@ public:
 
 	void						evaluate			(ExecutionContext& ctx);
 	ExecConstValueAccess		getValue			(void) const { return m_value.getValue(m_valueRange.getType()); }
+	int							compile				(ShaderCompiler& compiler) const;
 
 private:
 	ValueRange					m_valueRange;
@@ -195,6 +206,7 @@ public:
 
 	void						evaluate			(ExecutionContext& ctx);
 	ExecConstValueAccess		getValue			(void) const { return m_value.getValue(m_valueRange.getType()); }
+	int							compile				(ShaderCompiler& compiler) const;
 
 private:
 	ValueRange					m_valueRange;
@@ -217,6 +229,7 @@ public:
 
 	void						evaluate			(ExecutionContext& execCtx)		{ m_child->evaluate(execCtx);	}
 	ExecConstValueAccess		getValue			(void) const					{ return m_child->getValue();	}
+	int							compile				(ShaderCompiler& compiler) const;
 
 private:
 	ValueRange					m_valueRange;
@@ -236,6 +249,7 @@ public:
 
 	void						evaluate			(ExecutionContext& execCtx);
 	ExecConstValueAccess		getValue			(void) const					{ return m_value.getValue(m_outValueRange.getType()); }
+	int							compile				(ShaderCompiler& compiler) const;
 
 private:
 	ValueRange					m_outValueRange;
@@ -258,6 +272,7 @@ public:
 
 	void						evaluate			(ExecutionContext& execCtx);
 	ExecConstValueAccess		getValue			(void) const { return m_value.getValue(m_valueType); }
+	int							compile				(ShaderCompiler& compiler) const;
 
 private:
 	enum Type
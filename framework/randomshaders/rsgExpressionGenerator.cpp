@@ -60,7 +60,8 @@ void ExpressionGenerator::generate (Expression* root)
 {
 	DE_ASSERT(m_expressionStack.empty());
 
-	// Initialize stack
+	// Initialize stack, expression depth limits stack size
+	m_expressionStack.reserve(m_state.getShaderParameters().maxExpressionDepth + 1);
 	m_expressionStack.push_back(root);
 	m_state.setExpressionDepth(m_state.getExpressionDepth()+1);
 
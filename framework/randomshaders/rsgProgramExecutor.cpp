@@ -23,11 +23,13 @@
 
 #include "rsgProgramExecutor.hpp"
 #include "rsgExecutionContext.hpp"
+#include "rsgCompiledShader.hpp"
 #include "rsgVariableValue.hpp"
 #include "rsgUtils.hpp"
 #include "tcuSurface.hpp"
 #include "deMath.h"
 #include "deString.h"
+#include "deUniquePtr.hpp"
 
 #include <set>
 #include <string>
@@ -165,9 +167,10 @@ void copyVarying (ValueAccess dst, ConstStridedValueAccess<Stride> src, int comp
 }
 
 ProgramExecutor::ProgramExecutor (const tcu::PixelBufferAccess& dst, int gridWidth, int gridHeight)
-	: m_dst			(dst)
-	, m_gridWidth	(gridWidth)
-	, m_gridHeight	(gridHeight)
+	: m_dst					(dst)
+	, m_gridWidth			(gridWidth)
+	, m_gridHeight			(gridHeight)
+	, m_interpretShaders	(false)
 {
 }
 
@@ -216,6 +219,9 @@ void ProgramExecutor::execute (const Shader& vertexShader, const Shader& fragmen
 
 	VaryingStore varyingStore(numVertices);
 
+	const de::UniquePtr<CompiledShader>	compiledVertexShader	(m_interpretShaders ? DE_NULL : new CompiledShader(vertexShader));
+	const de::UniquePtr<CompiledShader>	compiledFragmentShader	(m_interpretShaders ? DE_NULL : new CompiledShader(fragmentShader));
+
 	// Execute vertex shader
 	{
 		ExecutionContext	execCtx(m_samplers2D, m_samplersCube);
@@ -252,7 +258,10 @@ void ProgramExecutor::execute (const Shader& vertexShader, const Shader& fragmen
 			}
 
 			// Execute vertex shader for packet
-			vertexShader.execute(execCtx);
+			if (compiledVertexShader)
+				compiledVertexShader->execute(execCtx);
+			else
+				vertexShader.execute(execCtx);
 
 			// Store output values
 			for (vector<const Variable*>::const_iterator i = outputs.begin(); i != outputs.end(); i++)
@@ -336,7 +345,10 @@ void ProgramExecutor::execute (const Shader& vertexShader, const Shader& fragmen
 			}
 
 			// Execute fragment shader
-			fragmentShader.execute(execCtx);
+			if (compiledFragmentShader)
+				compiledFragmentShader->execute(execCtx);
+			else
+				fragmentShader.execute(execCtx);
 
 			// Write resulting color
 			ExecConstValueAccess colorValue = execCtx.getValue(fragColorVar);
@@ -48,12 +48,16 @@ public:
 	void						setTexture				(int samplerNdx, const tcu::Texture2D* texture, const tcu::Sampler& sampler);
 	void						setTexture				(int samplerNdx, const tcu::TextureCube* texture, const tcu::Sampler& sampler);
 
+	//! Shaders are compiled to CompiledShader by default. Interpreting the tree is kept for cross-checking.
+	void						setInterpretShaders		(bool interpret)	{ m_interpretShaders = interpret;	}
+
 	void						execute					(const Shader& vertexShader, const Shader& fragmentShader, const std::vector<VariableValue>& uniforms);
 
 private:
 	tcu::PixelBufferAccess		m_dst;
 	int							m_gridWidth;
 	int							m_gridHeight;
+	bool						m_interpretShaders;
 
 	Sampler2DMap				m_samplers2D;
 	SamplerCubeMap				m_samplersCube;
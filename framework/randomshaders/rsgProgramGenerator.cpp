@@ -24,6 +24,10 @@
 #include "rsgProgramGenerator.hpp"
 #include "rsgShaderGenerator.hpp"
 #include "rsgGeneratorState.hpp"
+#include "deThread.hpp"
+#include "deAtomic.h"
+
+#include <string>
 
 using std::vector;
 
@@ -99,4 +103,109 @@ void ProgramGenerator::generate (
 	}
 }
 
+GeneratedProgram::GeneratedProgram (const ProgramParameters& programParams)
+	: m_programParams	(programParams)
+	, m_vertexShader	(Shader::TYPE_VERTEX)
+	, m_fragmentShader	(Shader::TYPE_FRAGMENT)
+{
+	ProgramGenerator generator;
+	generator.generate(m_programParams, m_vertexShader, m_fragmentShader);
+}
+
+GeneratedProgram::~GeneratedProgram (void)
+{
+}
+
+namespace
+{
+
+class GeneratorThread : public de::Thread
+{
+public:
+	GeneratorThread (const vector<ProgramParameters>& programParams, vector<GeneratedProgramSp>& programs, volatile deInt32* nextProgramNdx)
+		: m_programParams	(programParams)
+		, m_programs		(programs)
+		, m_nextProgramNdx	(nextProgramNdx)
+		, m_failed			(false)
+	{
+	}
+
+	void run (void)
+	{
+		try
+		{
+			for (;;)
+			{
+				const int programNdx = (int)deAtomicIncrement32(m_nextProgramNdx) - 1;
+
+				if (programNdx >= (int)m_programParams.size())
+					break;
+
+				// Each thread writes only to its own slots in the preallocated list.
+				m_programs[programNdx] = GeneratedProgramSp(new GeneratedProgram(m_programParams[programNdx]));
+			}
+		}
+		catch (const std::exception& e)
+		{
+			m_failed	= true;
+			m_error		= e.what();
+		}
+	}
+
+	bool								isFailed		(void) const	{ return m_failed;	}
+	const std::string&					getError		(void) const	{ return m_error;	}
+
+private:
+	const vector<ProgramParameters>&	m_programParams;
+	vector<GeneratedProgramSp>&			m_programs;
+	volatile deInt32* const				m_nextProgramNdx;
+
+	bool								m_failed;
+	std::string							m_error;
+};
+
+typedef de::SharedPtr<GeneratorThread> GeneratorThreadSp;
+
+} // anonymous
+
+void generatePrograms (const vector<ProgramParameters>& programParams, vector<GeneratedProgramSp>& programs, int numThreads)
+{
+	const int	numPrograms	= (int)programParams.size();
+
+	programs.clear();
+	programs.resize(numPrograms);
+
+	if (numThreads <= 1 || numPrograms <= 1)
+	{
+		for (int programNdx = 0; programNdx < numPrograms; programNdx++)
+			programs[programNdx] = GeneratedProgramSp(new GeneratedProgram(programParams[programNdx]));
+	}
+	else
+	{
+		volatile deInt32			nextProgramNdx	= 0;
+		vector<GeneratorThreadSp>	threads			(de::min(numThreads, numPrograms));
+		std::string					error;
+
+		for (size_t threadNdx = 0; threadNdx < threads.size(); threadNdx++)
+		{
+			threads[threadNdx] = GeneratorThreadSp(new GeneratorThread(programParams, programs, &nextProgramNdx));
+			threads[threadNdx]->start();
+		}
+
+		for (size_t threadNdx = 0; threadNdx < threads.size(); threadNdx++)
+		{
+			threads[threadNdx]->join();
+
+			if (threads[threadNdx]->isFailed() && error.empty())
+				error = threads[threadNdx]->getError();
+		}
+
+		if (!error.empty())
+		{
+			programs.clear();
+			throw Exception(error);
+		}
+	}
+}
+
 } // rsg
@@ -26,6 +26,9 @@
 #include "rsgDefs.hpp"
 #include "rsgParameters.hpp"
 #include "rsgShader.hpp"
+#include "deSharedPtr.hpp"
+
+#include <vector>
 
 namespace rsg
 {
@@ -43,6 +46,37 @@ private:
 	ProgramGenerator&			operator=				(const ProgramGenerator& other);
 };
 
+class GeneratedProgram
+{
+public:
+	explicit					GeneratedProgram		(const ProgramParameters& programParams);
+								~GeneratedProgram		(void);
+
+	const ProgramParameters&	getParameters			(void) const	{ return m_programParams;	}
+	const Shader&				getVertexShader			(void) const	{ return m_vertexShader;	}
+	const Shader&				getFragmentShader		(void) const	{ return m_fragmentShader;	}
+
+private:
+								GeneratedProgram		(const GeneratedProgram& other);
+	GeneratedProgram&			operator=				(const GeneratedProgram& other);
+
+	const ProgramParameters		m_programParams;
+	Shader						m_vertexShader;
+	Shader						m_fragmentShader;
+};
+
+typedef de::SharedPtr<GeneratedProgram> GeneratedProgramSp;
+
+/*--------------------------------------------------------------------*//*!
+ * \brief Generate programs using multiple threads.
+ *
+ * Generates one program per entry in programParams. Generator only
+ * depends on parameters and seed, so programs are identical to ones
+ * generated serially with ProgramGenerator regardless of numThreads.
+ * Programs are returned in the same order as parameters.
+ *//*--------------------------------------------------------------------*/
+void							generatePrograms		(const std::vector<ProgramParameters>& programParams, std::vector<GeneratedProgramSp>& programs, int numThreads);
+
 } // rsg
 
 #endif // _RSGPROGRAMGENERATOR_HPP
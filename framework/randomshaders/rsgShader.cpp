@@ -122,6 +122,14 @@ void Shader::execute (ExecutionContext& execCtx) const
 	m_mainFunction.getBody().execute(execCtx);
 }
 
+void Shader::compile (ShaderCompiler& compiler) const
+{
+	for (vector<Statement*>::const_reverse_iterator i = m_globalStatements.rbegin(); i != m_globalStatements.rend(); i++)
+		(*i)->compile(compiler);
+
+	m_mainFunction.getBody().compile(compiler);
+}
+
 void Function::tokenize (GeneratorState& state, TokenStream& str) const
 {
 	// Return type
@@ -95,6 +95,7 @@ public:
 	const char*					getSource			(void) const	{ return m_source.c_str();		}
 
 	void						execute				(ExecutionContext& execCtx) const;
+	void						compile				(ShaderCompiler& compiler) const;
 
 	// For generator implementation only
 	Function&					getMain				(void)			{ return m_mainFunction;		}
@@ -22,6 +22,7 @@
  *//*--------------------------------------------------------------------*/
 
 #include "rsgStatement.hpp"
+#include "rsgCompiledShader.hpp"
 #include "rsgExpressionGenerator.hpp"
 #include "rsgUtils.hpp"
 
@@ -136,6 +137,13 @@ void ExpressionStatement::execute (ExecutionContext& execCtx) const
 	m_expression->evaluate(execCtx);
 }
 
+void ExpressionStatement::compile (ShaderCompiler& compiler) const
+{
+	const int tempTop = compiler.getTempTop();
+	m_expression->compile(compiler);
+	compiler.releaseTemps(tempTop);
+}
+
 BlockStatement::BlockStatement (GeneratorState& state)
 {
 	init(state);
@@ -216,6 +224,12 @@ void BlockStatement::execute (ExecutionContext& execCtx) const
 		(*i)->execute(execCtx);
 }
 
+void BlockStatement::compile (ShaderCompiler& compiler) const
+{
+	for (vector<Statement*>::const_reverse_iterator i = m_children.rbegin(); i != m_children.rend(); i++)
+		(*i)->compile(compiler);
+}
+
 void ExpressionStatement::tokenize (GeneratorState& state, TokenStream& str) const
 {
 	DE_ASSERT(m_expression);
@@ -352,6 +366,16 @@ void DeclarationStatement::execute (ExecutionContext& execCtx) const
 	}
 }
 
+void DeclarationStatement::compile (ShaderCompiler& compiler) const
+{
+	if (m_expression)
+	{
+		const int tempTop = compiler.getTempTop();
+		compiler.emitCopy(compiler.getVariableSlot(m_variable), m_expression->compile(compiler), m_variable->getType().getScalarSize());
+		compiler.releaseTemps(tempTop);
+	}
+}
+
 ConditionalStatement::ConditionalStatement (GeneratorState&)
 	: m_condition		(DE_NULL)
 	, m_trueStatement	(DE_NULL)
@@ -524,6 +548,26 @@ void ConditionalStatement::execute (ExecutionContext& execCtx) const
 	}
 }
 
+void ConditionalStatement::compile (ShaderCompiler& compiler) const
+{
+	// Condition is copied to mask stack, so temporaries can be released before blocks.
+	{
+		const int tempTop = compiler.getTempTop();
+		compiler.beginConditional(m_condition->compile(compiler));
+		compiler.releaseTemps(tempTop);
+	}
+
+	m_trueStatement->compile(compiler);
+
+	if (m_falseStatement)
+	{
+		compiler.beginElse();
+		m_falseStatement->compile(compiler);
+	}
+
+	compiler.endConditional();
+}
+
 float ConditionalStatement::getWeight (const GeneratorState& state)
 {
 	if (!state.getProgramParameters().useConditionals)
@@ -566,4 +610,11 @@ void AssignStatement::execute (ExecutionContext& execCtx) const
 	assignMasked(execCtx.getValue(m_variable), m_valueExpr->getValue(), execCtx.getExecutionMask());
 }
 
+void AssignStatement::compile (ShaderCompiler& compiler) const
+{
+	const int tempTop = compiler.getTempTop();
+	compiler.emitAssignMasked(compiler.getVariableSlot(m_variable), m_valueExpr->compile(compiler), m_variable->getType().getScalarSize());
+	compiler.releaseTemps(tempTop);
+}
+
 } // rsg
@@ -34,6 +34,8 @@
 namespace rsg
 {
 
+class ShaderCompiler;
+
 class Statement
 {
 public:
@@ -43,6 +45,7 @@ public:
 	virtual Statement*			createNextChild		(GeneratorState& state)							= DE_NULL;
 	virtual void				tokenize			(GeneratorState& state, TokenStream& str) const	= DE_NULL;
 	virtual void				execute				(ExecutionContext& execCtx) const				= DE_NULL;
+	virtual void				compile				(ShaderCompiler& compiler) const				= DE_NULL;
 
 protected:
 };
@@ -61,6 +64,7 @@ public:
 	Statement*				createNextChild			(GeneratorState& state) { DE_UNREF(state); return DE_NULL; }
 	void					tokenize				(GeneratorState& state, TokenStream& str) const;
 	void					execute					(ExecutionContext& execCtx) const;
+	void					compile					(ShaderCompiler& compiler) const;
 
 	static float			getWeight				(const GeneratorState& state);
 
@@ -77,6 +81,7 @@ public:
 	Statement*				createNextChild			(GeneratorState& state) { DE_UNREF(state); return DE_NULL; }
 	void					tokenize				(GeneratorState& state, TokenStream& str) const;
 	void					execute					(ExecutionContext& execCtx) const;
+	void					compile					(ShaderCompiler& compiler) const;
 
 	static float			getWeight				(const GeneratorState& state);
 
@@ -97,6 +102,7 @@ public:
 	Statement*				createNextChild			(GeneratorState& state);
 	void					tokenize				(GeneratorState& state, TokenStream& str) const;
 	void					execute					(ExecutionContext& execCtx) const;
+	void					compile					(ShaderCompiler& compiler) const;
 
 	static float			getWeight				(const GeneratorState& state);
 
@@ -118,6 +124,7 @@ public:
 	Statement*				createNextChild			(GeneratorState& state);
 	void					tokenize				(GeneratorState& state, TokenStream& str) const;
 	void					execute					(ExecutionContext& execCtx) const;
+	void					compile					(ShaderCompiler& compiler) const;
 
 	static float			getWeight				(const GeneratorState& state);
 
@@ -144,6 +151,7 @@ public:
 	Statement*				createNextChild			(GeneratorState& state) { DE_UNREF(state); return DE_NULL; }
 	void					tokenize				(GeneratorState& state, TokenStream& str) const;
 	void					execute					(ExecutionContext& execCtx) const;
+	void					compile					(ShaderCompiler& compiler) const;
 
 private:
 	const Variable*			m_variable;
@@ -24,9 +24,12 @@
 #include "rsgProgramGenerator.hpp"
 #include "rsgProgramExecutor.hpp"
 #include "tcuSurface.hpp"
+#include "tcuTextureUtil.hpp"
 #include "tcuImageIO.hpp"
 #include "rsgUtils.hpp"
 #include "deStringUtil.hpp"
+#include "deClock.h"
+#include "deMemory.h"
 
 #include <iostream>
 #include <string>
@@ -34,7 +37,18 @@
 
 using std::string;
 
-void runTest (deUint32 seed)
+deUint64 renderFloat (const tcu::PixelBufferAccess& dst, const rsg::Shader& vertexShader, const rsg::Shader& fragmentShader, const std::vector<rsg::VariableValue>& uniformValues, bool interpret)
+{
+	rsg::ProgramExecutor	executor	(dst, 3, 5);
+	const deUint64			startTime	= deGetMicroseconds();
+
+	executor.setInterpretShaders(interpret);
+	executor.execute(vertexShader, fragmentShader, uniformValues);
+
+	return deGetMicroseconds() - startTime;
+}
+
+bool runTest (deUint32 seed)
 {
 	printf("Seed: %d\n", seed);
 
@@ -72,10 +86,31 @@ void runTest (deUint32 seed)
 		string fileName = string("test-") + de::toString(seed) + ".png";
 		tcu::ImageIO::savePNG(surface.getAccess(), fileName.c_str());
 		std::cout << fileName << " written\n";
+
+		// Cross-check compiled shaders against tree interpreter, results must be bit-exact.
+		{
+			const tcu::TextureFormat	format			(tcu::TextureFormat::RGBA, tcu::TextureFormat::FLOAT);
+			tcu::TextureLevel			interpreted		(format, 256, 256);
+			tcu::TextureLevel			compiled		(format, 256, 256);
+			const deUint64				interpretTime	= renderFloat(interpreted.getAccess(), vertexShader, fragmentShader, uniformValues, true);
+			const deUint64				compileTime		= renderFloat(compiled.getAccess(), vertexShader, fragmentShader, uniformValues, false);
+			const int					dataSize		= interpreted.getWidth()*interpreted.getHeight()*format.getPixelSize();
+
+			printf("Interpreted: %d us, compiled: %d us\n", (int)interpretTime, (int)compileTime);
+
+			if (deMemCmp(interpreted.getAccess().getDataPtr(), compiled.getAccess().getDataPtr(), dataSize) != 0)
+			{
+				printf("Failed: compiled shader result differs from interpreted\n");
+				return false;
+			}
+		}
+
+		return true;
 	}
 	catch (const std::exception& e)
 	{
 		printf("Failed: %s\n", e.what());
+		return false;
 	}
 }
 
@@ -83,8 +118,13 @@ int main (int argc, const char* const* argv)
 {
 	DE_UNREF(argc && argv);
 
+	int numFailed = 0;
+
 	for (int seed = 0; seed < 10; seed++)
-		runTest(seed);
+	{
+		if (!runTest(seed))
+			numFailed += 1;
+	}
 
-	return 0;
+	return numFailed == 0 ? 0 : 1;
 }
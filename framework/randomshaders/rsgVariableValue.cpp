@@ -157,15 +157,13 @@ bool ConstValueRangeAccess::isSupersetOf (const ConstValueRangeAccess& other) co
 
 ValueRange::ValueRange (const VariableType& type)
 	: m_type		(type)
-	, m_min			(type.getScalarSize())
-	, m_max			(type.getScalarSize())
+	, m_storage		(type.getScalarSize()*2)
 {
 }
 
 ValueRange::ValueRange (const VariableType& type, const ConstValueAccess& minVal, const ConstValueAccess& maxVal)
 	: m_type		(type)
-	, m_min			(type.getScalarSize())
-	, m_max			(type.getScalarSize())
+	, m_storage		(type.getScalarSize()*2)
 {
 	getMin() = minVal.value();
 	getMax() = maxVal.value();
@@ -173,8 +171,7 @@ ValueRange::ValueRange (const VariableType& type, const ConstValueAccess& minVal
 
 ValueRange::ValueRange (const VariableType& type, const Scalar* minVal, const Scalar* maxVal)
 	: m_type		(type)
-	, m_min			(type.getScalarSize())
-	, m_max			(type.getScalarSize())
+	, m_storage		(type.getScalarSize()*2)
 {
 	getMin() = ConstValueAccess(type, minVal).value();
 	getMax() = ConstValueAccess(type, maxVal).value();
@@ -182,8 +179,7 @@ ValueRange::ValueRange (const VariableType& type, const Scalar* minVal, const Sc
 
 ValueRange::ValueRange (ConstValueRangeAccess other)
 	: m_type		(other.getType())
-	, m_min			(other.getType().getScalarSize())
-	, m_max			(other.getType().getScalarSize())
+	, m_storage		(other.getType().getScalarSize()*2)
 {
 	getMin() = other.getMin().value();
 	getMax() = other.getMax().value();
@@ -144,6 +144,8 @@ public:
 	template <typename T>
 	T&							as					(int ndx)			{ DE_ASSERT(de::inBounds(ndx, 0, Stride)); return this->m_value[ndx].template as<T>();		}
 
+	Scalar*						getValuePtr			(void)				{ return this->m_value;																					}
+
 	template <int SrcStride>
 	StridedValueAccess&			operator=			(const StridedValueRead<SrcStride>& value);
 
@@ -295,15 +297,14 @@ public:
 	static void					computeIntersection	(ValueRange& dst, const ConstValueRangeAccess& a, const ConstValueRangeAccess& b);
 
 private:
-	const Scalar*				getMinPtr			(void) const	{ return m_min.empty() ? DE_NULL : &m_min[0];	}
-	const Scalar*				getMaxPtr			(void) const	{ return m_max.empty() ? DE_NULL : &m_max[0];	}
+	const Scalar*				getMinPtr			(void) const	{ return m_storage.empty() ? DE_NULL : &m_storage[0];						}
+	const Scalar*				getMaxPtr			(void) const	{ return m_storage.empty() ? DE_NULL : &m_storage[0] + m_storage.size()/2;	}
 
-	Scalar*						getMinPtr			(void)			{ return m_min.empty() ? DE_NULL : &m_min[0];	}
-	Scalar*						getMaxPtr			(void)			{ return m_max.empty() ? DE_NULL : &m_max[0];	}
+	Scalar*						getMinPtr			(void)			{ return m_storage.empty() ? DE_NULL : &m_storage[0];						}
+	Scalar*						getMaxPtr			(void)			{ return m_storage.empty() ? DE_NULL : &m_storage[0] + m_storage.size()/2;	}
 
 	VariableType				m_type;
-	std::vector<Scalar>			m_min;
-	std::vector<Scalar>			m_max;
+	std::vector<Scalar>			m_storage;	//!< Min values followed by max values, in a single allocation.
 };
 
 template <int Stride>
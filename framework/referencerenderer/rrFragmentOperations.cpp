@@ -737,6 +737,123 @@ void FragmentProcessor::executeUnsignedValueWrite (int fragNdxOffset, int numSam
 	}
 }
 
+void FragmentProcessor::executeFragmentTests (int								fragNdxOffset,
+											  int								numSamplesPerFragment,
+											  const Fragment*					inputFragments,
+											  int								numFragments,
+											  bool								doDepthTest,
+											  bool								doStencilTest,
+											  const tcu::PixelBufferAccess&		depthBuffer,
+											  const tcu::PixelBufferAccess&		stencilBuffer,
+											  FaceType							fragmentFacing,
+											  const FragmentOperationState&		state)
+{
+	const StencilState& stencilState = state.stencilStates[fragmentFacing];
+
+	// Initialize sample data in the sample register.
+
+	for (int regSampleNdx = 0; regSampleNdx < SAMPLE_REGISTER_SIZE; regSampleNdx++)
+	{
+		int fragNdx			= fragNdxOffset + regSampleNdx/numSamplesPerFragment;
+		int fragSampleNdx	= regSampleNdx % numSamplesPerFragment;
+
+		if (fragNdx < numFragments)
+		{
+			m_sampleRegister[regSampleNdx].isAlive		= (inputFragments[fragNdx].coverage & (1u << fragSampleNdx)) != 0;
+			m_sampleRegister[regSampleNdx].depthPassed	= true; // \note This will stay true if depth test is disabled.
+		}
+		else
+			m_sampleRegister[regSampleNdx].isAlive = false;
+	}
+
+	// Scissor test.
+
+	if (state.scissorTestEnabled)
+		executeScissorTest(fragNdxOffset, numSamplesPerFragment, inputFragments, state.scissorRectangle);
+
+	// Stencil test.
+
+	if (doStencilTest)
+	{
+		executeStencilCompare(fragNdxOffset, numSamplesPerFragment, inputFragments, stencilState, state.numStencilBits, stencilBuffer);
+		executeStencilSFail(fragNdxOffset, numSamplesPerFragment, inputFragments, stencilState, state.numStencilBits, stencilBuffer);
+	}
+
+	// Depth test.
+	// \note Current value of isAlive is needed for dpPass and dpFail, so it's only updated after them and not right after depth test.
+
+	if (doDepthTest)
+	{
+		executeDepthCompare(fragNdxOffset, numSamplesPerFragment, inputFragments, state.depthFunc, depthBuffer);
+
+		if (state.depthMask)
+			executeDepthWrite(fragNdxOffset, numSamplesPerFragment, inputFragments, depthBuffer);
+	}
+
+	// Do dpFail and dpPass stencil writes.
+
+	if (doStencilTest)
+		executeStencilDpFailAndPass(fragNdxOffset, numSamplesPerFragment, inputFragments, stencilState, state.numStencilBits, stencilBuffer);
+
+	// Kill the samples that failed depth test.
+
+	if (doDepthTest)
+	{
+		for (int regSampleNdx = 0; regSampleNdx < SAMPLE_REGISTER_SIZE; regSampleNdx++)
+			m_sampleRegister[regSampleNdx].isAlive = m_sampleRegister[regSampleNdx].isAlive && m_sampleRegister[regSampleNdx].depthPassed;
+	}
+}
+
+void FragmentProcessor::renderEarlyTests (const rr::MultisamplePixelBufferAccess&	msDepthBuffer,
+										  const rr::MultisamplePixelBufferAccess&	msStencilBuffer,
+										  Fragment*									fragments,
+										  int										numFragments,
+										  FaceType									fragmentFacing,
+										  const FragmentOperationState&				state)
+{
+	DE_ASSERT(fragmentFacing < FACETYPE_LAST);
+	DE_ASSERT(state.numStencilBits < 32); // code bitshifts numStencilBits, avoid undefined behavior
+
+	const tcu::PixelBufferAccess&	depthBuffer			= msDepthBuffer.raw();
+	const tcu::PixelBufferAccess&	stencilBuffer		= msStencilBuffer.raw();
+
+	const bool						hasDepth			= depthBuffer.getWidth() > 0	&& depthBuffer.getHeight() > 0		&& depthBuffer.getDepth() > 0;
+	const bool						hasStencil			= stencilBuffer.getWidth() > 0	&& stencilBuffer.getHeight() > 0	&& stencilBuffer.getDepth() > 0;
+	const bool						doDepthTest			= hasDepth && state.depthTestEnabled;
+	const bool						doStencilTest		= hasStencil && state.stencilTestEnabled;
+
+	DE_ASSERT(hasDepth || hasStencil);
+	DE_ASSERT(!hasDepth || !hasStencil || (depthBuffer.getWidth() == stencilBuffer.getWidth() && depthBuffer.getHeight() == stencilBuffer.getHeight() && depthBuffer.getDepth() == stencilBuffer.getDepth()));
+
+	// Combined formats must be separated beforehand
+	DE_ASSERT(!hasDepth || (!tcu::isCombinedDepthStencilType(depthBuffer.getFormat().type) && depthBuffer.getFormat().order == tcu::TextureFormat::D));
+	DE_ASSERT(!hasStencil || (!tcu::isCombinedDepthStencilType(stencilBuffer.getFormat().type) && stencilBuffer.getFormat().order == tcu::TextureFormat::S));
+
+	const int						numSamplesPerFragment	= hasDepth ? depthBuffer.getWidth() : stencilBuffer.getWidth();
+	const int						totalNumSamples			= numFragments*numSamplesPerFragment;
+	const int						numSampleGroups			= (totalNumSamples - 1) / SAMPLE_REGISTER_SIZE + 1; // \note totalNumSamples/SAMPLE_REGISTER_SIZE rounded up.
+
+	DE_ASSERT(SAMPLE_REGISTER_SIZE % numSamplesPerFragment == 0);
+
+	for (int sampleGroupNdx = 0; sampleGroupNdx < numSampleGroups; sampleGroupNdx++)
+	{
+		const int groupFirstFragNdx = (sampleGroupNdx*SAMPLE_REGISTER_SIZE) / numSamplesPerFragment;
+
+		executeFragmentTests(groupFirstFragNdx, numSamplesPerFragment, fragments, numFragments, doDepthTest, doStencilTest, depthBuffer, stencilBuffer, fragmentFacing, state);
+
+		// Write surviving samples back to coverage.
+
+		for (int regSampleNdx = 0; regSampleNdx < SAMPLE_REGISTER_SIZE; regSampleNdx++)
+		{
+			const int fragNdx		= groupFirstFragNdx + regSampleNdx/numSamplesPerFragment;
+			const int fragSampleNdx	= regSampleNdx % numSamplesPerFragment;
+
+			if (fragNdx < numFragments && !m_sampleRegister[regSampleNdx].isAlive)
+				fragments[fragNdx].coverage &= ~(1u << fragSampleNdx);
+		}
+	}
+}
+
 void FragmentProcessor::render (const rr::MultisamplePixelBufferAccess&		msColorBuffer,
 								const rr::MultisamplePixelBufferAccess&		msDepthBuffer,
 								const rr::MultisamplePixelBufferAccess&		msStencilBuffer,
@@ -771,7 +888,6 @@ void FragmentProcessor::render (const rr::MultisamplePixelBufferAccess&		msColor
 	int						numSamplesPerFragment		= colorBuffer.getWidth();
 	int						totalNumSamples				= numFragments*numSamplesPerFragment;
 	int						numSampleGroups				= (totalNumSamples - 1) / SAMPLE_REGISTER_SIZE + 1; // \note totalNumSamples/SAMPLE_REGISTER_SIZE rounded up.
-	const StencilState&		stencilState				= state.stencilStates[fragmentFacing];
 	Vec4					colorMaskFactor				(state.colorMask[0] ? 1.0f : 0.0f, state.colorMask[1] ? 1.0f : 0.0f, state.colorMask[2] ? 1.0f : 0.0f, state.colorMask[3] ? 1.0f : 0.0f);
 	Vec4					colorMaskNegationFactor		(state.colorMask[0] ? 0.0f : 1.0f, state.colorMask[1] ? 0.0f : 1.0f, state.colorMask[2] ? 0.0f : 1.0f, state.colorMask[3] ? 0.0f : 1.0f);
 	bool					sRGBTarget					= state.sRGBEnabled && tcu::isSRGB(colorBuffer.getFormat());
@@ -786,58 +902,9 @@ void FragmentProcessor::render (const rr::MultisamplePixelBufferAccess&		msColor
 		// The index of the fragment of the sample at the beginning of m_sampleRegisters.
 		int groupFirstFragNdx = (sampleGroupNdx*SAMPLE_REGISTER_SIZE) / numSamplesPerFragment;
 
-		// Initialize sample data in the sample register.
-
-		for (int regSampleNdx = 0; regSampleNdx < SAMPLE_REGISTER_SIZE; regSampleNdx++)
-		{
-			int fragNdx			= groupFirstFragNdx + regSampleNdx/numSamplesPerFragment;
-			int fragSampleNdx	= regSampleNdx % numSamplesPerFragment;
-
-			if (fragNdx < numFragments)
-			{
-				m_sampleRegister[regSampleNdx].isAlive		= (inputFragments[fragNdx].coverage & (1u << fragSampleNdx)) != 0;
-				m_sampleRegister[regSampleNdx].depthPassed	= true; // \note This will stay true if depth test is disabled.
-			}
-			else
-				m_sampleRegister[regSampleNdx].isAlive = false;
-		}
-
-		// Scissor test.
-
-		if (state.scissorTestEnabled)
-			executeScissorTest(groupFirstFragNdx, numSamplesPerFragment, inputFragments, state.scissorRectangle);
-
-		// Stencil test.
-
-		if (doStencilTest)
-		{
-			executeStencilCompare(groupFirstFragNdx, numSamplesPerFragment, inputFragments, stencilState, state.numStencilBits, stencilBuffer);
-			executeStencilSFail(groupFirstFragNdx, numSamplesPerFragment, inputFragments, stencilState, state.numStencilBits, stencilBuffer);
-		}
+		// Scissor, stencil and depth tests.
 
-		// Depth test.
-		// \note Current value of isAlive is needed for dpPass and dpFail, so it's only updated after them and not right after depth test.
-
-		if (doDepthTest)
-		{
-			executeDepthCompare(groupFirstFragNdx, numSamplesPerFragment, inputFragments, state.depthFunc, depthBuffer);
-
-			if (state.depthMask)
-				executeDepthWrite(groupFirstFragNdx, numSamplesPerFragment, inputFragments, depthBuffer);
-		}
-
-		// Do dpFail and dpPass stencil writes.
-
-		if (doStencilTest)
-			executeStencilDpFailAndPass(groupFirstFragNdx, numSamplesPerFragment, inputFragments, stencilState, state.numStencilBits, stencilBuffer);
-
-		// Kill the samples that failed depth test.
-
-		if (doDepthTest)
-		{
-			for (int regSampleNdx = 0; regSampleNdx < SAMPLE_REGISTER_SIZE; regSampleNdx++)
-				m_sampleRegister[regSampleNdx].isAlive = m_sampleRegister[regSampleNdx].isAlive && m_sampleRegister[regSampleNdx].depthPassed;
-		}
+		executeFragmentTests(groupFirstFragNdx, numSamplesPerFragment, inputFragments, numFragments, doDepthTest, doStencilTest, depthBuffer, stencilBuffer, fragmentFacing, state);
 
 		// Paint fragments to target
 
@@ -92,6 +92,10 @@ void clearMultisampleStencilBuffer		(const tcu::PixelBufferAccess& dst, int
  * FragmentProcessor.render() draws a given set of fragments. No two
  * fragments given in one render() call should have the same pixel
  * coordinates coordinates, and they must all have the same facing.
+ *
+ * renderEarlyTests() runs only the per-fragment tests, for rendering
+ * with early fragment tests. Fragments are then drawn with render() with
+ * depth and stencil tests disabled.
  *//*--------------------------------------------------------------------*/
 class FragmentProcessor
 {
@@ -106,6 +110,14 @@ public:
 									 FaceType									fragmentFacing,
 									 const FragmentOperationState&				state);
 
+	//! Run scissor, stencil and depth tests with their buffer writes. Coverage bits of samples that failed are cleared.
+	void		renderEarlyTests	(const rr::MultisamplePixelBufferAccess&	depthMultisampleBuffer,
+									 const rr::MultisamplePixelBufferAccess&	stencilMultisampleBuffer,
+									 Fragment*									fragments,
+									 int										numFragments,
+									 FaceType									fragmentFacing,
+									 const FragmentOperationState&				state);
+
 private:
 	enum
 	{
@@ -131,6 +143,8 @@ private:
 
 	// These functions operate on the values in m_sampleRegister and, in some cases, the buffers.
 
+	void		executeFragmentTests			(int fragNdxOffset, int numSamplesPerFragment, const Fragment* inputFragments, int numFragments, bool doDepthTest, bool doStencilTest, const tcu::PixelBufferAccess& depthBuffer, const tcu::PixelBufferAccess& stencilBuffer, FaceType fragmentFacing, const FragmentOperationState& state);
+
 	void		executeScissorTest				(int fragNdxOffset, int numSamplesPerFragment, const Fragment* inputFragments, const WindowRectangle& scissorRect);
 	void		executeStencilCompare			(int fragNdxOffset, int numSamplesPerFragment, const Fragment* inputFragments, const StencilState& stencilState, int numStencilBits, const tcu::ConstPixelBufferAccess& stencilBuffer);
 	void		executeStencilSFail				(int fragNdxOffset, int numSamplesPerFragment, const Fragment* inputFragments, const StencilState& stencilState, int numStencilBits, const tcu::PixelBufferAccess& stencilBuffer);
@@ -31,6 +31,7 @@
 #include "deMemory.h"
 
 #include <set>
+#include <algorithm>
 
 namespace rr
 {
@@ -88,12 +89,185 @@ bool isEmpty (const rr::MultisampleConstPixelBufferAccess& access)
 	return access.raw().getWidth() == 0 || access.raw().getHeight() == 0 || access.raw().getDepth() == 0;
 }
 
+deUint32 getFloatBits (float value)
+{
+	deUint32 bits;
+	deMemcpy(&bits, &value, sizeof(bits));
+	return bits;
+}
+
+/*--------------------------------------------------------------------*//*!
+ * \brief Coarse depth buffer for rejecting fragments before depth test
+ *
+ * Keeps conservative bounds of depth buffer values per tile. Tile bounds
+ * are read from the depth buffer when tile is first used, and widened
+ * with update() when depth buffer is written. All depth writes must be
+ * reported, so hierarchy is only valid for the duration of one draw.
+ *
+ * Depth values are compared as keys that have the same ordering as
+ * values compared by FragmentProcessor: bit patterns of non-negative
+ * floats for floating point buffers, and stored integer values for
+ * other formats.
+ *//*--------------------------------------------------------------------*/
+class DepthHierarchy
+{
+public:
+	enum
+	{
+		TILE_SIZE_LOG2	= 3
+	};
+
+	explicit				DepthHierarchy		(const tcu::PixelBufferAccess& depthBuffer);
+
+	deUint32				getFragmentKey		(float depth) const;
+	bool					isRejected			(int x, int y, TestFunc depthFunc, deUint32 minKey, deUint32 maxKey);
+	void					update				(int x, int y);
+
+private:
+	struct Tile
+	{
+		deUint32			minKey;
+		deUint32			maxKey;
+		bool				isValid;
+	};
+
+	deUint32				getBufferKey		(int sampleNdx, int x, int y) const;
+	Tile&					getTile				(int x, int y);
+
+	const tcu::PixelBufferAccess	m_depthBuffer;	//!< Multisample access, see rrMultisamplePixelBufferAccess
+	const bool				m_isFloat;
+	const int				m_numTilesX;
+	std::vector<Tile>		m_tiles;		//!< Allocated on first use
+};
+
+DepthHierarchy::DepthHierarchy (const tcu::PixelBufferAccess& depthBuffer)
+	: m_depthBuffer	(depthBuffer)
+	, m_isFloat		(depthBuffer.getFormat().type == tcu::TextureFormat::FLOAT || depthBuffer.getFormat().type == tcu::TextureFormat::FLOAT_UNSIGNED_INT_24_8_REV)
+	, m_numTilesX	(deDivRoundUp32(depthBuffer.getHeight(), 1 << TILE_SIZE_LOG2))
+{
+}
+
+deUint32 DepthHierarchy::getFragmentKey (float depth) const
+{
+	if (m_isFloat)
+	{
+		// \note Adding zero turns -0 into +0
+		return getFloatBits(de::clamp(depth, 0.0f, 1.0f) + 0.0f);
+	}
+	else
+	{
+		// Same conversion as in FragmentProcessor
+		deUint32				buffer[2];
+		tcu::PixelBufferAccess	access	(m_depthBuffer.getFormat(), 1, 1, 1, &buffer);
+
+		DE_ASSERT(sizeof(buffer) >= (size_t)m_depthBuffer.getFormat().getPixelSize());
+
+		access.setPixDepth(depth, 0, 0, 0);
+		return access.getPixelUint(0, 0, 0).x();
+	}
+}
+
+deUint32 DepthHierarchy::getBufferKey (int sampleNdx, int x, int y) const
+{
+	if (m_isFloat)
+		return getFloatBits(m_depthBuffer.getPixDepth(sampleNdx, x, y) + 0.0f);
+	else
+		return m_depthBuffer.getPixelUint(sampleNdx, x, y).x();
+}
+
+DepthHierarchy::Tile& DepthHierarchy::getTile (int x, int y)
+{
+	if (m_tiles.empty())
+	{
+		const int	numTilesY	= deDivRoundUp32(m_depthBuffer.getDepth(), 1 << TILE_SIZE_LOG2);
+		Tile		invalidTile;
+
+		invalidTile.minKey	= 0;
+		invalidTile.maxKey	= 0;
+		invalidTile.isValid	= false;
+
+		m_tiles.resize((size_t)(m_numTilesX * numTilesY), invalidTile);
+	}
+
+	{
+		const int	tileX	= x >> TILE_SIZE_LOG2;
+		const int	tileY	= y >> TILE_SIZE_LOG2;
+		Tile&		tile	= m_tiles[tileY * m_numTilesX + tileX];
+
+		if (!tile.isValid)
+		{
+			const int	xBegin	= tileX << TILE_SIZE_LOG2;
+			const int	yBegin	= tileY << TILE_SIZE_LOG2;
+			const int	xEnd	= de::min(xBegin + (1 << TILE_SIZE_LOG2), m_depthBuffer.getHeight());
+			const int	yEnd	= de::min(yBegin + (1 << TILE_SIZE_LOG2), m_depthBuffer.getDepth());
+
+			tile.minKey		= ~0u;
+			tile.maxKey		= 0u;
+			tile.isValid	= true;
+
+			for (int py = yBegin; py < yEnd; py++)
+			for (int px = xBegin; px < xEnd; px++)
+			for (int sampleNdx = 0; sampleNdx < m_depthBuffer.getWidth(); sampleNdx++)
+			{
+				const deUint32 key = getBufferKey(sampleNdx, px, py);
+
+				tile.minKey	= de::min(tile.minKey, key);
+				tile.maxKey	= de::max(tile.maxKey, key);
+			}
+		}
+
+		return tile;
+	}
+}
+
+//! Returns true if depth test would fail for all fragment depths in [minKey, maxKey] at pixel (x, y).
+bool DepthHierarchy::isRejected (int x, int y, TestFunc depthFunc, deUint32 minKey, deUint32 maxKey)
+{
+	switch (depthFunc)
+	{
+		case TESTFUNC_NEVER:	return true;
+		case TESTFUNC_LESS:		return minKey >= getTile(x, y).maxKey;
+		case TESTFUNC_LEQUAL:	return minKey >  getTile(x, y).maxKey;
+		case TESTFUNC_GREATER:	return maxKey <= getTile(x, y).minKey;
+		case TESTFUNC_GEQUAL:	return maxKey <  getTile(x, y).minKey;
+		default:
+			return false;
+	}
+}
+
+//! Widen tile bounds with the current depth buffer values of pixel (x, y).
+void DepthHierarchy::update (int x, int y)
+{
+	if (m_tiles.empty() || !m_tiles[(y >> TILE_SIZE_LOG2) * m_numTilesX + (x >> TILE_SIZE_LOG2)].isValid)
+		return; // Tile will be read from buffer when needed
+
+	{
+		Tile& tile = getTile(x, y);
+
+		for (int sampleNdx = 0; sampleNdx < m_depthBuffer.getWidth(); sampleNdx++)
+		{
+			const deUint32 key = getBufferKey(sampleNdx, x, y);
+
+			tile.minKey	= de::min(tile.minKey, key);
+			tile.maxKey	= de::max(tile.maxKey, key);
+		}
+	}
+}
+
 struct DrawContext
 {
-	int primitiveID;
+	int							primitiveID;
+
+	bool						earlyFragmentTests;		//!< Run depth and stencil tests before shading
+	FragmentOperationState		postShadingFragOps;		//!< Fragment operations for shaded fragments
+	DepthHierarchy*				depthHierarchy;			//!< Used with early fragment tests if available
+	RenderStatistics*			statistics;
 
 	DrawContext (void)
-		: primitiveID(0)
+		: primitiveID			(0)
+		, earlyFragmentTests	(false)
+		, depthHierarchy		(DE_NULL)
+		, statistics			(DE_NULL)
 	{
 	}
 };
@@ -857,14 +1031,57 @@ void transformClipCoordsToWindowCoords (const RenderState& state, ContainerType&
 		transformPrimitiveClipCoordsToWindowCoords(state, *it);
 }
 
-void makeSharedVerticeDistinct (VertexPacket*& packet, std::set<VertexPacket*, std::less<void*> >& vertices, VertexPacketAllocator& vpalloc)
+//! Set of vertex packets
+class VertexPacketSet
 {
-	// distinct
-	if (vertices.find(packet) == vertices.end())
+public:
+	//! Returns false if packet was already in the set
+	bool insert (VertexPacket* packet)
 	{
-		vertices.insert(packet);
+		return m_packets.insert(packet).second;
 	}
-	else
+
+private:
+	std::set<VertexPacket*, std::less<void*> >	m_packets;
+};
+
+//! Set of vertex packets in a vertex batch. Batch packets must be in ascending address order.
+class VertexBatchPacketSet
+{
+public:
+	VertexBatchPacketSet (VertexPacket* const* packets, size_t numPackets, std::vector<bool>& isInSet)
+		: m_packets		(packets)
+		, m_numPackets	(numPackets)
+		, m_isInSet		(isInSet)
+	{
+		m_isInSet.assign(numPackets, false);
+	}
+
+	//! Returns false if packet was already in the set
+	bool insert (VertexPacket* packet)
+	{
+		const size_t ndx = (size_t)(std::lower_bound(m_packets, m_packets + m_numPackets, packet, std::less<void*>()) - m_packets);
+
+		DE_ASSERT(ndx < m_numPackets && m_packets[ndx] == packet);
+
+		if (m_isInSet[ndx])
+			return false;
+
+		m_isInSet[ndx] = true;
+		return true;
+	}
+
+private:
+	VertexPacket* const*	m_packets;
+	const size_t			m_numPackets;
+	std::vector<bool>&		m_isInSet;
+};
+
+template <typename VertexSet>
+void makeSharedVerticeDistinct (VertexPacket*& packet, VertexSet& vertices, VertexPacketAllocator& vpalloc)
+{
+	// distinct
+	if (!vertices.insert(packet))
 	{
 		VertexPacket* newPacket = vpalloc.alloc();
 
@@ -881,29 +1098,30 @@ void makeSharedVerticeDistinct (VertexPacket*& packet, std::set<VertexPacket*, s
 	}
 }
 
-void makeSharedVerticesDistinct (pa::Triangle& target, std::set<VertexPacket*, std::less<void*> >& vertices, VertexPacketAllocator& vpalloc)
+template <typename VertexSet>
+void makeSharedVerticesDistinct (pa::Triangle& target, VertexSet& vertices, VertexPacketAllocator& vpalloc)
 {
 	makeSharedVerticeDistinct(target.v0, vertices, vpalloc);
 	makeSharedVerticeDistinct(target.v1, vertices, vpalloc);
 	makeSharedVerticeDistinct(target.v2, vertices, vpalloc);
 }
 
-void makeSharedVerticesDistinct (pa::Line& target, std::set<VertexPacket*, std::less<void*> >& vertices, VertexPacketAllocator& vpalloc)
+template <typename VertexSet>
+void makeSharedVerticesDistinct (pa::Line& target, VertexSet& vertices, VertexPacketAllocator& vpalloc)
 {
 	makeSharedVerticeDistinct(target.v0, vertices, vpalloc);
 	makeSharedVerticeDistinct(target.v1, vertices, vpalloc);
 }
 
-void makeSharedVerticesDistinct (pa::Point& target, std::set<VertexPacket*, std::less<void*> >& vertices, VertexPacketAllocator& vpalloc)
+template <typename VertexSet>
+void makeSharedVerticesDistinct (pa::Point& target, VertexSet& vertices, VertexPacketAllocator& vpalloc)
 {
 	makeSharedVerticeDistinct(target.v0, vertices, vpalloc);
 }
 
-template <typename ContainerType>
-void makeSharedVerticesDistinct (ContainerType& list, VertexPacketAllocator& vpalloc)
+template <typename ContainerType, typename VertexSet>
+void makeSharedVerticesDistinct (ContainerType& list, VertexSet& vertices, VertexPacketAllocator& vpalloc)
 {
-	std::set<VertexPacket*, std::less<void*> > vertices;
-
 	for (typename ContainerType::iterator it = list.begin(); it != list.end(); ++it)
 		makeSharedVerticesDistinct(*it, vertices, vpalloc);
 }
@@ -1022,7 +1240,7 @@ static float findPrimitiveMinimumResolvableDifference (const pa::Triangle& trian
 	return 0.0f;
 }
 
-void writeFragmentPackets (const RenderState&					state,
+void writeFragmentPackets (const FragmentOperationState&		fragOps,
 						   const RenderTarget&					renderTarget,
 						   const Program&						program,
 						   const FragmentPacket*				fragmentPackets,
@@ -1062,7 +1280,7 @@ void writeFragmentPackets (const RenderState&					state,
 
 	// Set per output output values
 	{
-		rr::FragmentOperationState noStencilDepthWriteState(state.fragOps);
+		rr::FragmentOperationState noStencilDepthWriteState(fragOps);
 		noStencilDepthWriteState.depthMask						= false;
 		noStencilDepthWriteState.stencilStates[facetype].sFail	= STENCILOP_KEEP;
 		noStencilDepthWriteState.stencilStates[facetype].dpFail	= STENCILOP_KEEP;
@@ -1072,7 +1290,7 @@ void writeFragmentPackets (const RenderState&					state,
 		for (size_t outputNdx = 0; outputNdx < numOutputs; ++outputNdx)
 		{
 			// Only the last output-pass has default state, other passes have stencil & depth writemask=0
-			const rr::FragmentOperationState& fragOpsState = (outputNdx == numOutputs-1) ? (state.fragOps) : (noStencilDepthWriteState);
+			const rr::FragmentOperationState& fragOpsState = (outputNdx == numOutputs-1) ? (fragOps) : (noStencilDepthWriteState);
 
 			for (int packetNdx = 0; packetNdx < numRasterizedPackets; ++packetNdx)
 			for (int fragNdx = 0; fragNdx < 4; fragNdx++)
@@ -1095,12 +1313,179 @@ void writeFragmentPackets (const RenderState&					state,
 	}
 }
 
+int countLiveFragments (const FragmentPacket* packets, int numPackets, int numSamples)
+{
+	int numFragments = 0;
+
+	for (int packetNdx = 0; packetNdx < numPackets; ++packetNdx)
+	for (int fragNdx = 0; fragNdx < 4; fragNdx++)
+	{
+		if (getCoverageAnyFragmentSampleLive(packets[packetNdx].coverage, numSamples, fragNdx%2, fragNdx/2))
+			numFragments += 1;
+	}
+
+	return numFragments;
+}
+
+bool canRejectWithDepthHierarchy (const FragmentOperationState& fragOps, const RenderTarget& renderTarget, FaceType facetype)
+{
+	// Fragments failing depth test may still update stencil
+	if (fragOps.stencilTestEnabled && !isEmpty(renderTarget.getStencilBuffer()))
+	{
+		if (fragOps.stencilStates[facetype].sFail != STENCILOP_KEEP || fragOps.stencilStates[facetype].dpFail != STENCILOP_KEEP)
+			return false;
+	}
+
+	return true;
+}
+
+/*--------------------------------------------------------------------*//*!
+ * \brief Run depth and stencil tests before shading, if enabled for draw
+ *
+ * Coverage of fragments that failed tests is cleared. Packets that have
+ * live samples left are moved to the beginning of packet and depth
+ * buffers. Returns number of packets to shade.
+ *//*--------------------------------------------------------------------*/
+int executeEarlyFragmentTests (const RenderTarget&				renderTarget,
+							   const FragmentOperationState&	fragOps,
+							   FaceType							facetype,
+							   int								numPackets,
+							   RasterizationInternalBuffers&	buffers,
+							   DrawContext&						drawContext)
+{
+	const int				numSamples			= renderTarget.getNumSamples();
+	const int				numRasterized		= countLiveFragments(&buffers.fragmentPackets[0], numPackets, numSamples);
+	DepthHierarchy* const	depthHierarchy		= canRejectWithDepthHierarchy(fragOps, renderTarget, facetype) ? drawContext.depthHierarchy : DE_NULL;
+	FragmentPacket* const	packets				= &buffers.fragmentPackets[0];
+	float* const			depthValues			= buffers.fragmentDepthBuffer;
+	Fragment* const			fragments			= &buffers.shadedFragments[0];
+	int						numFragments		= 0;
+	int						numHiZKilled		= 0;
+	int						numPacketsLeft		= 0;
+
+	if (drawContext.statistics)
+		drawContext.statistics->numRasterizedFragments += (deUint64)numRasterized;
+
+	if (!drawContext.earlyFragmentTests)
+	{
+		if (drawContext.statistics)
+			drawContext.statistics->numShadedFragments += (deUint64)numRasterized;
+
+		return numPackets;
+	}
+
+	// Coarse rejection and fragments for per-sample tests
+
+	for (int packetNdx = 0; packetNdx < numPackets; ++packetNdx)
+	for (int fragNdx = 0; fragNdx < 4; fragNdx++)
+	{
+		FragmentPacket&	packet	= packets[packetNdx];
+		const int		xo		= fragNdx%2;
+		const int		yo		= fragNdx/2;
+
+		if (!getCoverageAnyFragmentSampleLive(packet.coverage, numSamples, xo, yo))
+			continue;
+
+		if (depthHierarchy)
+		{
+			const float*	sampleDepths	= &depthValues[(packetNdx*4 + fragNdx)*numSamples];
+			float			minDepth		= sampleDepths[0];
+			float			maxDepth		= sampleDepths[0];
+
+			for (int sampleNdx = 1; sampleNdx < numSamples; sampleNdx++)
+			{
+				minDepth = de::min(minDepth, sampleDepths[sampleNdx]);
+				maxDepth = de::max(maxDepth, sampleDepths[sampleNdx]);
+			}
+
+			if (depthHierarchy->isRejected(packet.position.x() + xo, packet.position.y() + yo, fragOps.depthFunc, depthHierarchy->getFragmentKey(minDepth), depthHierarchy->getFragmentKey(maxDepth)))
+			{
+				packet.coverage &= ~getCoverageFragmentSampleBits(numSamples, xo, yo);
+				numHiZKilled += 1;
+				continue;
+			}
+		}
+
+		{
+			Fragment& fragment		= fragments[numFragments++];
+
+			fragment.pixelCoord		= packet.position + tcu::IVec2(xo, yo);
+			fragment.coverage		= (deUint32)((packet.coverage & getCoverageFragmentSampleBits(numSamples, xo, yo)) >> getCoverageOffset(numSamples, xo, yo));
+			fragment.sampleDepths	= (depthValues) ? (&depthValues[(packetNdx*4 + fragNdx)*numSamples]) : (DE_NULL);
+		}
+	}
+
+	// Per-sample tests
+
+	if (numFragments > 0)
+	{
+		FragmentProcessor fragProcessor;
+		fragProcessor.renderEarlyTests(renderTarget.getDepthBuffer(), renderTarget.getStencilBuffer(), fragments, numFragments, facetype, fragOps);
+	}
+
+	// Copy surviving samples back to packets and drop empty packets
+
+	{
+		const bool	updateHierarchy	= drawContext.depthHierarchy && fragOps.depthMask;
+		int			fragmentNdx		= 0;
+
+		for (int packetNdx = 0; packetNdx < numPackets; ++packetNdx)
+		{
+			FragmentPacket& packet = packets[packetNdx];
+
+			for (int fragNdx = 0; fragNdx < 4; fragNdx++)
+			{
+				const int xo = fragNdx%2;
+				const int yo = fragNdx/2;
+
+				if (getCoverageAnyFragmentSampleLive(packet.coverage, numSamples, xo, yo))
+				{
+					const Fragment& fragment = fragments[fragmentNdx++];
+
+					packet.coverage &= ~getCoverageFragmentSampleBits(numSamples, xo, yo);
+					packet.coverage |= ((deUint64)fragment.coverage) << getCoverageOffset(numSamples, xo, yo);
+
+					if (updateHierarchy && fragment.coverage != 0)
+						drawContext.depthHierarchy->update(fragment.pixelCoord.x(), fragment.pixelCoord.y());
+				}
+			}
+
+			if (packet.coverage != 0)
+			{
+				if (numPacketsLeft != packetNdx)
+				{
+					packets[numPacketsLeft] = packet;
+
+					if (depthValues)
+						deMemcpy(&depthValues[numPacketsLeft*4*numSamples], &depthValues[packetNdx*4*numSamples], sizeof(float)*4*numSamples);
+				}
+
+				numPacketsLeft += 1;
+			}
+		}
+
+		DE_ASSERT(fragmentNdx == numFragments);
+	}
+
+	if (drawContext.statistics)
+	{
+		const int numShaded = countLiveFragments(packets, numPacketsLeft, numSamples);
+
+		drawContext.statistics->numShadedFragments		+= (deUint64)numShaded;
+		drawContext.statistics->numEarlyKilledFragments	+= (deUint64)(numRasterized - numShaded);
+		drawContext.statistics->numHiZKilledFragments	+= (deUint64)numHiZKilled;
+	}
+
+	return numPacketsLeft;
+}
+
 void rasterizePrimitive (const RenderState&					state,
 						 const RenderTarget&				renderTarget,
 						 const Program&						program,
 						 const pa::Triangle&				triangle,
 						 const tcu::IVec4&					renderTargetRect,
-						 RasterizationInternalBuffers&		buffers)
+						 RasterizationInternalBuffers&		buffers,
+						 DrawContext&						drawContext)
 {
 	const int			numSamples		= renderTarget.getNumSamples();
 	const float			depthClampMin	= de::min(state.viewport.zn, state.viewport.zf);
@@ -1148,6 +1533,13 @@ void rasterizePrimitive (const RenderState&					state,
 			for (int sampleNdx = 0; sampleNdx < numRasterizedPackets * 4 * numSamples; ++sampleNdx)
 				buffers.fragmentDepthBuffer[sampleNdx] = de::clamp(buffers.fragmentDepthBuffer[sampleNdx] + depthOffset, 0.0f, 1.0f);
 
+		// Early fragment tests
+
+		numRasterizedPackets = executeEarlyFragmentTests(renderTarget, state.fragOps, visibleFace, numRasterizedPackets, buffers, drawContext);
+
+		if (!numRasterizedPackets)
+			continue; // All fragments killed.
+
 		// Shade
 
 		program.fragmentShader->shadeFragments(&buffers.fragmentPackets[0], numRasterizedPackets, shadingContext);
@@ -1159,7 +1551,7 @@ void rasterizePrimitive (const RenderState&					state,
 
 		// Handle fragment shader outputs
 
-		writeFragmentPackets(state, renderTarget, program, &buffers.fragmentPackets[0], numRasterizedPackets, visibleFace, buffers.shaderOutputs, buffers.fragmentDepthBuffer, buffers.shadedFragments);
+		writeFragmentPackets(drawContext.postShadingFragOps, renderTarget, program, &buffers.fragmentPackets[0], numRasterizedPackets, visibleFace, buffers.shaderOutputs, buffers.fragmentDepthBuffer, buffers.shadedFragments);
 	}
 }
 
@@ -1168,7 +1560,8 @@ void rasterizePrimitive (const RenderState&					state,
 						 const Program&						program,
 						 const pa::Line&					line,
 						 const tcu::IVec4&					renderTargetRect,
-						 RasterizationInternalBuffers&		buffers)
+						 RasterizationInternalBuffers&		buffers,
+						 DrawContext&						drawContext)
 {
 	const int					numSamples			= renderTarget.getNumSamples();
 	const float					depthClampMin		= de::min(state.viewport.zn, state.viewport.zf);
@@ -1201,6 +1594,13 @@ void rasterizePrimitive (const RenderState&					state,
 		if (!numRasterizedPackets)
 			break; // Rasterization finished.
 
+		// Early fragment tests
+
+		numRasterizedPackets = executeEarlyFragmentTests(renderTarget, state.fragOps, rr::FACETYPE_FRONT, numRasterizedPackets, buffers, drawContext);
+
+		if (!numRasterizedPackets)
+			continue; // All fragments killed.
+
 		// Shade
 
 		program.fragmentShader->shadeFragments(&buffers.fragmentPackets[0], numRasterizedPackets, shadingContext);
@@ -1212,7 +1612,7 @@ void rasterizePrimitive (const RenderState&					state,
 
 		// Handle fragment shader outputs
 
-		writeFragmentPackets(state, renderTarget, program, &buffers.fragmentPackets[0], numRasterizedPackets, rr::FACETYPE_FRONT, buffers.shaderOutputs, buffers.fragmentDepthBuffer, buffers.shadedFragments);
+		writeFragmentPackets(drawContext.postShadingFragOps, renderTarget, program, &buffers.fragmentPackets[0], numRasterizedPackets, rr::FACETYPE_FRONT, buffers.shaderOutputs, buffers.fragmentDepthBuffer, buffers.shadedFragments);
 	}
 }
 
@@ -1221,7 +1621,8 @@ void rasterizePrimitive (const RenderState&					state,
 						 const Program&						program,
 						 const pa::Point&					point,
 						 const tcu::IVec4&					renderTargetRect,
-						 RasterizationInternalBuffers&		buffers)
+						 RasterizationInternalBuffers&		buffers,
+						 DrawContext&						drawContext)
 {
 	const int			numSamples		= renderTarget.getNumSamples();
 	const float			depthClampMin	= de::min(state.viewport.zn, state.viewport.zf);
@@ -1266,6 +1667,13 @@ void rasterizePrimitive (const RenderState&					state,
 		if (!numRasterizedPackets)
 			break; // Rasterization finished.
 
+		// Early fragment tests
+
+		numRasterizedPackets = executeEarlyFragmentTests(renderTarget, state.fragOps, rr::FACETYPE_FRONT, numRasterizedPackets, buffers, drawContext);
+
+		if (!numRasterizedPackets)
+			continue; // All fragments killed.
+
 		// Shade
 
 		program.fragmentShader->shadeFragments(&buffers.fragmentPackets[0], numRasterizedPackets, shadingContext);
@@ -1277,7 +1685,7 @@ void rasterizePrimitive (const RenderState&					state,
 
 		// Handle fragment shader outputs
 
-		writeFragmentPackets(state, renderTarget, program, &buffers.fragmentPackets[0], numRasterizedPackets, rr::FACETYPE_FRONT, buffers.shaderOutputs, buffers.fragmentDepthBuffer, buffers.shadedFragments);
+		writeFragmentPackets(drawContext.postShadingFragOps, renderTarget, program, &buffers.fragmentPackets[0], numRasterizedPackets, rr::FACETYPE_FRONT, buffers.shaderOutputs, buffers.fragmentDepthBuffer, buffers.shadedFragments);
 	}
 }
 
@@ -1285,7 +1693,8 @@ template <typename ContainerType>
 void rasterize (const RenderState&					state,
 				const RenderTarget&					renderTarget,
 				const Program&						program,
-				const ContainerType&				list)
+				const ContainerType&				list,
+				DrawContext&						drawContext)
 {
 	const int						numSamples			= renderTarget.getNumSamples();
 	const int						numFragmentOutputs	= (int)program.fragmentShader->getOutputs().size();
@@ -1319,14 +1728,14 @@ void rasterize (const RenderState&					state,
 
 	// rasterize
 	for (typename ContainerType::const_iterator it = list.begin(); it != list.end(); ++it)
-		rasterizePrimitive(state, renderTarget, program, *it, renderTargetRect, buffers);
+		rasterizePrimitive(state, renderTarget, program, *it, renderTargetRect, buffers, drawContext);
 }
 
 /*--------------------------------------------------------------------*//*!
  * Draws transformed triangles, lines or points to render target
  *//*--------------------------------------------------------------------*/
 template <typename ContainerType>
-void drawBasicPrimitives (const RenderState& state, const RenderTarget& renderTarget, const Program& program, ContainerType& primList, VertexPacketAllocator& vpalloc)
+void drawBasicPrimitives (const RenderState& state, const RenderTarget& renderTarget, const Program& program, ContainerType& primList, DrawContext& drawContext, VertexPacketAllocator& vpalloc)
 {
 	const bool clipZ = !state.fragOps.depthClampEnabled;
 
@@ -1343,7 +1752,7 @@ void drawBasicPrimitives (const RenderState& state, const RenderTarget& renderTa
 	transformClipCoordsToWindowCoords(state, primList);
 
 	// Rasterize and paint
-	rasterize(state, renderTarget, program, primList);
+	rasterize(state, renderTarget, program, primList, drawContext);
 }
 
 void copyVertexPacketPointers(const VertexPacket** dst, const pa::Point& in)
@@ -1383,7 +1792,7 @@ void copyVertexPacketPointers(const VertexPacket** dst, const pa::TriangleAdjace
 }
 
 template <PrimitiveType DrawPrimitiveType> // \note DrawPrimitiveType  can only be Points, line_strip, or triangle_strip
-void drawGeometryShaderOutputAsPrimitives (const RenderState& state, const RenderTarget& renderTarget, const Program& program, VertexPacket* const* vertices, size_t numVertices, VertexPacketAllocator& vpalloc)
+void drawGeometryShaderOutputAsPrimitives (const RenderState& state, const RenderTarget& renderTarget, const Program& program, VertexPacket* const* vertices, size_t numVertices, DrawContext& drawContext, VertexPacketAllocator& vpalloc)
 {
 	// Run primitive assembly for generated stream
 
@@ -1394,11 +1803,14 @@ void drawGeometryShaderOutputAsPrimitives (const RenderState& state, const Rende
 
 	// Make shared vertices distinct
 
-	makeSharedVerticesDistinct(inputPrimitives, vpalloc);
+	{
+		VertexPacketSet vertices;
+		makeSharedVerticesDistinct(inputPrimitives, vertices, vpalloc);
+	}
 
 	// Draw assembled primitives
 
-	drawBasicPrimitives(state, renderTarget, program, inputPrimitives, vpalloc);
+	drawBasicPrimitives(state, renderTarget, program, inputPrimitives, drawContext, vpalloc);
 }
 
 template <PrimitiveType DrawPrimitiveType>
@@ -1453,9 +1865,9 @@ void drawWithGeometryShader(const RenderState& state, const RenderTarget& render
 
 			switch (program.geometryShader->getOutputType())
 			{
-				case rr::GEOMETRYSHADEROUTPUTTYPE_POINTS:			drawGeometryShaderOutputAsPrimitives<PRIMITIVETYPE_POINTS>			(state, renderTarget, program, &emitted[primitiveBegin], primitiveEnd-primitiveBegin, vpalloc); break;
-				case rr::GEOMETRYSHADEROUTPUTTYPE_LINE_STRIP:		drawGeometryShaderOutputAsPrimitives<PRIMITIVETYPE_LINE_STRIP>		(state, renderTarget, program, &emitted[primitiveBegin], primitiveEnd-primitiveBegin, vpalloc); break;
-				case rr::GEOMETRYSHADEROUTPUTTYPE_TRIANGLE_STRIP:	drawGeometryShaderOutputAsPrimitives<PRIMITIVETYPE_TRIANGLE_STRIP>	(state, renderTarget, program, &emitted[primitiveBegin], primitiveEnd-primitiveBegin, vpalloc); break;
+				case rr::GEOMETRYSHADEROUTPUTTYPE_POINTS:			drawGeometryShaderOutputAsPrimitives<PRIMITIVETYPE_POINTS>			(state, renderTarget, program, &emitted[primitiveBegin], primitiveEnd-primitiveBegin, drawContext, vpalloc); break;
+				case rr::GEOMETRYSHADEROUTPUTTYPE_LINE_STRIP:		drawGeometryShaderOutputAsPrimitives<PRIMITIVETYPE_LINE_STRIP>		(state, renderTarget, program, &emitted[primitiveBegin], primitiveEnd-primitiveBegin, drawContext, vpalloc); break;
+				case rr::GEOMETRYSHADEROUTPUTTYPE_TRIANGLE_STRIP:	drawGeometryShaderOutputAsPrimitives<PRIMITIVETYPE_TRIANGLE_STRIP>	(state, renderTarget, program, &emitted[primitiveBegin], primitiveEnd-primitiveBegin, drawContext, vpalloc); break;
 				default:
 					DE_ASSERT(DE_FALSE);
 			}
@@ -1466,11 +1878,125 @@ void drawWithGeometryShader(const RenderState& state, const RenderTarget& render
 	}
 }
 
+enum
+{
+	PRIMITIVES_PER_BATCH = 256	//!< Must be even to keep triangle strip winding
+};
+
+//! Range [begin, end) of vertices in a primitive restart delimited run of vertices
+struct VertexRange
+{
+	size_t	begin;
+	size_t	end;
+
+	VertexRange (size_t begin_ = 0, size_t end_ = 0)
+		: begin	(begin_)
+		, end	(end_)
+	{
+	}
+};
+
+/*--------------------------------------------------------------------*//*!
+ * Finds vertices needed to assemble primitives [firstPrimitive,
+ * endPrimitive) of a vertex run. Returns number of ranges written. Ranges
+ * are assembled as a single vertex list with StreamAssembler.
+ *//*--------------------------------------------------------------------*/
+int getPrimitiveVertexRanges (PrimitiveType primitiveType, size_t numVertices, size_t firstPrimitive, size_t endPrimitive, VertexRange* ranges)
+{
+	switch (primitiveType)
+	{
+		case PRIMITIVETYPE_TRIANGLES:				ranges[0] = VertexRange(3*firstPrimitive, 3*endPrimitive);	return 1;
+		case PRIMITIVETYPE_TRIANGLE_STRIP:			ranges[0] = VertexRange(firstPrimitive, endPrimitive+2);	return 1;
+		case PRIMITIVETYPE_LINES:					ranges[0] = VertexRange(2*firstPrimitive, 2*endPrimitive);	return 1;
+		case PRIMITIVETYPE_LINE_STRIP:				ranges[0] = VertexRange(firstPrimitive, endPrimitive+1);	return 1;
+		case PRIMITIVETYPE_POINTS:					ranges[0] = VertexRange(firstPrimitive, endPrimitive);		return 1;
+		case PRIMITIVETYPE_LINES_ADJACENCY:			ranges[0] = VertexRange(4*firstPrimitive, 4*endPrimitive);	return 1;
+		case PRIMITIVETYPE_LINE_STRIP_ADJACENCY:	ranges[0] = VertexRange(firstPrimitive, endPrimitive+3);	return 1;
+		case PRIMITIVETYPE_TRIANGLES_ADJACENCY:		ranges[0] = VertexRange(6*firstPrimitive, 6*endPrimitive);	return 1;
+
+		case PRIMITIVETYPE_TRIANGLE_FAN:
+			// Fan center and edge vertices
+			ranges[0] = VertexRange(0, 1);
+			ranges[1] = VertexRange(firstPrimitive+1, endPrimitive+2);
+			return 2;
+
+		case PRIMITIVETYPE_LINE_LOOP:
+			// Assembled as line strip, closing line is last primitive
+			ranges[0] = VertexRange(firstPrimitive, de::min(endPrimitive+1, numVertices));
+			if (endPrimitive != numVertices)
+				return 1;
+			ranges[1] = VertexRange(0, 1);
+			return 2;
+
+		case PRIMITIVETYPE_TRIANGLE_STRIP_ADJACENCY:
+			// Primitives depend on their position in strip, assemble whole run
+			DE_ASSERT(firstPrimitive == 0 && endPrimitive == PrimitiveTypeTraits<PRIMITIVETYPE_TRIANGLE_STRIP_ADJACENCY>::Assembler::getPrimitiveCount(numVertices));
+			ranges[0] = VertexRange(0, numVertices);
+			return 1;
+
+		default:
+			DE_ASSERT(DE_FALSE);
+			return 0;
+	}
+}
+
+template <PrimitiveType DrawPrimitiveType>	struct StreamAssembler								{ typedef typename PrimitiveTypeTraits<DrawPrimitiveType>::Assembler Type;	};
+template <>									struct StreamAssembler<PRIMITIVETYPE_LINE_LOOP>		{ typedef pa::LineStrip Type;												};
+
+//! Maximum number of primitives assembled and drawn at once
+size_t getPrimitivesPerBatch (PrimitiveType primitiveType, size_t numPrimitives)
+{
+	if (primitiveType == PRIMITIVETYPE_TRIANGLE_STRIP_ADJACENCY)
+		return numPrimitives;
+	else
+		return PRIMITIVES_PER_BATCH;
+}
+
+/*--------------------------------------------------------------------*//*!
+ * Makes sure vertex batch has at least numVertices packets. Packets are
+ * allocated at once so they are in ascending address order.
+ *//*--------------------------------------------------------------------*/
+void reserveVertexBatch (std::vector<VertexPacket*>& vertexBatch, size_t numVertices, VertexPacketAllocator& vpalloc)
+{
+	if (vertexBatch.size() < numVertices)
+		vertexBatch = vpalloc.allocArray(de::max(numVertices, 2*vertexBatch.size()));
+}
+
+/*--------------------------------------------------------------------*//*!
+ * Runs vertex shader for vertex ranges of a run. Vertex packets are
+ * written to beginning of vertex batch in range order.
+ *//*--------------------------------------------------------------------*/
+size_t shadeVertexRanges (const DrawCommand& command, int instanceID, size_t firstElement, const VertexRange* ranges, int numRanges, const std::vector<VertexPacket*>& vertexBatch)
+{
+	size_t numVertices = 0;
+
+	for (int rangeNdx = 0; rangeNdx < numRanges; ++rangeNdx)
+	{
+		for (size_t vertexNdx = ranges[rangeNdx].begin; vertexNdx < ranges[rangeNdx].end; ++vertexNdx)
+		{
+			VertexPacket* const packet = vertexBatch[numVertices++];
+
+			// input
+			packet->instanceNdx	= instanceID;
+			packet->vertexNdx	= (int)command.primitives.getIndex(firstElement + vertexNdx);
+
+			// output
+			packet->pointSize	= command.state.point.pointSize;	// default value from the current state
+			packet->position	= tcu::Vec4(0, 0, 0, 0);			// no undefined values
+		}
+	}
+
+	if (numVertices > 0)
+		command.program.vertexShader->shadeVertices(command.vertexAttribs, &vertexBatch[0], (int)numVertices);
+
+	return numVertices;
+}
+
 /*--------------------------------------------------------------------*//*!
  * Assembles, tesselates, runs geometry shader and draws primitives of any type from vertex list.
  *//*--------------------------------------------------------------------*/
 template <PrimitiveType DrawPrimitiveType>
-void drawAsPrimitives (const RenderState& state, const RenderTarget& renderTarget, const Program& program, VertexPacket* const* vertices, int numVertices, DrawContext& drawContext, VertexPacketAllocator& vpalloc)
+void drawAsPrimitives (const RenderState& state, const RenderTarget& renderTarget, const Program& program, VertexPacket* const* vertices, int numVertices, DrawContext& drawContext)
 {
 	// Assemble primitives (deconstruct stips & loops)
 	const size_t															assemblerPrimitiveCount		= PrimitiveTypeTraits<DrawPrimitiveType>::Assembler::getPrimitiveCount(numVertices);
@@ -1482,28 +2008,121 @@ void drawAsPrimitives (const RenderState& state, const RenderTarget& renderTarge
 	//if (state.tesselation)
 	//	primList = state.tesselation.exec(primList);
 
-	// Geometry shader
-	if (program.geometryShader)
-	{
-		// If there is an active geometry shader, it will convert any primitive type to basic types
-		drawWithGeometryShader<DrawPrimitiveType>(state, renderTarget, program, inputPrimitives, drawContext);
-	}
-	else
+	// Geometry shader converts any primitive type to basic types
+	DE_ASSERT(program.geometryShader);
+	drawWithGeometryShader<DrawPrimitiveType>(state, renderTarget, program, inputPrimitives, drawContext);
+}
+
+/*--------------------------------------------------------------------*//*!
+ * Draws primitives of a vertex run in batches without geometry shader.
+ *
+ * Vertices needed by a batch of primitives are shaded, assembled,
+ * clipped and rasterized before moving to the next batch, so memory use
+ * is bounded by batch size instead of draw size. Vertices shared by
+ * primitives in different batches are shaded once per batch. Since
+ * shared vertices are made distinct in any case, result is identical to
+ * processing the whole run at once.
+ *//*--------------------------------------------------------------------*/
+template <PrimitiveType DrawPrimitiveType>
+void drawAsPrimitiveStream (const DrawCommand& command, int instanceID, size_t firstElement, size_t numElements, DrawContext& drawContext, std::vector<VertexPacket*>& vertexBatch, VertexPacketAllocator& vpalloc)
+{
+	typedef typename PrimitiveTypeTraits<DrawPrimitiveType>::Type		InputType;
+	typedef typename PrimitiveTypeTraits<DrawPrimitiveType>::BaseType	BaseType;
+	typedef typename StreamAssembler<DrawPrimitiveType>::Type			Assembler;
+
+	const size_t			numPrimitives		= PrimitiveTypeTraits<DrawPrimitiveType>::Assembler::getPrimitiveCount(numElements);
+	const size_t			primitivesPerBatch	= getPrimitivesPerBatch(DrawPrimitiveType, numPrimitives);
+	std::vector<InputType>	inputPrimitives;
+	std::vector<BaseType>	basePrimitives;
+	std::vector<bool>		isVertexUsed;
+
+	for (size_t batchBegin = 0; batchBegin < numPrimitives; batchBegin += primitivesPerBatch)
 	{
-		std::vector<typename PrimitiveTypeTraits<DrawPrimitiveType>::BaseType> basePrimitives;
+		const size_t	batchEnd		= de::min(batchBegin + primitivesPerBatch, numPrimitives);
+		VertexRange		ranges[2];
+		const int		numRanges		= getPrimitiveVertexRanges(DrawPrimitiveType, numElements, batchBegin, batchEnd, ranges);
+		size_t			numVertices		= 0;
+
+		for (int rangeNdx = 0; rangeNdx < numRanges; ++rangeNdx)
+			numVertices += ranges[rangeNdx].end - ranges[rangeNdx].begin;
+
+		reserveVertexBatch(vertexBatch, numVertices, vpalloc);
+
+		// Transform vertices
+
+		shadeVertexRanges(command, instanceID, firstElement, ranges, numRanges, vertexBatch);
+
+		// Assemble primitives (deconstruct stips & loops)
+
+		DE_ASSERT(Assembler::getPrimitiveCount(numVertices) == batchEnd - batchBegin);
+
+		inputPrimitives.resize(batchEnd - batchBegin);
+		Assembler::exec(inputPrimitives.begin(), &vertexBatch[0], numVertices, command.state.provokingVertexConvention);
 
 		// convert types from X_adjacency to X
 		convertPrimitiveToBaseType(basePrimitives, inputPrimitives);
 
 		// Make shared vertices distinct. Needed for that the translation to screen space happens only once per vertex, and for flatshading
-		makeSharedVerticesDistinct(basePrimitives, vpalloc);
+		{
+			VertexBatchPacketSet vertices (&vertexBatch[0], numVertices, isVertexUsed);
+			makeSharedVerticesDistinct(basePrimitives, vertices, vpalloc);
+		}
 
 		// A primitive ID will be generated even if no geometry shader is active
 		generatePrimitiveIDs(basePrimitives, drawContext);
 
 		// Draw as a basic type
-		drawBasicPrimitives(state, renderTarget, program, basePrimitives, vpalloc);
+		drawBasicPrimitives(command.state, command.renderTarget, command.program, basePrimitives, drawContext, vpalloc);
+
+		// Recycle distinct and clipped vertices
+		vpalloc.reset();
+	}
+}
+
+/*--------------------------------------------------------------------*//*!
+ * Draws a primitive restart delimited run of vertices.
+ *//*--------------------------------------------------------------------*/
+template <PrimitiveType DrawPrimitiveType>
+void drawVertexRun (const DrawCommand& command, int instanceID, size_t firstElement, size_t numElements, DrawContext& drawContext, std::vector<VertexPacket*>& vertexBatch, VertexPacketAllocator& vpalloc)
+{
+	if (command.program.geometryShader)
+	{
+		// Geometry shader invocations run for all primitives of the run before next invocation, shade whole run at once
+		const VertexRange	range		(0, numElements);
+		size_t				numVertices;
+
+		reserveVertexBatch(vertexBatch, numElements, vpalloc);
+		numVertices = shadeVertexRanges(command, instanceID, firstElement, &range, 1, vertexBatch);
+
+		drawAsPrimitives<DrawPrimitiveType>(command.state, command.renderTarget, command.program, &vertexBatch[0], (int)numVertices, drawContext);
 	}
+	else
+		drawAsPrimitiveStream<DrawPrimitiveType>(command, instanceID, firstElement, numElements, drawContext, vertexBatch, vpalloc);
+}
+
+/*--------------------------------------------------------------------*//*!
+ * Depth and stencil tests can be run before shading if shader can't
+ * change their outcome.
+ *//*--------------------------------------------------------------------*/
+bool canUseEarlyFragmentTests (const RenderState& state, const RenderTarget& renderTarget, const Program& program)
+{
+	const bool doDepthTest		= state.fragOps.depthTestEnabled && !isEmpty(renderTarget.getDepthBuffer());
+	const bool doStencilTest	= state.fragOps.stencilTestEnabled && !isEmpty(renderTarget.getStencilBuffer());
+
+	// \note Depth clamp is applied to shaded values, use late tests to keep it that way
+	return (doDepthTest || doStencilTest)				&&
+		   !program.fragmentShader->writesFragmentDepth()	&&
+		   !program.fragmentShader->discardsFragments()	&&
+		   !state.fragOps.depthClampEnabled;
+}
+
+bool isDepthHierarchyCompatible (TestFunc depthFunc)
+{
+	return depthFunc == TESTFUNC_NEVER		||
+		   depthFunc == TESTFUNC_LESS		||
+		   depthFunc == TESTFUNC_LEQUAL		||
+		   depthFunc == TESTFUNC_GREATER	||
+		   depthFunc == TESTFUNC_GEQUAL;
 }
 
 bool isValidCommand (const DrawCommand& command, int numInstances)
@@ -1764,11 +2383,28 @@ void Renderer::drawInstanced (const DrawCommand& command, int numInstances) cons
 
 	// Prepare transformation
 
-	const size_t				numVaryings = command.program.vertexShader->getOutputs().size();
-	VertexPacketAllocator		vpalloc(numVaryings);
-	std::vector<VertexPacket*>	vertexPackets = vpalloc.allocArray(command.primitives.getNumElements());
+	const size_t				numVaryings		= command.program.vertexShader->getOutputs().size();
+	VertexPacketAllocator		vpalloc			(numVaryings);
+	std::vector<VertexPacket*>	vertexBatch;
+	DepthHierarchy				depthHierarchy	(command.renderTarget.getDepthBuffer().raw());
 	DrawContext					drawContext;
 
+	// Prepare fragment operations
+
+	drawContext.earlyFragmentTests	= canUseEarlyFragmentTests(command.state, command.renderTarget, command.program);
+	drawContext.postShadingFragOps	= command.state.fragOps;
+	drawContext.statistics			= &m_statistics;
+
+	if (drawContext.earlyFragmentTests)
+	{
+		// Depth and stencil are already tested and written
+		drawContext.postShadingFragOps.depthTestEnabled		= false;
+		drawContext.postShadingFragOps.stencilTestEnabled	= false;
+
+		if (!isEmpty(command.renderTarget.getDepthBuffer()) && command.state.fragOps.depthTestEnabled && isDepthHierarchyCompatible(command.state.fragOps.depthFunc))
+			drawContext.depthHierarchy = &depthHierarchy;
+	}
+
 	for (int instanceID = 0; instanceID < numInstances; ++instanceID)
 	{
 		// Each instance has its own primitives
@@ -1776,50 +2412,35 @@ void Renderer::drawInstanced (const DrawCommand& command, int numInstances) cons
 
 		for (size_t elementNdx = 0; elementNdx < command.primitives.getNumElements(); ++elementNdx)
 		{
-			int numVertexPackets = 0;
+			const size_t firstElement = elementNdx;
 
 			// collect primitive vertices until restart
 
 			while (elementNdx < command.primitives.getNumElements() &&
 					!(command.state.restart.enabled && command.primitives.isRestartIndex(elementNdx, command.state.restart.restartIndex)))
-			{
-				// input
-				vertexPackets[numVertexPackets]->instanceNdx	= instanceID;
-				vertexPackets[numVertexPackets]->vertexNdx		= (int)command.primitives.getIndex(elementNdx);
-
-				// output
-				vertexPackets[numVertexPackets]->pointSize		= command.state.point.pointSize;	// default value from the current state
-				vertexPackets[numVertexPackets]->position		= tcu::Vec4(0, 0, 0, 0);			// no undefined values
-
-				++numVertexPackets;
 				++elementNdx;
-			}
 
 			// Duplicated restart shade
-			if (numVertexPackets == 0)
+			if (elementNdx == firstElement)
 				continue;
 
 			// \todo Vertex cache?
 
-			// Transform vertices
-
-			command.program.vertexShader->shadeVertices(command.vertexAttribs, &vertexPackets[0], numVertexPackets);
-
 			// Draw primitives
 
 			switch (command.primitives.getPrimitiveType())
 			{
-				case PRIMITIVETYPE_TRIANGLES:				{ drawAsPrimitives<PRIMITIVETYPE_TRIANGLES>					(command.state, command.renderTarget, command.program, &vertexPackets[0], numVertexPackets, drawContext, vpalloc);	break; }
-				case PRIMITIVETYPE_TRIANGLE_STRIP:			{ drawAsPrimitives<PRIMITIVETYPE_TRIANGLE_STRIP>			(command.state, command.renderTarget, command.program, &vertexPackets[0], numVertexPackets, drawContext, vpalloc);	break; }
-				case PRIMITIVETYPE_TRIANGLE_FAN:			{ drawAsPrimitives<PRIMITIVETYPE_TRIANGLE_FAN>				(command.state, command.renderTarget, command.program, &vertexPackets[0], numVertexPackets, drawContext, vpalloc);	break; }
-				case PRIMITIVETYPE_LINES:					{ drawAsPrimitives<PRIMITIVETYPE_LINES>						(command.state, command.renderTarget, command.program, &vertexPackets[0], numVertexPackets, drawContext, vpalloc);	break; }
-				case PRIMITIVETYPE_LINE_STRIP:				{ drawAsPrimitives<PRIMITIVETYPE_LINE_STRIP>				(command.state, command.renderTarget, command.program, &vertexPackets[0], numVertexPackets, drawContext, vpalloc);	break; }
-				case PRIMITIVETYPE_LINE_LOOP:				{ drawAsPrimitives<PRIMITIVETYPE_LINE_LOOP>					(command.state, command.renderTarget, command.program, &vertexPackets[0], numVertexPackets, drawContext, vpalloc);	break; }
-				case PRIMITIVETYPE_POINTS:					{ drawAsPrimitives<PRIMITIVETYPE_POINTS>					(command.state, command.renderTarget, command.program, &vertexPackets[0], numVertexPackets, drawContext, vpalloc);	break; }
-				case PRIMITIVETYPE_LINES_ADJACENCY:			{ drawAsPrimitives<PRIMITIVETYPE_LINES_ADJACENCY>			(command.state, command.renderTarget, command.program, &vertexPackets[0], numVertexPackets, drawContext, vpalloc);	break; }
-				case PRIMITIVETYPE_LINE_STRIP_ADJACENCY:	{ drawAsPrimitives<PRIMITIVETYPE_LINE_STRIP_ADJACENCY>		(command.state, command.renderTarget, command.program, &vertexPackets[0], numVertexPackets, drawContext, vpalloc);	break; }
-				case PRIMITIVETYPE_TRIANGLES_ADJACENCY:		{ drawAsPrimitives<PRIMITIVETYPE_TRIANGLES_ADJACENCY>		(command.state, command.renderTarget, command.program, &vertexPackets[0], numVertexPackets, drawContext, vpalloc);	break; }
-				case PRIMITIVETYPE_TRIANGLE_STRIP_ADJACENCY:{ drawAsPrimitives<PRIMITIVETYPE_TRIANGLE_STRIP_ADJACENCY>	(command.state, command.renderTarget, command.program, &vertexPackets[0], numVertexPackets, drawContext, vpalloc);	break; }
+				case PRIMITIVETYPE_TRIANGLES:				{ drawVertexRun<PRIMITIVETYPE_TRIANGLES>					(command, instanceID, firstElement, elementNdx - firstElement, drawContext, vertexBatch, vpalloc);	break; }
+				case PRIMITIVETYPE_TRIANGLE_STRIP:			{ drawVertexRun<PRIMITIVETYPE_TRIANGLE_STRIP>				(command, instanceID, firstElement, elementNdx - firstElement, drawContext, vertexBatch, vpalloc);	break; }
+				case PRIMITIVETYPE_TRIANGLE_FAN:			{ drawVertexRun<PRIMITIVETYPE_TRIANGLE_FAN>					(command, instanceID, firstElement, elementNdx - firstElement, drawContext, vertexBatch, vpalloc);	break; }
+				case PRIMITIVETYPE_LINES:					{ drawVertexRun<PRIMITIVETYPE_LINES>						(command, instanceID, firstElement, elementNdx - firstElement, drawContext, vertexBatch, vpalloc);	break; }
+				case PRIMITIVETYPE_LINE_STRIP:				{ drawVertexRun<PRIMITIVETYPE_LINE_STRIP>					(command, instanceID, firstElement, elementNdx - firstElement, drawContext, vertexBatch, vpalloc);	break; }
+				case PRIMITIVETYPE_LINE_LOOP:				{ drawVertexRun<PRIMITIVETYPE_LINE_LOOP>					(command, instanceID, firstElement, elementNdx - firstElement, drawContext, vertexBatch, vpalloc);	break; }
+				case PRIMITIVETYPE_POINTS:					{ drawVertexRun<PRIMITIVETYPE_POINTS>						(command, instanceID, firstElement, elementNdx - firstElement, drawContext, vertexBatch, vpalloc);	break; }
+				case PRIMITIVETYPE_LINES_ADJACENCY:			{ drawVertexRun<PRIMITIVETYPE_LINES_ADJACENCY>				(command, instanceID, firstElement, elementNdx - firstElement, drawContext, vertexBatch, vpalloc);	break; }
+				case PRIMITIVETYPE_LINE_STRIP_ADJACENCY:	{ drawVertexRun<PRIMITIVETYPE_LINE_STRIP_ADJACENCY>			(command, instanceID, firstElement, elementNdx - firstElement, drawContext, vertexBatch, vpalloc);	break; }
+				case PRIMITIVETYPE_TRIANGLES_ADJACENCY:		{ drawVertexRun<PRIMITIVETYPE_TRIANGLES_ADJACENCY>			(command, instanceID, firstElement, elementNdx - firstElement, drawContext, vertexBatch, vpalloc);	break; }
+				case PRIMITIVETYPE_TRIANGLE_STRIP_ADJACENCY:{ drawVertexRun<PRIMITIVETYPE_TRIANGLE_STRIP_ADJACENCY>		(command, instanceID, firstElement, elementNdx - firstElement, drawContext, vertexBatch, vpalloc);	break; }
 				default:
 					DE_ASSERT(DE_FALSE);
 			}
@@ -129,14 +129,44 @@ public:
 	const PrimitiveList&		primitives;
 } DE_WARN_UNUSED_TYPE;
 
+/*--------------------------------------------------------------------*//*!
+ * \brief Fragment counters
+ *
+ * A fragment is a pixel with at least one covered sample. When depth and
+ * stencil tests are run before shading, fragments that fail them are
+ * killed without shading. Otherwise all rasterized fragments are shaded.
+ *//*--------------------------------------------------------------------*/
+struct RenderStatistics
+{
+	deUint64					numRasterizedFragments;
+	deUint64					numShadedFragments;
+	deUint64					numEarlyKilledFragments;	//!< Failed early depth and stencil tests
+	deUint64					numHiZKilledFragments;		//!< Subset of early killed fragments rejected by coarse depth test
+
+	RenderStatistics (void)
+		: numRasterizedFragments	(0)
+		, numShadedFragments		(0)
+		, numEarlyKilledFragments	(0)
+		, numHiZKilledFragments		(0)
+	{
+	}
+};
+
 class Renderer
 {
 public:
-					Renderer		(void);
-					~Renderer		(void);
+								Renderer		(void);
+								~Renderer		(void);
+
+	void						draw			(const DrawCommand& command) const;
+	void						drawInstanced	(const DrawCommand& command, int numInstances) const;
 
-	void			draw			(const DrawCommand& command) const;
-	void			drawInstanced	(const DrawCommand& command, int numInstances) const;
+	//! Counters accumulated by all draws. \note Draws update counters, Renderer must not be used from multiple threads at once.
+	const RenderStatistics&		getStatistics	(void) const	{ return m_statistics;					}
+	void						resetStatistics	(void)			{ m_statistics = RenderStatistics();	}
+
+private:
+	mutable RenderStatistics	m_statistics;
 } DE_WARN_UNUSED_TYPE;
 
 } // rr
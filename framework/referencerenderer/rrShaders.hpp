@@ -118,15 +118,23 @@ protected:
  *
  * Fragment shader executes shading for list of fragment packets. See
  * FragmentPacket documentation for more details on shading API.
+ *
+ * Unless the shader writes fragment depth or discards fragments, renderer
+ * may run depth and stencil tests before shading and shade only fragments
+ * that passed them. Shaders doing either must declare it by setting
+ * m_writesFragmentDepth or m_discardsFragments.
  *//*--------------------------------------------------------------------*/
 class FragmentShader
 {
 public:
-											FragmentShader		(size_t numInputs, size_t numOutputs) : m_inputs(numInputs), m_outputs(numOutputs) {}
+											FragmentShader		(size_t numInputs, size_t numOutputs) : m_inputs(numInputs), m_outputs(numOutputs), m_writesFragmentDepth(false), m_discardsFragments(false) {}
 
 	const std::vector<FragmentInputInfo>&	getInputs			(void) const	{ return m_inputs;	}
 	const std::vector<FragmentOutputInfo>&	getOutputs			(void) const	{ return m_outputs;	}
 
+	bool									writesFragmentDepth	(void) const	{ return m_writesFragmentDepth;	}
+	bool									discardsFragments	(void) const	{ return m_discardsFragments;	}
+
 	virtual void							shadeFragments		(FragmentPacket* packets, const int numPackets, const FragmentShadingContext& context) const = 0; // \note numPackets must be greater than zero.
 
 protected:
@@ -134,6 +142,8 @@ protected:
 
 	std::vector<FragmentInputInfo>			m_inputs;
 	std::vector<FragmentOutputInfo>			m_outputs;
+	bool									m_writesFragmentDepth;	//!< Shader writes depth with writeFragmentDepth()
+	bool									m_discardsFragments;	//!< Shader clears bits of FragmentPacket::coverage
 } DE_WARN_UNUSED_TYPE;
 
 /*--------------------------------------------------------------------*//*!
@@ -22,6 +22,7 @@
  *//*--------------------------------------------------------------------*/
 
 #include "rrVertexAttrib.hpp"
+#include "rrVertexPacket.hpp"
 #include "tcuFloat.hpp"
 #include "deInt32.h"
 #include "deMemory.h"
@@ -456,6 +457,160 @@ int getComponentSize (const VertexAttribType type)
 	}
 }
 
+// batch fetch
+
+// Reader wrappers for use as template arguments.
+#define RR_VERTEX_ATTRIB_READER(NAME, SCALAR_TYPE, READ_FUNC)									\
+	struct NAME																					\
+	{																							\
+		typedef SCALAR_TYPE Scalar;																\
+		static void exec (tcu::Vector<Scalar, 4>& dst, const int size, const void* ptr)			\
+		{																						\
+			READ_FUNC(dst, size, ptr);															\
+		}																						\
+	}
+
+RR_VERTEX_ATTRIB_READER(ReaderFloat,					float,		read<float>);
+RR_VERTEX_ATTRIB_READER(ReaderHalf,						float,		readHalf);
+RR_VERTEX_ATTRIB_READER(ReaderFixed,					float,		readFixed);
+RR_VERTEX_ATTRIB_READER(ReaderDouble,					float,		readDouble);
+RR_VERTEX_ATTRIB_READER(ReaderUnorm8,					float,		readUnorm<deUint8>);
+RR_VERTEX_ATTRIB_READER(ReaderUnorm16,					float,		readUnorm<deUint16>);
+RR_VERTEX_ATTRIB_READER(ReaderUnorm32,					float,		readUnorm<deUint32>);
+RR_VERTEX_ATTRIB_READER(ReaderUnorm2101010Rev,			float,		readUnorm2101010Rev);
+RR_VERTEX_ATTRIB_READER(ReaderSnorm8Clamp,				float,		readSnormClamp<deInt8>);
+RR_VERTEX_ATTRIB_READER(ReaderSnorm16Clamp,				float,		readSnormClamp<deInt16>);
+RR_VERTEX_ATTRIB_READER(ReaderSnorm32Clamp,				float,		readSnormClamp<deInt32>);
+RR_VERTEX_ATTRIB_READER(ReaderSnorm2101010RevClamp,		float,		readSnorm2101010RevClamp);
+RR_VERTEX_ATTRIB_READER(ReaderSnorm8Scale,				float,		readSnormScale<deInt8>);
+RR_VERTEX_ATTRIB_READER(ReaderSnorm16Scale,				float,		readSnormScale<deInt16>);
+RR_VERTEX_ATTRIB_READER(ReaderSnorm32Scale,				float,		readSnormScale<deInt32>);
+RR_VERTEX_ATTRIB_READER(ReaderSnorm2101010RevScale,		float,		readSnorm2101010RevScale);
+RR_VERTEX_ATTRIB_READER(ReaderUint8AsFloat,				float,		read<deUint8>);
+RR_VERTEX_ATTRIB_READER(ReaderUint16AsFloat,			float,		read<deUint16>);
+RR_VERTEX_ATTRIB_READER(ReaderUint32AsFloat,			float,		read<deUint32>);
+RR_VERTEX_ATTRIB_READER(ReaderInt8AsFloat,				float,		read<deInt8>);
+RR_VERTEX_ATTRIB_READER(ReaderInt16AsFloat,				float,		read<deInt16>);
+RR_VERTEX_ATTRIB_READER(ReaderInt32AsFloat,				float,		read<deInt32>);
+RR_VERTEX_ATTRIB_READER(ReaderUint2101010RevAsFloat,	float,		readUint2101010Rev);
+RR_VERTEX_ATTRIB_READER(ReaderInt2101010RevAsFloat,		float,		readInt2101010Rev);
+RR_VERTEX_ATTRIB_READER(ReaderUnorm8BGRA,				float,		readUnormBGRA<deUint8>);
+RR_VERTEX_ATTRIB_READER(ReaderUnorm2101010RevBGRA,		float,		readUnorm2101010RevBGRA);
+RR_VERTEX_ATTRIB_READER(ReaderSnorm2101010RevClampBGRA,	float,		readSnorm2101010RevClampBGRA);
+RR_VERTEX_ATTRIB_READER(ReaderSnorm2101010RevScaleBGRA,	float,		readSnorm2101010RevScaleBGRA);
+RR_VERTEX_ATTRIB_READER(ReaderPureInt8,					deInt32,	read<deInt8>);
+RR_VERTEX_ATTRIB_READER(ReaderPureInt16,				deInt32,	read<deInt16>);
+RR_VERTEX_ATTRIB_READER(ReaderPureInt32,				deInt32,	read<deInt32>);
+RR_VERTEX_ATTRIB_READER(ReaderPureUint8,				deUint32,	read<deUint8>);
+RR_VERTEX_ATTRIB_READER(ReaderPureUint16,				deUint32,	read<deUint16>);
+RR_VERTEX_ATTRIB_READER(ReaderPureUint32,				deUint32,	read<deUint32>);
+
+#undef RR_VERTEX_ATTRIB_READER
+
+// Size is a template parameter so that component count checks in readers
+// are resolved at compile time.
+template<typename Reader, int Size>
+void fetchRun (void* dstPtr, int dstStride, const VertexAttrib& vertexAttrib, int stride, const VertexPacket* const* packets, int numPackets)
+{
+	typedef typename Reader::Scalar Scalar;
+
+	Scalar* const			dst			= (Scalar*)dstPtr;
+	const deUint8* const	basePtr		= (const deUint8*)vertexAttrib.pointer;
+	const int				divisor		= vertexAttrib.instanceDivisor;
+
+	for (int packetNdx = 0; packetNdx < numPackets; packetNdx++)
+	{
+		const VertexPacket&		packet		= *packets[packetNdx];
+		const int				elementNdx	= (divisor != 0) ? (packet.instanceNdx / divisor) : packet.vertexNdx;
+		tcu::Vector<Scalar, 4>	value		(Scalar(0), Scalar(0), Scalar(0), Scalar(1));
+
+		Reader::exec(value, Size, basePtr + elementNdx*stride);
+
+		dst[0*dstStride + packetNdx] = value[0];
+		dst[1*dstStride + packetNdx] = value[1];
+		dst[2*dstStride + packetNdx] = value[2];
+		dst[3*dstStride + packetNdx] = value[3];
+	}
+}
+
+template<typename Reader>
+VertexAttribReader::FetchFunc getFetchFunc (const int size)
+{
+	switch (size)
+	{
+		case 1:		return fetchRun<Reader, 1>;
+		case 2:		return fetchRun<Reader, 2>;
+		case 3:		return fetchRun<Reader, 3>;
+		case 4:		return fetchRun<Reader, 4>;
+		default:
+			DE_ASSERT(false);
+			return DE_NULL;
+	}
+}
+
+VertexAttribReader::FetchFunc getFetchFunc (const VertexAttribType type, const int size)
+{
+	switch (type)
+	{
+		case VERTEXATTRIBTYPE_FLOAT:									return getFetchFunc<ReaderFloat>					(size);
+		case VERTEXATTRIBTYPE_HALF:										return getFetchFunc<ReaderHalf>						(size);
+		case VERTEXATTRIBTYPE_FIXED:									return getFetchFunc<ReaderFixed>					(size);
+		case VERTEXATTRIBTYPE_DOUBLE:									return getFetchFunc<ReaderDouble>					(size);
+		case VERTEXATTRIBTYPE_NONPURE_UNORM8:							return getFetchFunc<ReaderUnorm8>					(size);
+		case VERTEXATTRIBTYPE_NONPURE_UNORM16:							return getFetchFunc<ReaderUnorm16>					(size);
+		case VERTEXATTRIBTYPE_NONPURE_UNORM32:							return getFetchFunc<ReaderUnorm32>					(size);
+		case VERTEXATTRIBTYPE_NONPURE_UNORM_2_10_10_10_REV:				return getFetchFunc<ReaderUnorm2101010Rev>			(size);
+		case VERTEXATTRIBTYPE_NONPURE_SNORM8_CLAMP:						return getFetchFunc<ReaderSnorm8Clamp>				(size);
+		case VERTEXATTRIBTYPE_NONPURE_SNORM16_CLAMP:					return getFetchFunc<ReaderSnorm16Clamp>				(size);
+		case VERTEXATTRIBTYPE_NONPURE_SNORM32_CLAMP:					return getFetchFunc<ReaderSnorm32Clamp>				(size);
+		case VERTEXATTRIBTYPE_NONPURE_SNORM_2_10_10_10_REV_CLAMP:		return getFetchFunc<ReaderSnorm2101010RevClamp>		(size);
+		case VERTEXATTRIBTYPE_NONPURE_SNORM8_SCALE:						return getFetchFunc<ReaderSnorm8Scale>				(size);
+		case VERTEXATTRIBTYPE_NONPURE_SNORM16_SCALE:					return getFetchFunc<ReaderSnorm16Scale>				(size);
+		case VERTEXATTRIBTYPE_NONPURE_SNORM32_SCALE:					return getFetchFunc<ReaderSnorm32Scale>				(size);
+		case VERTEXATTRIBTYPE_NONPURE_SNORM_2_10_10_10_REV_SCALE:		return getFetchFunc<ReaderSnorm2101010RevScale>		(size);
+		case VERTEXATTRIBTYPE_NONPURE_UINT8:							return getFetchFunc<ReaderUint8AsFloat>				(size);
+		case VERTEXATTRIBTYPE_NONPURE_UINT16:							return getFetchFunc<ReaderUint16AsFloat>			(size);
+		case VERTEXATTRIBTYPE_NONPURE_UINT32:							return getFetchFunc<ReaderUint32AsFloat>			(size);
+		case VERTEXATTRIBTYPE_NONPURE_INT8:								return getFetchFunc<ReaderInt8AsFloat>				(size);
+		case VERTEXATTRIBTYPE_NONPURE_INT16:							return getFetchFunc<ReaderInt16AsFloat>				(size);
+		case VERTEXATTRIBTYPE_NONPURE_INT32:							return getFetchFunc<ReaderInt32AsFloat>				(size);
+		case VERTEXATTRIBTYPE_NONPURE_UINT_2_10_10_10_REV:				return getFetchFunc<ReaderUint2101010RevAsFloat>	(size);
+		case VERTEXATTRIBTYPE_NONPURE_INT_2_10_10_10_REV:				return getFetchFunc<ReaderInt2101010RevAsFloat>		(size);
+		case VERTEXATTRIBTYPE_PURE_UINT8:								return getFetchFunc<ReaderPureUint8>				(size);
+		case VERTEXATTRIBTYPE_PURE_UINT16:								return getFetchFunc<ReaderPureUint16>				(size);
+		case VERTEXATTRIBTYPE_PURE_UINT32:								return getFetchFunc<ReaderPureUint32>				(size);
+		case VERTEXATTRIBTYPE_PURE_INT8:								return getFetchFunc<ReaderPureInt8>					(size);
+		case VERTEXATTRIBTYPE_PURE_INT16:								return getFetchFunc<ReaderPureInt16>				(size);
+		case VERTEXATTRIBTYPE_PURE_INT32:								return getFetchFunc<ReaderPureInt32>				(size);
+		case VERTEXATTRIBTYPE_NONPURE_UNORM8_BGRA:						return getFetchFunc<ReaderUnorm8BGRA>				(size);
+		case VERTEXATTRIBTYPE_NONPURE_UNORM_2_10_10_10_REV_BGRA:		return getFetchFunc<ReaderUnorm2101010RevBGRA>		(size);
+		case VERTEXATTRIBTYPE_NONPURE_SNORM_2_10_10_10_REV_CLAMP_BGRA:	return getFetchFunc<ReaderSnorm2101010RevClampBGRA>	(size);
+		case VERTEXATTRIBTYPE_NONPURE_SNORM_2_10_10_10_REV_SCALE_BGRA:	return getFetchFunc<ReaderSnorm2101010RevScaleBGRA>	(size);
+		default:
+			DE_ASSERT(false);
+			return DE_NULL;
+	}
+}
+
+GenericVecType getFetchType (const VertexAttribType type)
+{
+	switch (type)
+	{
+		case VERTEXATTRIBTYPE_PURE_UINT8:
+		case VERTEXATTRIBTYPE_PURE_UINT16:
+		case VERTEXATTRIBTYPE_PURE_UINT32:
+			return GENERICVECTYPE_UINT32;
+
+		case VERTEXATTRIBTYPE_PURE_INT8:
+		case VERTEXATTRIBTYPE_PURE_INT16:
+		case VERTEXATTRIBTYPE_PURE_INT32:
+			return GENERICVECTYPE_INT32;
+
+		default:
+			return GENERICVECTYPE_FLOAT;
+	}
+}
+
 } // anonymous
 
 bool isValidVertexAttrib (const VertexAttrib& vertexAttrib)
@@ -545,4 +700,73 @@ void readVertexAttrib (tcu::UVec4& dst, const VertexAttrib& vertexAttrib, const
 	}
 }
 
+// VertexAttribReader
+
+VertexAttribReader::VertexAttribReader (const VertexAttrib& vertexAttrib)
+	: m_attrib		(vertexAttrib)
+	, m_stride		(0)
+	, m_fetchType	(GENERICVECTYPE_LAST)
+	, m_fetchFunc	(DE_NULL)
+{
+	DE_ASSERT(isValidVertexAttrib(vertexAttrib));
+
+	if (vertexAttrib.pointer)
+	{
+		m_stride	= (vertexAttrib.stride != 0) ? (vertexAttrib.stride) : (vertexAttrib.size*getComponentSize(vertexAttrib.type));
+		m_fetchType	= getFetchType(vertexAttrib.type);
+		m_fetchFunc	= getFetchFunc(vertexAttrib.type, vertexAttrib.size);
+	}
+}
+
+template<typename ScalarType>
+void VertexAttribReader::readGeneric (ScalarType* dst, int dstStride, int numPackets) const
+{
+	const tcu::Vector<ScalarType, 4> value = m_attrib.generic.get<ScalarType>();
+
+	for (int compNdx = 0; compNdx < 4; compNdx++)
+	{
+		for (int packetNdx = 0; packetNdx < numPackets; packetNdx++)
+			dst[compNdx*dstStride + packetNdx] = value[compNdx];
+	}
+}
+
+void VertexAttribReader::read (float* dst, int dstStride, const VertexPacket* const* packets, int numPackets) const
+{
+	DE_ASSERT(dstStride >= numPackets);
+
+	if (m_fetchFunc)
+	{
+		DE_ASSERT(m_fetchType == GENERICVECTYPE_FLOAT);
+		m_fetchFunc(dst, dstStride, m_attrib, m_stride, packets, numPackets);
+	}
+	else
+		readGeneric(dst, dstStride, numPackets);
+}
+
+void VertexAttribReader::read (deInt32* dst, int dstStride, const VertexPacket* const* packets, int numPackets) const
+{
+	DE_ASSERT(dstStride >= numPackets);
+
+	if (m_fetchFunc)
+	{
+		DE_ASSERT(m_fetchType == GENERICVECTYPE_INT32);
+		m_fetchFunc(dst, dstStride, m_attrib, m_stride, packets, numPackets);
+	}
+	else
+		readGeneric(dst, dstStride, numPackets);
+}
+
+void VertexAttribReader::read (deUint32* dst, int dstStride, const VertexPacket* const* packets, int numPackets) const
+{
+	DE_ASSERT(dstStride >= numPackets);
+
+	if (m_fetchFunc)
+	{
+		DE_ASSERT(m_fetchType == GENERICVECTYPE_UINT32);
+		m_fetchFunc(dst, dstStride, m_attrib, m_stride, packets, numPackets);
+	}
+	else
+		readGeneric(dst, dstStride, numPackets);
+}
+
 } // rr
@@ -30,6 +30,8 @@
 namespace rr
 {
 
+struct VertexPacket;
+
 enum VertexAttribType
 {
 	// Can only be read as floats
@@ -175,6 +177,40 @@ inline tcu::UVec4 readVertexAttribUint (const VertexAttrib& vertexAttrib, const
 	return v;
 }
 
+/*--------------------------------------------------------------------*//*!
+ * \brief Batched vertex attribute fetch
+ *
+ * Reads one attribute for a run of vertex packets. Conversion kernel for
+ * the attribute type and size is selected once when reader is created,
+ * so per-vertex cost doesn't include format dispatch. Reader can be kept
+ * for the duration of a draw call.
+ *
+ * Output is in SoA layout: component c of packet n is written to
+ * dst[c*dstStride + n]. All four components are written, and components
+ * missing from the attribute get defaults (0, 0, 0, 1) as in
+ * readVertexAttrib(). Values are identical to readVertexAttrib().
+ *//*--------------------------------------------------------------------*/
+class VertexAttribReader
+{
+public:
+	explicit			VertexAttribReader	(const VertexAttrib& vertexAttrib);
+
+	void				read				(float* dst, int dstStride, const VertexPacket* const* packets, int numPackets) const;
+	void				read				(deInt32* dst, int dstStride, const VertexPacket* const* packets, int numPackets) const;
+	void				read				(deUint32* dst, int dstStride, const VertexPacket* const* packets, int numPackets) const;
+
+	typedef void		(*FetchFunc)		(void* dst, int dstStride, const VertexAttrib& vertexAttrib, int stride, const VertexPacket* const* packets, int numPackets);
+
+private:
+	template<typename ScalarType>
+	void				readGeneric			(ScalarType* dst, int dstStride, int numPackets) const;
+
+	const VertexAttrib	m_attrib;
+	int					m_stride;			//!< Element stride in bytes.
+	GenericVecType		m_fetchType;		//!< Scalar type that m_fetchFunc produces.
+	FetchFunc			m_fetchFunc;		//!< Null for generic attributes.
+};
+
 } // rr
 
 #endif // _RRVERTEXATTRIB_HPP
@@ -80,11 +80,19 @@ VertexPacket* VertexPacketAllocator::alloc (void)
 	const size_t poolSize = 8;
 
 	if (m_singleAllocPool.empty())
+	{
 		m_singleAllocPool = allocArray(poolSize);
+		m_singleAllocPackets.insert(m_singleAllocPackets.end(), m_singleAllocPool.begin(), m_singleAllocPool.end());
+	}
 
 	VertexPacket* packet = *--m_singleAllocPool.end();
 	m_singleAllocPool.pop_back();
 	return packet;
 }
 
+void VertexPacketAllocator::reset (void)
+{
+	m_singleAllocPool = m_singleAllocPackets;
+}
+
 } // rr
@@ -89,6 +89,10 @@ private:
  * is destroyed. Allocated vertex packets should not be accessed after
  * allocator is destroyed.
  *
+ * reset() recycles packets returned by alloc() so that their memory can
+ * be reused for subsequent alloc() calls. Packets returned by allocArray()
+ * are not affected.
+ *
  * alloc and allocArray will throw bad_alloc if allocation fails.
  *//*--------------------------------------------------------------------*/
 class VertexPacketAllocator
@@ -99,6 +103,7 @@ public:
 
 	std::vector<VertexPacket*>	allocArray				(size_t count); // throws bad_alloc
 	VertexPacket*				alloc					(void);			// throws bad_alloc
+	void						reset					(void);			//!< Return all packets from alloc() to pool. They must not be used after reset.
 
 	inline size_t				getNumVertexOutputs		(void) const	{ return m_numberOfVertexOutputs; }
 
@@ -109,6 +114,7 @@ private:
 	const size_t				m_numberOfVertexOutputs;
 	std::vector<deInt8*>		m_allocations;
 	std::vector<VertexPacket*>	m_singleAllocPool;
+	std::vector<VertexPacket*>	m_singleAllocPackets;	//!< All packets allocated for alloc()
 } DE_WARN_UNUSED_TYPE;
 
 } // rr
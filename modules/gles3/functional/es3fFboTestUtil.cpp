@@ -782,6 +782,7 @@ DepthGradientShader::DepthGradientShader (glu::DataType outputType)
 					<< sglr::pdec::Uniform("u_maxGradient", glu::TYPE_FLOAT)
 					<< sglr::pdec::Uniform("u_minGradient", glu::TYPE_FLOAT)
 					<< sglr::pdec::Uniform("u_color", glu::TYPE_FLOAT_VEC4)
+					<< sglr::pdec::FragmentShaderDeclaration(sglr::pdec::FRAGMENTFLAG_WRITES_DEPTH)
 					<< sglr::pdec::VertexSource(
 							"#version 300 es\n"
 							"in highp vec4 a_position;\n"
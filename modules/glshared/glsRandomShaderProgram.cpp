@@ -137,6 +137,8 @@ RandomShaderProgram::RandomShaderProgram (const rsg::Shader& vertexShader, const
 	, m_positionVar			(findShaderOutputByName(vertexShader, "gl_Position"))
 	, m_fragColorVar		(findShaderOutputByLocation(fragmentShader, 0))
 	, m_execCtx				(m_sampler2DMap, m_samplerCubeMap)
+	, m_compiledVertexShader	(vertexShader)
+	, m_compiledFragmentShader	(fragmentShader)
 {
 	TCU_CHECK_INTERNAL(m_positionVar && m_positionVar->getType().getBaseType() == rsg::VariableType::TYPE_FLOAT && m_positionVar->getType().getNumElements() == 4);
 	TCU_CHECK_INTERNAL(m_fragColorVar && m_fragColorVar->getType().getBaseType() == rsg::VariableType::TYPE_FLOAT && m_fragColorVar->getType().getNumElements() == 4);
@@ -184,23 +186,21 @@ void RandomShaderProgram::shadeVertices (const rr::VertexAttrib* inputs, rr::Ver
 			const rsg::VariableType&	attribType		= attribVar->getType();
 			const int					numComponents	= attribType.getNumElements();
 			rsg::ExecValueAccess		access			= m_execCtx.getValue(attribVar);
+			float						attribValues	[4][rsg::EXEC_VEC_WIDTH];
 
 			DE_ASSERT(attribType.isFloatOrVec() && de::inRange(numComponents, 1, 4));
 
-			for (int ndx = 0; ndx < numToExecute; ndx++)
-			{
-				const int				packetNdx	= ndx+packetOffset;
-				const rr::VertexPacket*	packet		= packets[packetNdx];
-				const tcu::Vec4			attribValue	= rr::readVertexAttribFloat(inputs[attribNdx], packet->instanceNdx, packet->vertexNdx);
+			// Execution values are stored per component, same as reader output.
+			rr::VertexAttribReader(inputs[attribNdx]).read(&attribValues[0][0], rsg::EXEC_VEC_WIDTH, packets+packetOffset, numToExecute);
 
-										access.component(0).asFloat(ndx) = attribValue[0];
-				if (numComponents >= 2)	access.component(1).asFloat(ndx) = attribValue[1];
-				if (numComponents >= 3)	access.component(2).asFloat(ndx) = attribValue[2];
-				if (numComponents >= 4)	access.component(3).asFloat(ndx) = attribValue[3];
+			for (int compNdx = 0; compNdx < numComponents; compNdx++)
+			{
+				for (int ndx = 0; ndx < numToExecute; ndx++)
+					access.component(compNdx).asFloat(ndx) = attribValues[compNdx][ndx];
 			}
 		}
 
-		m_vertexShader.execute(m_execCtx);
+		m_compiledVertexShader.execute(m_execCtx);
 
 		// Store position
 		{
@@ -283,7 +283,7 @@ void RandomShaderProgram::shadeFragments (rr::FragmentPacket* packets, const int
 			}
 		}
 
-		m_fragmentShader.execute(m_execCtx);
+		m_compiledFragmentShader.execute(m_execCtx);
 
 		// Store color
 		for (int packetNdx = 0; packetNdx < numPacketsToExecute; packetNdx++)
@@ -26,6 +26,7 @@
 #include "tcuDefs.hpp"
 #include "sglrContext.hpp"
 #include "rsgExecutionContext.hpp"
+#include "rsgCompiledShader.hpp"
 
 namespace rsg
 {
@@ -61,6 +62,8 @@ private:
 	rsg::Sampler2DMap					m_sampler2DMap;
 	rsg::SamplerCubeMap					m_samplerCubeMap;
 	mutable rsg::ExecutionContext		m_execCtx;
+	mutable rsg::CompiledShader			m_compiledVertexShader;
+	mutable rsg::CompiledShader			m_compiledFragmentShader;
 };
 
 } // gls
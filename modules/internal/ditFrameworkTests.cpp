@@ -28,16 +28,31 @@
 
 #include "tcuFloatFormat.hpp"
 #include "tcuEither.hpp"
+#include "tcuInterval.hpp"
 #include "tcuTestLog.hpp"
 #include "tcuCommandLine.hpp"
+#include "tcuCaseTrie.hpp"
+#include "tcuTestHierarchyIterator.hpp"
 
 #include "rrRenderer.hpp"
 #include "tcuTextureUtil.hpp"
+#include "tcuImageCompare.hpp"
 #include "tcuVectorUtil.hpp"
 #include "tcuFloat.hpp"
 
 #include "deRandom.hpp"
 #include "deArrayUtil.hpp"
+#include "deUniquePtr.hpp"
+#include "deFile.h"
+#include "deClock.h"
+#include "deMemory.h"
+#include "deStringUtil.hpp"
+
+#include <sstream>
+#include <fstream>
+#include <cfloat>
+#include <iomanip>
+#include <algorithm>
 
 namespace dit
 {
@@ -81,14 +96,15 @@ public:
 
 	IterateResult iterate (void)
 	{
-		TestLog&			log		= m_testCtx.getLog();
-		tcu::CommandLine	cmdLine;
-		int					numPass	= 0;
+		TestLog&			log			= m_testCtx.getLog();
+		const string		binaryPath	= string(getName()) + "-caselist.bin";
+		int					numPass		= 0;
 
 		log << TestLog::Message << "Input:\n\"" << m_caseList << "\"" << TestLog::EndMessage;
 
 		{
-			const char* argv[] =
+			tcu::CommandLine	cmdLine;
+			const char*			argv[]	=
 			{
 				"deqp",
 				"--deqp-caselist",
@@ -97,8 +113,55 @@ public:
 
 			if (!cmdLine.parse(DE_LENGTH_OF_ARRAY(argv), argv))
 				TCU_FAIL("Failed to parse case list");
+
+			numPass += checkMatches(cmdLine);
+		}
+
+		// Precompiled binary case list must match the same paths.
+		{
+			std::istringstream					str		(m_caseList);
+			const de::UniquePtr<tcu::CaseTrie>	trie	(tcu::CaseTrie::parse(str));
+
+			trie->write(binaryPath.c_str());
 		}
 
+		try
+		{
+			tcu::CommandLine	cmdLine;
+			const string		fileArg	= "--deqp-caselist-file=" + binaryPath;
+			const char*			argv[]	=
+			{
+				"deqp",
+				fileArg.c_str()
+			};
+
+			log << TestLog::Message << "Checking precompiled binary case list" << TestLog::EndMessage;
+
+			if (!cmdLine.parse(DE_LENGTH_OF_ARRAY(argv), argv))
+				TCU_FAIL("Failed to load binary case list");
+
+			numPass += checkMatches(cmdLine);
+		}
+		catch (...)
+		{
+			deDeleteFile(binaryPath.c_str());
+			throw;
+		}
+
+		deDeleteFile(binaryPath.c_str());
+
+		m_testCtx.setTestResult((numPass == 2*m_numSubCases) ? QP_TEST_RESULT_PASS	: QP_TEST_RESULT_FAIL,
+								(numPass == 2*m_numSubCases) ? "All passed"			: "Unexpected match result");
+
+		return STOP;
+	}
+
+private:
+	int checkMatches (const tcu::CommandLine& cmdLine)
+	{
+		TestLog&	log		= m_testCtx.getLog();
+		int			numPass	= 0;
+
 		for (int subCaseNdx = 0; subCaseNdx < m_numSubCases; subCaseNdx++)
 		{
 			const MatchCase&	curCase		= m_subCases[subCaseNdx];
@@ -122,13 +185,9 @@ public:
 				log << TestLog::Message << "   FAIL!" << TestLog::EndMessage;
 		}
 
-		m_testCtx.setTestResult((numPass == m_numSubCases) ? QP_TEST_RESULT_PASS	: QP_TEST_RESULT_FAIL,
-								(numPass == m_numSubCases) ? "All passed"			: "Unexpected match result");
-
-		return STOP;
+		return numPass;
 	}
 
-private:
 	const char* const			m_caseList;
 	const MatchCase* const		m_subCases;
 	const int					m_numSubCases;
@@ -171,6 +230,83 @@ private:
 	const char* const	m_caseList;
 };
 
+class MalformedBinaryCaseListCase : public tcu::TestCase
+{
+public:
+	enum Corruption
+	{
+		CORRUPTION_TRUNCATE = 0,
+		CORRUPTION_NODE_COUNT,
+		CORRUPTION_CHILD_LINK,
+
+		CORRUPTION_LAST
+	};
+
+	MalformedBinaryCaseListCase (tcu::TestContext& testCtx, const char* name, Corruption corruption)
+		: tcu::TestCase	(testCtx, name, "")
+		, m_corruption	(corruption)
+	{
+	}
+
+	IterateResult iterate (void)
+	{
+		const string	binaryPath	= string(getName()) + "-caselist.bin";
+		vector<char>	data;
+
+		{
+			std::istringstream					str		("{a{b,c{d}},e}");
+			const de::UniquePtr<tcu::CaseTrie>	trie	(tcu::CaseTrie::parse(str));
+
+			trie->write(binaryPath.c_str());
+		}
+
+		{
+			std::ifstream in (binaryPath.c_str(), std::ios_base::binary);
+			data.assign(std::istreambuf_iterator<char>(in), std::istreambuf_iterator<char>());
+		}
+
+		// Header is 5 words: magic, version, node count, hash slot count, string table size.
+		// First node (root) follows, its 4th word is index of first child.
+		if (m_corruption == CORRUPTION_TRUNCATE)
+			data.resize(data.size() - sizeof(deUint32));
+		else if (m_corruption == CORRUPTION_NODE_COUNT)
+			*(deUint32*)&data[2*sizeof(deUint32)] += 1;
+		else
+		{
+			DE_ASSERT(m_corruption == CORRUPTION_CHILD_LINK);
+			*(deUint32*)&data[(5+3)*sizeof(deUint32)] = 0;
+		}
+
+		{
+			std::ofstream out (binaryPath.c_str(), std::ios_base::binary);
+			out.write(&data[0], (std::streamsize)data.size());
+		}
+
+		{
+			tcu::CommandLine	cmdLine;
+			const string		fileArg	= "--deqp-caselist-file=" + binaryPath;
+			const char*			argv[]	=
+			{
+				"deqp",
+				fileArg.c_str()
+			};
+			const bool			parseOk	= cmdLine.parse(DE_LENGTH_OF_ARRAY(argv), argv);
+
+			deDeleteFile(binaryPath.c_str());
+
+			if (parseOk)
+				m_testCtx.setTestResult(QP_TEST_RESULT_FAIL, "Loading passed, should have failed");
+			else
+				m_testCtx.setTestResult(QP_TEST_RESULT_PASS, "Loading failed as expected");
+		}
+
+		return STOP;
+	}
+
+private:
+	const Corruption	m_corruption;
+};
+
 class TrieParserTests : public tcu::TestCaseGroup
 {
 public:
@@ -291,6 +427,26 @@ public:
 			};
 			addChild(new CaseListParserCase(m_testCtx, "trailing_crlf", caseList, subCases, DE_LENGTH_OF_ARRAY(subCases)));
 		}
+		{
+			static const char* const	caseList	= "{a{b*,*c{x}},d*e}";
+			static const MatchCase		subCases[]	=
+			{
+				{ "a",			MatchCase::MATCH_GROUP	},
+				{ "a.b",		MatchCase::MATCH_CASE	},
+				{ "a.bar",		MatchCase::MATCH_CASE	},
+				{ "a.c",		MatchCase::MATCH_GROUP	},
+				{ "a.xc",		MatchCase::MATCH_GROUP	},
+				{ "a.xc.x",		MatchCase::MATCH_CASE	},
+				{ "a.xc.y",		MatchCase::NO_MATCH		},
+				{ "a.x",		MatchCase::NO_MATCH		},
+				{ "de",			MatchCase::MATCH_CASE	},
+				{ "dxe",		MatchCase::MATCH_CASE	},
+				{ "d",			MatchCase::NO_MATCH		},
+				{ "dx",			MatchCase::NO_MATCH		},
+				{ "b",			MatchCase::NO_MATCH		},
+			};
+			addChild(new CaseListParserCase(m_testCtx, "wildcard", caseList, subCases, DE_LENGTH_OF_ARRAY(subCases)));
+		}
 
 		// Negative tests
 		addChild(new NegativeCaseListCase(m_testCtx, "empty_string",			""));
@@ -533,6 +689,26 @@ public:
 			};
 			addChild(new CaseListParserCase(m_testCtx, "reparenting", caseList, subCases, DE_LENGTH_OF_ARRAY(subCases)));
 		}
+		{
+			static const char* const	caseList	= "a.b*\na.*c.x\nd*e\n";
+			static const MatchCase		subCases[]	=
+			{
+				{ "a",			MatchCase::MATCH_GROUP	},
+				{ "a.b",		MatchCase::MATCH_CASE	},
+				{ "a.bar",		MatchCase::MATCH_CASE	},
+				{ "a.c",		MatchCase::MATCH_GROUP	},
+				{ "a.xc",		MatchCase::MATCH_GROUP	},
+				{ "a.xc.x",		MatchCase::MATCH_CASE	},
+				{ "a.xc.y",		MatchCase::NO_MATCH		},
+				{ "a.x",		MatchCase::NO_MATCH		},
+				{ "de",			MatchCase::MATCH_CASE	},
+				{ "dxe",		MatchCase::MATCH_CASE	},
+				{ "d",			MatchCase::NO_MATCH		},
+				{ "dx",			MatchCase::NO_MATCH		},
+				{ "b",			MatchCase::NO_MATCH		},
+			};
+			addChild(new CaseListParserCase(m_testCtx, "wildcard", caseList, subCases, DE_LENGTH_OF_ARRAY(subCases)));
+		}
 
 		// Negative tests
 		addChild(new NegativeCaseListCase(m_testCtx, "empty_string",			""));
@@ -542,6 +718,23 @@ public:
 	}
 };
 
+class BinaryCaseListTests : public tcu::TestCaseGroup
+{
+public:
+	BinaryCaseListTests (tcu::TestContext& testCtx)
+		: tcu::TestCaseGroup(testCtx, "binary", "Precompiled binary case list tests")
+	{
+	}
+
+	void init (void)
+	{
+		// \note Matching of binary case lists is checked by trie and list cases.
+		addChild(new MalformedBinaryCaseListCase(m_testCtx, "malformed_truncated",	MalformedBinaryCaseListCase::CORRUPTION_TRUNCATE));
+		addChild(new MalformedBinaryCaseListCase(m_testCtx, "malformed_node_count",	MalformedBinaryCaseListCase::CORRUPTION_NODE_COUNT));
+		addChild(new MalformedBinaryCaseListCase(m_testCtx, "malformed_child_link",	MalformedBinaryCaseListCase::CORRUPTION_CHILD_LINK));
+	}
+};
+
 class CaseListParserTests : public tcu::TestCaseGroup
 {
 public:
@@ -554,6 +747,7 @@ public:
 	{
 		addChild(new TrieParserTests(m_testCtx));
 		addChild(new ListParserTests(m_testCtx));
+		addChild(new BinaryCaseListTests(m_testCtx));
 	}
 };
 
@@ -573,6 +767,158 @@ inline tcu::Vector<deUint32, Size> ulpDiff (const tcu::Vector<float, Size>& a, c
 	return res;
 }
 
+class EmptyTestCase : public tcu::TestCase
+{
+public:
+	EmptyTestCase (tcu::TestContext& testCtx, const char* name)
+		: tcu::TestCase(testCtx, name, "")
+	{
+	}
+
+	IterateResult iterate (void)
+	{
+		m_testCtx.setTestResult(QP_TEST_RESULT_PASS, "Pass");
+		return STOP;
+	}
+};
+
+class CountingGroupFactory : public tcu::TestNodeFactory
+{
+public:
+	CountingGroupFactory (const char* name, int& numCreated)
+		: m_name		(name)
+		, m_numCreated	(numCreated)
+	{
+	}
+
+	tcu::TestNode* createNode (tcu::TestContext& testCtx) const
+	{
+		vector<tcu::TestNode*> children;
+
+		children.push_back(new EmptyTestCase(testCtx, "x"));
+		m_numCreated += 1;
+
+		return new tcu::TestCaseGroup(testCtx, m_name, "", children);
+	}
+
+private:
+	const char* const	m_name;
+	int&				m_numCreated;
+};
+
+class LazyTestPackage : public tcu::TestPackage
+{
+public:
+	LazyTestPackage (tcu::TestContext& testCtx, int& numCreated)
+		: tcu::TestPackage	(testCtx, "pkg", "")
+		, m_numCreated		(numCreated)
+	{
+	}
+
+	void init (void)
+	{
+		addLazyChild("a", tcu::NODECLASS_GROUP, new CountingGroupFactory("a", m_numCreated));
+		addLazyChild("b", tcu::NODECLASS_GROUP, new CountingGroupFactory("b", m_numCreated));
+		addLazyChild("c", tcu::NODECLASS_GROUP, new CountingGroupFactory("c", m_numCreated));
+	}
+
+	tcu::TestCaseExecutor* createExecutor (void) const
+	{
+		return DE_NULL;
+	}
+
+private:
+	int&				m_numCreated;
+};
+
+// Inflater that doesn't touch test context state.
+class InitOnlyInflater : public tcu::TestHierarchyInflater
+{
+public:
+	void enterTestPackage	(tcu::TestPackage* testPackage)	{ testPackage->init();		}
+	void leaveTestPackage	(tcu::TestPackage* testPackage)	{ testPackage->deinit();	}
+	void enterGroupNode		(tcu::TestCaseGroup* testGroup)	{ testGroup->init();		}
+	void leaveGroupNode		(tcu::TestCaseGroup* testGroup)	{ testGroup->deinit();		}
+};
+
+class LazyHierarchyCase : public tcu::TestCase
+{
+public:
+	LazyHierarchyCase (tcu::TestContext& testCtx, const char* name, const char* filter, const char* expectedPaths, int expectedNumCreated)
+		: tcu::TestCase			(testCtx, name, "")
+		, m_filter				(filter)
+		, m_expectedPaths		(expectedPaths)
+		, m_expectedNumCreated	(expectedNumCreated)
+	{
+	}
+
+	IterateResult iterate (void)
+	{
+		TestLog&				log			= m_testCtx.getLog();
+		tcu::CommandLine		cmdLine;
+		const string			caseArg		= string("--deqp-case=") + m_filter;
+		const char*				argv[]		=
+		{
+			"deqp",
+			caseArg.c_str()
+		};
+		int						numCreated	= 0;
+		string					paths;
+
+		if (!cmdLine.parse(DE_LENGTH_OF_ARRAY(argv), argv))
+			TCU_FAIL("Failed to parse command line");
+
+		{
+			vector<tcu::TestNode*> packages;
+			packages.push_back(new LazyTestPackage(m_testCtx, numCreated));
+
+			tcu::TestPackageRoot		root		(m_testCtx, packages);
+			InitOnlyInflater			inflater;
+			tcu::TestHierarchyIterator	iter		(root, inflater, cmdLine);
+
+			for (; iter.getState() != tcu::TestHierarchyIterator::STATE_FINISHED; iter.next())
+			{
+				if (iter.getState() == tcu::TestHierarchyIterator::STATE_ENTER_NODE)
+					paths += (paths.empty() ? "" : " ") + iter.getNodePath();
+			}
+		}
+
+		log << TestLog::Message << "Filter: " << m_filter << "\n"
+								<< "Entered: " << paths << "\n"
+								<< "Created groups: " << numCreated
+			<< TestLog::EndMessage;
+
+		if (paths != m_expectedPaths || numCreated != m_expectedNumCreated)
+			m_testCtx.setTestResult(QP_TEST_RESULT_FAIL, "Unexpected iteration result");
+		else
+			m_testCtx.setTestResult(QP_TEST_RESULT_PASS, "Pass");
+
+		return STOP;
+	}
+
+private:
+	const char* const	m_filter;
+	const char* const	m_expectedPaths;
+	const int			m_expectedNumCreated;
+};
+
+class TestHierarchyTests : public tcu::TestCaseGroup
+{
+public:
+	TestHierarchyTests (tcu::TestContext& testCtx)
+		: tcu::TestCaseGroup(testCtx, "test_hierarchy", "Test hierarchy iteration tests")
+	{
+	}
+
+	void init (void)
+	{
+		addChild(new LazyHierarchyCase(m_testCtx, "lazy_single_case",	"pkg.b.x",	"pkg pkg.b pkg.b.x",								1));
+		addChild(new LazyHierarchyCase(m_testCtx, "lazy_single_group",	"pkg.c.*",	"pkg pkg.c pkg.c.x",								1));
+		addChild(new LazyHierarchyCase(m_testCtx, "lazy_all",			"pkg.*",	"pkg pkg.a pkg.a.x pkg.b pkg.b.x pkg.c pkg.c.x",	3));
+		addChild(new LazyHierarchyCase(m_testCtx, "lazy_no_match",		"pkg.d.*",	"pkg",												0));
+	}
+};
+
 class ConstantInterpolationTest : public tcu::TestCase
 {
 public:
@@ -866,6 +1212,302 @@ protected:
 	vector<SubCase>::const_iterator	m_caseIter;
 };
 
+enum ArithmeticOp
+{
+	ARITHMETICOP_ADD = 0,
+	ARITHMETICOP_SUB,
+	ARITHMETICOP_MUL,
+	ARITHMETICOP_DIV,
+
+	ARITHMETICOP_LAST
+};
+
+typedef double (*DirectedOpFunc) (double x, double y);
+
+struct DirectedOp
+{
+	const char*		name;
+	ArithmeticOp	op;
+	DirectedOpFunc	roundDown;
+	DirectedOpFunc	roundUp;
+};
+
+// Reference result computed with the rounding mode changed. Volatile
+// operands and result keep the operation from being moved across the
+// mode change.
+double computeWithRoundingMode (ArithmeticOp op, double x, double y, deRoundingMode mode)
+{
+	const volatile double	vx		= x;
+	const volatile double	vy		= y;
+	volatile double			result	= 0.0;
+
+	{
+		const tcu::ScopedRoundingMode ctx (mode);
+
+		switch (op)
+		{
+			case ARITHMETICOP_ADD:	result = vx + vy;	break;
+			case ARITHMETICOP_SUB:	result = vx - vy;	break;
+			case ARITHMETICOP_MUL:	result = vx * vy;	break;
+			case ARITHMETICOP_DIV:	result = vx / vy;	break;
+			default:
+				DE_ASSERT(false);
+		}
+	}
+
+	return result;
+}
+
+bool isSameDouble (double a, double b)
+{
+	// Sign of zero is not significant for interval bounds.
+	return (deIsNaN(a) && deIsNaN(b)) || a == b;
+}
+
+double getRandomDouble (de::Random& rnd)
+{
+	switch (rnd.getInt(0, 3))
+	{
+		case 0:
+		{
+			// Any bit pattern, including infinities, NaNs and subnormals.
+			const deUint64	bits	= rnd.getUint64();
+			double			value;
+			deMemcpy(&value, &bits, sizeof(value));
+			return value;
+		}
+
+		case 1:		return (double)rnd.getFloat(-1e3f, 1e3f);
+		case 2:		return deLdExp((double)rnd.getFloat(-1.0f, 1.0f), rnd.getInt(-1100, 1100));
+		default:	return (double)rnd.getInt(-16, 16) * 0.125;
+	}
+}
+
+class IntervalDirectedRoundingCase : public tcu::TestCase
+{
+public:
+	IntervalDirectedRoundingCase (tcu::TestContext& testCtx)
+		: tcu::TestCase(testCtx, "interval_directed_rounding", "Compare tcu directed rounding operations to results computed with rounding mode changed")
+	{
+	}
+
+	IterateResult iterate (void)
+	{
+		const DirectedOp	ops[]			=
+		{
+			{ "add",	ARITHMETICOP_ADD,	tcu::addRoundDown,	tcu::addRoundUp	},
+			{ "sub",	ARITHMETICOP_SUB,	tcu::subRoundDown,	tcu::subRoundUp	},
+			{ "mul",	ARITHMETICOP_MUL,	tcu::mulRoundDown,	tcu::mulRoundUp	},
+			{ "div",	ARITHMETICOP_DIV,	tcu::divRoundDown,	tcu::divRoundUp	},
+		};
+		const double		specialValues[]	=
+		{
+			0.0, -0.0, 1.0, -1.0, 3.0, 0.1, -0.1, 1.0/3.0, 1.0 + DBL_EPSILON, 1.0 - DBL_EPSILON/2.0,
+			DBL_MIN, -DBL_MIN, DBL_MAX, -DBL_MAX, DBL_MIN*DBL_EPSILON, -DBL_MIN*DBL_EPSILON,
+			deLdExp(1.0, 995), deLdExp(1.0, -969), deLdExp(1.0, 512), deLdExp(3.0, -540),
+			TCU_INFINITY, -TCU_INFINITY, TCU_NAN
+		};
+		const int			numRandom		= 20000;
+		TestLog&			log				= m_testCtx.getLog();
+		de::Random			rnd				(0x1f2e3d);
+		vector<double>		xs;
+		vector<double>		ys;
+		int					numFailed		= 0;
+
+		DE_STATIC_ASSERT(DE_LENGTH_OF_ARRAY(ops) == ARITHMETICOP_LAST);
+
+		for (int xNdx = 0; xNdx < DE_LENGTH_OF_ARRAY(specialValues); xNdx++)
+		for (int yNdx = 0; yNdx < DE_LENGTH_OF_ARRAY(specialValues); yNdx++)
+		{
+			xs.push_back(specialValues[xNdx]);
+			ys.push_back(specialValues[yNdx]);
+		}
+
+		for (int ndx = 0; ndx < numRandom; ndx++)
+		{
+			const double x = getRandomDouble(rnd);
+
+			xs.push_back(x);
+
+			// Nearly cancelling operands are the interesting case for addition.
+			if (rnd.getBool())
+				ys.push_back(-x * (1.0 + (double)rnd.getFloat(-1e-3f, 1e-3f)));
+			else
+				ys.push_back(getRandomDouble(rnd));
+		}
+
+		for (int opNdx = 0; opNdx < DE_LENGTH_OF_ARRAY(ops); opNdx++)
+		{
+			const DirectedOp&	op			= ops[opNdx];
+			int					numExact	= 0;
+			int					numWidened	= 0;
+
+			for (size_t ndx = 0; ndx < xs.size(); ndx++)
+			{
+				const double	x		= xs[ndx];
+				const double	y		= ys[ndx];
+				const double	refLo	= computeWithRoundingMode(op.op, x, y, DE_ROUNDINGMODE_TO_NEGATIVE_INF);
+				const double	refHi	= computeWithRoundingMode(op.op, x, y, DE_ROUNDINGMODE_TO_POSITIVE_INF);
+				const double	lo		= op.roundDown(x, y);
+				const double	hi		= op.roundUp(x, y);
+
+				if (isSameDouble(lo, refLo) && isSameDouble(hi, refHi))
+					numExact += 1;
+				else if (lo <= refLo && hi >= refHi)
+					numWidened += 1;
+				else
+				{
+					if (numFailed++ < 10)
+						log << TestLog::Message << "ERROR: " << op.name << "(" << x << ", " << y << "): got ["
+							<< lo << ", " << hi << "], expected [" << refLo << ", " << refHi << "]"
+							<< TestLog::EndMessage;
+				}
+			}
+
+			log << TestLog::Message << op.name << ": " << numExact << " exact, " << numWidened << " widened, "
+				<< (xs.size() - numExact - numWidened) << " failed" << TestLog::EndMessage;
+		}
+
+		m_testCtx.setTestResult(numFailed == 0 ? QP_TEST_RESULT_PASS	: QP_TEST_RESULT_FAIL,
+								numFailed == 0 ? "Pass"					: "Result not contained in directed rounding bounds");
+		return STOP;
+	}
+};
+
+// Add and mul bounds of non-negative intervals, as in precision test fast paths.
+struct RoundingModeBounds
+{
+	tcu::Interval operator() (const tcu::Interval& x, const tcu::Interval& y) const
+	{
+		tcu::Interval sum;
+		tcu::Interval prod;
+
+		TCU_SET_INTERVAL_BOUNDS(sum, p, p = x.lo() + y.lo(), p = x.hi() + y.hi());
+		TCU_SET_INTERVAL_BOUNDS(prod, p, p = x.lo() * y.lo(), p = x.hi() * y.hi());
+
+		return sum | prod;
+	}
+};
+
+struct DirectedRoundingBounds
+{
+	tcu::Interval operator() (const tcu::Interval& x, const tcu::Interval& y) const
+	{
+		return tcu::Interval(tcu::addRoundDown(x.lo(), y.lo())) | tcu::Interval(tcu::addRoundUp(x.hi(), y.hi())) |
+			   tcu::Interval(tcu::mulRoundDown(x.lo(), y.lo())) | tcu::Interval(tcu::mulRoundUp(x.hi(), y.hi()));
+	}
+};
+
+// Add and mul of generic intervals.
+struct RoundingModeOperators
+{
+	tcu::Interval operator() (const tcu::Interval& x, const tcu::Interval& y) const
+	{
+		tcu::Interval sum;
+		tcu::Interval prod;
+
+		TCU_SET_INTERVAL_BOUNDS(sum, p, p = x.lo() + y.lo(), p = x.hi() + y.hi());
+		TCU_INTERVAL_APPLY_MONOTONE2(prod, xp, x, yp, y, val,
+									 TCU_SET_INTERVAL(val, p, p = xp * yp));
+
+		return sum | prod;
+	}
+};
+
+struct DirectedRoundingOperators
+{
+	tcu::Interval operator() (const tcu::Interval& x, const tcu::Interval& y) const
+	{
+		return (x + y) | (x * y);
+	}
+};
+
+class IntervalArithmeticPerfCase : public tcu::TestCase
+{
+public:
+	IntervalArithmeticPerfCase (tcu::TestContext& testCtx)
+		: tcu::TestCase(testCtx, "interval_arithmetic_perf", "Measure directed rounding operations against changing rounding mode")
+	{
+	}
+
+	IterateResult iterate (void)
+	{
+		enum
+		{
+			NUM_VALUES	= 1024
+		};
+
+		de::Random				rnd				(0x6a09e6);
+		vector<tcu::Interval>	values			(NUM_VALUES);
+		bool					isOk			= true;
+
+		for (int ndx = 0; ndx < NUM_VALUES; ndx++)
+		{
+			const double a = (double)rnd.getFloat(0.0f, 100.0f);
+			const double b = a + (double)rnd.getFloat(0.0f, 1.0f);
+			values[ndx] = tcu::Interval(a, b);
+		}
+
+		isOk = measure("Bounds", values, RoundingModeBounds(), DirectedRoundingBounds()) && isOk;
+
+		// Operators also handle intervals crossing zero.
+		for (int ndx = 0; ndx < NUM_VALUES; ndx++)
+			values[ndx] = values[ndx] - 50.0;
+
+		isOk = measure("Operators", values, RoundingModeOperators(), DirectedRoundingOperators()) && isOk;
+
+		m_testCtx.setTestResult(isOk ? QP_TEST_RESULT_PASS	: QP_TEST_RESULT_FAIL,
+								isOk ? "Pass"				: "Results differ");
+		return STOP;
+	}
+
+private:
+	template<typename RefOp, typename TestOp>
+	bool measure (const char* name, const vector<tcu::Interval>& values, const RefOp& refOp, const TestOp& testOp)
+	{
+		TestLog&		log			= m_testCtx.getLog();
+		tcu::Interval	refAcc;
+		tcu::Interval	testAcc;
+		const deUint64	refTime		= measureOp(values, refOp, refAcc);
+		const deUint64	testTime	= measureOp(values, testOp, testAcc);
+		const double	numOps		= (double)((values.size()-1) * NUM_ITERATIONS);
+
+		log << TestLog::Message << name << ": rounding mode " << (double)refTime * 1000.0 / numOps << " ns, "
+			<< "directed rounding " << (double)testTime * 1000.0 / numOps << " ns per add and mul"
+			<< TestLog::EndMessage;
+
+		// Optimizing compilers assume the default rounding mode and may merge
+		// the identical lower and upper bound computations of the reference,
+		// so only containment is checked.
+		if (!testAcc.contains(refAcc))
+		{
+			log << TestLog::Message << std::setprecision(17) << "ERROR: Got " << testAcc << ", expected at least " << refAcc << TestLog::EndMessage;
+			return false;
+		}
+
+		return true;
+	}
+
+	template<typename Op>
+	static deUint64 measureOp (const vector<tcu::Interval>& values, const Op& op, tcu::Interval& acc)
+	{
+		const deUint64 startTime = deGetMicroseconds();
+
+		for (int iterNdx = 0; iterNdx < NUM_ITERATIONS; iterNdx++)
+		{
+			for (size_t ndx = 0; ndx+1 < values.size(); ndx++)
+				acc |= op(values[ndx], values[ndx+1]);
+		}
+
+		return deGetMicroseconds() - startTime;
+	}
+
+	enum
+	{
+		NUM_ITERATIONS	= 64
+	};
+};
+
 class CommonFrameworkTests : public tcu::TestCaseGroup
 {
 public:
@@ -880,6 +1522,532 @@ public:
 								   tcu::FloatFormat_selfTest));
 		addChild(new SelfCheckCase(m_testCtx, "either","tcu::Either_selfTest()",
 								   tcu::Either_selfTest));
+		addChild(new IntervalDirectedRoundingCase(m_testCtx));
+		addChild(new IntervalArithmeticPerfCase(m_testCtx));
+	}
+};
+
+class VertexAttribBatchFetchCase : public tcu::TestCase
+{
+public:
+	VertexAttribBatchFetchCase (tcu::TestContext& testCtx)
+		: tcu::TestCase(testCtx, "vertex_attrib_batch_fetch", "Compare VertexAttribReader to readVertexAttrib()")
+	{
+	}
+
+	IterateResult iterate (void)
+	{
+		enum
+		{
+			NUM_ELEMENTS	= 32,
+			NUM_PACKETS		= 37,
+			MAX_STRIDE		= 40
+		};
+
+		TestLog&						log				= m_testCtx.getLog();
+		de::Random						rnd				(0x7a3c9);
+		rr::VertexPacketAllocator		allocator		(0);
+		const vector<rr::VertexPacket*>	packets			= allocator.allocArray(NUM_PACKETS);
+		vector<deUint8>					data			(NUM_ELEMENTS*MAX_STRIDE);
+		int								numFailed		= 0;
+		int								numChecked		= 0;
+
+		for (size_t ndx = 0; ndx < data.size(); ndx++)
+			data[ndx] = rnd.getUint8();
+
+		for (int packetNdx = 0; packetNdx < NUM_PACKETS; packetNdx++)
+		{
+			packets[packetNdx]->vertexNdx	= rnd.getInt(0, NUM_ELEMENTS-1);
+			packets[packetNdx]->instanceNdx	= rnd.getInt(0, 3*NUM_ELEMENTS/4);
+		}
+
+		for (int type = 0; type < rr::VERTEXATTRIBTYPE_DONT_CARE; type++)
+		for (int size = 1; size <= 4; size++)
+		for (int strideNdx = 0; strideNdx < 2; strideNdx++)
+		for (int divisorNdx = 0; divisorNdx < 2; divisorNdx++)
+		{
+			const rr::VertexAttrib attrib ((rr::VertexAttribType)type, size, strideNdx == 0 ? 0 : MAX_STRIDE, divisorNdx == 0 ? 0 : 3, &data[0]);
+
+			if (!rr::isValidVertexAttrib(attrib))
+				continue;
+
+			if (!checkAttrib(attrib, &packets[0], NUM_PACKETS))
+			{
+				if (numFailed++ < 10)
+					log << TestLog::Message << "ERROR: Mismatch with type " << type << ", size " << size << ", stride " << attrib.stride << ", divisor " << attrib.instanceDivisor << TestLog::EndMessage;
+			}
+
+			numChecked += 1;
+		}
+
+		// Generic attributes
+		{
+			const rr::VertexAttrib attribs[] =
+			{
+				rr::VertexAttrib(tcu::Vec4(1.0f, -2.0f, 0.5f, 4.0f)),
+				rr::VertexAttrib(tcu::IVec4(-1, 2, -3, 4)),
+				rr::VertexAttrib(tcu::UVec4(1u, 2u, 3u, 0xffffffffu))
+			};
+
+			for (int ndx = 0; ndx < DE_LENGTH_OF_ARRAY(attribs); ndx++)
+			{
+				if (!checkAttrib(attribs[ndx], &packets[0], NUM_PACKETS))
+				{
+					log << TestLog::Message << "ERROR: Mismatch with generic attribute " << ndx << TestLog::EndMessage;
+					numFailed += 1;
+				}
+
+				numChecked += 1;
+			}
+		}
+
+		log << TestLog::Message << (numChecked-numFailed) << " / " << numChecked << " attribute formats passed" << TestLog::EndMessage;
+
+		m_testCtx.setTestResult(numFailed == 0 ? QP_TEST_RESULT_PASS	: QP_TEST_RESULT_FAIL,
+								numFailed == 0 ? "Pass"					: "Batch fetch result differs");
+		return STOP;
+	}
+
+private:
+	static bool checkAttrib (const rr::VertexAttrib& attrib, const rr::VertexPacket* const* packets, int numPackets)
+	{
+		const rr::VertexAttribReader reader (attrib);
+
+		switch (attrib.type)
+		{
+			case rr::VERTEXATTRIBTYPE_PURE_UINT8:
+			case rr::VERTEXATTRIBTYPE_PURE_UINT16:
+			case rr::VERTEXATTRIBTYPE_PURE_UINT32:
+				return checkValues<deUint32>(reader, attrib, packets, numPackets);
+
+			case rr::VERTEXATTRIBTYPE_PURE_INT8:
+			case rr::VERTEXATTRIBTYPE_PURE_INT16:
+			case rr::VERTEXATTRIBTYPE_PURE_INT32:
+				return checkValues<deInt32>(reader, attrib, packets, numPackets);
+
+			case rr::VERTEXATTRIBTYPE_DONT_CARE:
+				return checkValues<float>(reader, attrib, packets, numPackets)		&&
+					   checkValues<deInt32>(reader, attrib, packets, numPackets)	&&
+					   checkValues<deUint32>(reader, attrib, packets, numPackets);
+
+			default:
+				return checkValues<float>(reader, attrib, packets, numPackets);
+		}
+	}
+
+	template<typename ScalarType>
+	static bool checkValues (const rr::VertexAttribReader& reader, const rr::VertexAttrib& attrib, const rr::VertexPacket* const* packets, int numPackets)
+	{
+		vector<ScalarType> batch (4*numPackets);
+
+		reader.read(&batch[0], numPackets, packets, numPackets);
+
+		for (int packetNdx = 0; packetNdx < numPackets; packetNdx++)
+		{
+			tcu::Vector<ScalarType, 4> reference;
+
+			rr::readVertexAttrib(reference, attrib, packets[packetNdx]->instanceNdx, packets[packetNdx]->vertexNdx);
+
+			// Bitwise comparison, data may contain NaNs.
+			for (int compNdx = 0; compNdx < 4; compNdx++)
+			{
+				if (deMemCmp(&batch[compNdx*numPackets + packetNdx], &reference[compNdx], sizeof(ScalarType)) != 0)
+					return false;
+			}
+		}
+
+		return true;
+	}
+};
+
+class EarlyFragmentTestsCase : public tcu::TestCase
+{
+public:
+	EarlyFragmentTestsCase (tcu::TestContext& testCtx)
+		: tcu::TestCase(testCtx, "early_fragment_tests", "Compare early depth and stencil tests to late tests")
+	{
+	}
+
+	IterateResult iterate (void)
+	{
+		enum
+		{
+			NUM_QUADS	= 16
+		};
+
+		TestLog&		log			= m_testCtx.getLog();
+		de::Random		rnd			(0x51e7a);
+		vector<Quad>	quads;
+		bool			allOk		= true;
+
+		for (int quadNdx = 0; quadNdx < NUM_QUADS; quadNdx++)
+		{
+			Quad quad;
+
+			quad.x0		= rnd.getFloat(-1.0f, 0.5f);
+			quad.y0		= rnd.getFloat(-1.0f, 0.5f);
+			quad.x1		= rnd.getFloat(quad.x0 + 0.2f, 1.0f);
+			quad.y1		= rnd.getFloat(quad.y0 + 0.2f, 1.0f);
+			quad.z		= -1.0f + 2.0f * (float)quadNdx / (float)NUM_QUADS;
+			quad.color	= tcu::Vec4(rnd.getFloat(), rnd.getFloat(), rnd.getFloat(), 1.0f);
+
+			quads.push_back(quad);
+		}
+
+		for (int samplesNdx = 0; samplesNdx < 2; samplesNdx++)
+		for (int orderNdx = 0; orderNdx < 2; orderNdx++)
+		{
+			const int						numSamples	= (samplesNdx == 0) ? 1 : 4;
+			const bool						frontToBack	= (orderNdx == 0);
+			tcu::ScopedLogSection			section		(log, "SubCase", string(frontToBack ? "Front to back" : "Back to front") + ", " + de::toString(numSamples) + " samples");
+			vector<Quad>					order		(quads);
+			tcu::TextureLevel				earlyColor, earlyDepthStencil;
+			tcu::TextureLevel				lateColor, lateDepthStencil;
+			rr::RenderStatistics			earlyStats, lateStats;
+
+			if (!frontToBack)
+				std::reverse(order.begin(), order.end());
+
+			earlyStats	= render(order, numSamples, false, earlyColor, earlyDepthStencil);
+			lateStats	= render(order, numSamples, true, lateColor, lateDepthStencil);
+
+			log << TestLog::Message << "Early tests: " << earlyStats.numRasterizedFragments << " rasterized, "
+									<< earlyStats.numShadedFragments << " shaded, "
+									<< earlyStats.numEarlyKilledFragments << " killed early, "
+									<< earlyStats.numHiZKilledFragments << " killed by coarse depth test" << TestLog::EndMessage;
+
+			if (!isBitwiseEqual(earlyColor.getAccess(), lateColor.getAccess()) ||
+				!isBitwiseEqual(earlyDepthStencil.getAccess(), lateDepthStencil.getAccess()))
+			{
+				log << TestLog::Message << "ERROR: Result with early tests differs from result with late tests" << TestLog::EndMessage;
+				allOk = false;
+			}
+
+			if (lateStats.numShadedFragments != lateStats.numRasterizedFragments || lateStats.numEarlyKilledFragments != 0)
+			{
+				log << TestLog::Message << "ERROR: Fragments were killed before shading with depth writing shader" << TestLog::EndMessage;
+				allOk = false;
+			}
+
+			if (earlyStats.numRasterizedFragments != lateStats.numRasterizedFragments ||
+				earlyStats.numShadedFragments + earlyStats.numEarlyKilledFragments != earlyStats.numRasterizedFragments ||
+				earlyStats.numHiZKilledFragments > earlyStats.numEarlyKilledFragments)
+			{
+				log << TestLog::Message << "ERROR: Inconsistent fragment counters" << TestLog::EndMessage;
+				allOk = false;
+			}
+
+			if (frontToBack && (earlyStats.numEarlyKilledFragments == 0 || earlyStats.numHiZKilledFragments == 0))
+			{
+				log << TestLog::Message << "ERROR: Expected occluded fragments to be killed before shading" << TestLog::EndMessage;
+				allOk = false;
+			}
+		}
+
+		m_testCtx.setTestResult(allOk ? QP_TEST_RESULT_PASS	: QP_TEST_RESULT_FAIL,
+								allOk ? "Pass"					: "Early tests produced wrong result");
+		return STOP;
+	}
+
+private:
+	struct Quad
+	{
+		float		x0, y0, x1, y1;
+		float		z;
+		tcu::Vec4	color;
+	};
+
+	class VtxShader : public rr::VertexShader
+	{
+	public:
+		VtxShader (void)
+			: rr::VertexShader(2, 1)
+		{
+			m_inputs[0].type	= rr::GENERICVECTYPE_FLOAT;
+			m_inputs[1].type	= rr::GENERICVECTYPE_FLOAT;
+			m_outputs[0].type	= rr::GENERICVECTYPE_FLOAT;
+		}
+
+		void shadeVertices (const rr::VertexAttrib* inputs, rr::VertexPacket* const* packets, const int numPackets) const
+		{
+			for (int packetNdx = 0; packetNdx < numPackets; packetNdx++)
+			{
+				rr::readVertexAttrib(packets[packetNdx]->position, inputs[0], packets[packetNdx]->instanceNdx, packets[packetNdx]->vertexNdx);
+				packets[packetNdx]->outputs[0] = rr::readVertexAttribFloat(inputs[1], packets[packetNdx]->instanceNdx, packets[packetNdx]->vertexNdx);
+			}
+		}
+	};
+
+	//! Writes back rasterized depth when declared as depth writing, which forces tests after shading.
+	class FragShader : public rr::FragmentShader
+	{
+	public:
+		FragShader (bool writesDepth)
+			: rr::FragmentShader(1, 1)
+		{
+			m_inputs[0].type		= rr::GENERICVECTYPE_FLOAT;
+			m_outputs[0].type		= rr::GENERICVECTYPE_FLOAT;
+			m_writesFragmentDepth	= writesDepth;
+		}
+
+		void shadeFragments (rr::FragmentPacket* packets, const int numPackets, const rr::FragmentShadingContext& context) const
+		{
+			for (int packetNdx = 0; packetNdx < numPackets; packetNdx++)
+			{
+				for (int fragNdx = 0; fragNdx < rr::NUM_FRAGMENTS_PER_PACKET; fragNdx++)
+				{
+					rr::writeFragmentOutput(context, packetNdx, fragNdx, 0, rr::readTriangleVarying<float>(packets[packetNdx], context, 0, fragNdx));
+
+					if (m_writesFragmentDepth)
+					{
+						for (int sampleNdx = 0; sampleNdx < context.numSamples; sampleNdx++)
+							rr::writeFragmentDepth(context, packetNdx, fragNdx, sampleNdx, rr::readFragmentDepth(context, packetNdx, fragNdx, sampleNdx));
+					}
+				}
+			}
+		}
+	};
+
+	static rr::RenderStatistics render (const vector<Quad>& quads, int numSamples, bool writesDepth, tcu::TextureLevel& color, tcu::TextureLevel& depthStencil)
+	{
+		const int	width	= 61;
+		const int	height	= 37;
+
+		color.setStorage(tcu::TextureFormat(tcu::TextureFormat::RGBA, tcu::TextureFormat::UNORM_INT8), numSamples, width, height);
+		depthStencil.setStorage(tcu::TextureFormat(tcu::TextureFormat::DS, tcu::TextureFormat::UNSIGNED_INT_24_8), numSamples, width, height);
+
+		tcu::clear			(color.getAccess(), tcu::Vec4(0.0f, 0.0f, 0.0f, 1.0f));
+		tcu::clearDepth		(depthStencil.getAccess(), 1.0f);
+		tcu::clearStencil	(depthStencil.getAccess(), 0);
+
+		const VtxShader							vtxShader;
+		const FragShader						fragShader		(writesDepth);
+		const rr::Program						program			(&vtxShader, &fragShader);
+		const rr::MultisamplePixelBufferAccess	colorAccess		= rr::MultisamplePixelBufferAccess::fromMultisampleAccess(color.getAccess());
+		const rr::MultisamplePixelBufferAccess	dsAccess		= rr::MultisamplePixelBufferAccess::fromMultisampleAccess(depthStencil.getAccess());
+		const rr::RenderTarget					renderTarget	(colorAccess, dsAccess, dsAccess);
+		rr::ViewportState						viewport		(colorAccess);
+		rr::RenderState							state			(viewport);
+		const rr::Renderer						renderer;
+
+		state.fragOps.depthTestEnabled							= true;
+		state.fragOps.depthFunc									= rr::TESTFUNC_LESS;
+		state.fragOps.stencilTestEnabled						= true;
+		state.fragOps.stencilStates[rr::FACETYPE_BACK].func		= rr::TESTFUNC_ALWAYS;
+		state.fragOps.stencilStates[rr::FACETYPE_BACK].dpPass	= rr::STENCILOP_INCR;
+		state.fragOps.stencilStates[rr::FACETYPE_FRONT]			= state.fragOps.stencilStates[rr::FACETYPE_BACK];
+
+		for (vector<Quad>::const_iterator quad = quads.begin(); quad != quads.end(); ++quad)
+		{
+			const tcu::Vec4				positions[]		=
+			{
+				tcu::Vec4(quad->x0, quad->y0, quad->z, 1.0f),
+				tcu::Vec4(quad->x1, quad->y0, quad->z, 1.0f),
+				tcu::Vec4(quad->x0, quad->y1, quad->z, 1.0f),
+				tcu::Vec4(quad->x1, quad->y1, quad->z, 1.0f)
+			};
+			const rr::VertexAttrib		vertexAttribs[]	=
+			{
+				rr::VertexAttrib(rr::VERTEXATTRIBTYPE_FLOAT, 4, 0, 0, positions),
+				rr::VertexAttrib(quad->color)
+			};
+			const rr::DrawCommand		drawCmd			(state, renderTarget, program, DE_LENGTH_OF_ARRAY(vertexAttribs), vertexAttribs, rr::PrimitiveList(rr::PRIMITIVETYPE_TRIANGLE_STRIP, 4, 0));
+
+			renderer.draw(drawCmd);
+		}
+
+		return renderer.getStatistics();
+	}
+
+	static bool isBitwiseEqual (const tcu::ConstPixelBufferAccess& a, const tcu::ConstPixelBufferAccess& b)
+	{
+		const int rowSize = a.getWidth() * a.getFormat().getPixelSize();
+
+		for (int z = 0; z < a.getDepth(); z++)
+		for (int y = 0; y < a.getHeight(); y++)
+		{
+			if (deMemCmp(a.getPixelPtr(0, y, z), b.getPixelPtr(0, y, z), rowSize) != 0)
+				return false;
+		}
+
+		return true;
+	}
+};
+
+class PrimitiveStreamCase : public tcu::TestCase
+{
+public:
+	PrimitiveStreamCase (tcu::TestContext& testCtx)
+		: tcu::TestCase(testCtx, "primitive_stream", "Compare strips, fans and loops drawn in batches to equivalent lists")
+	{
+	}
+
+	IterateResult iterate (void)
+	{
+		enum
+		{
+			NUM_VERTICES	= 1201,
+			RESTART_NDX		= 640
+		};
+
+		static const struct
+		{
+			const char*			name;
+			rr::PrimitiveType	type;
+		} s_types[] =
+		{
+			{ "triangle_strip",	rr::PRIMITIVETYPE_TRIANGLE_STRIP	},
+			{ "triangle_fan",	rr::PRIMITIVETYPE_TRIANGLE_FAN		},
+			{ "line_strip",		rr::PRIMITIVETYPE_LINE_STRIP		},
+			{ "line_loop",		rr::PRIMITIVETYPE_LINE_LOOP			}
+		};
+
+		TestLog&			log			= m_testCtx.getLog();
+		de::Random			rnd			(0x9f31);
+		vector<tcu::Vec4>	positions	(NUM_VERTICES);
+		vector<tcu::Vec4>	colors		(NUM_VERTICES);
+		vector<deUint16>	indices		(NUM_VERTICES);
+		bool				allOk		= true;
+
+		for (int vtxNdx = 0; vtxNdx < NUM_VERTICES; vtxNdx++)
+		{
+			positions[vtxNdx]	= tcu::Vec4(rnd.getFloat(-1.2f, 1.2f), rnd.getFloat(-1.2f, 1.2f), rnd.getFloat(-1.2f, 1.2f), 1.0f);
+			colors[vtxNdx]		= tcu::Vec4(rnd.getFloat(), rnd.getFloat(), rnd.getFloat(), 1.0f);
+			indices[vtxNdx]		= (deUint16)vtxNdx;
+		}
+
+		indices[RESTART_NDX] = 0xffff;
+
+		for (int typeNdx = 0; typeNdx < DE_LENGTH_OF_ARRAY(s_types); typeNdx++)
+		{
+			const rr::PrimitiveType	type		= s_types[typeNdx].type;
+			const bool				isTriangle	= (type == rr::PRIMITIVETYPE_TRIANGLE_STRIP || type == rr::PRIMITIVETYPE_TRIANGLE_FAN);
+			vector<deUint16>		listIndices;
+			tcu::TextureLevel		streamResult;
+			tcu::TextureLevel		listResult;
+
+			expandToList(type, &indices[0], RESTART_NDX, listIndices);
+			expandToList(type, &indices[RESTART_NDX+1], NUM_VERTICES-RESTART_NDX-1, listIndices);
+
+			render(positions, colors, rr::PrimitiveList(type, NUM_VERTICES, rr::DrawIndices(&indices[0])), true, streamResult);
+			render(positions, colors, rr::PrimitiveList(isTriangle ? rr::PRIMITIVETYPE_TRIANGLES : rr::PRIMITIVETYPE_LINES, (int)listIndices.size(), rr::DrawIndices(&listIndices[0])), false, listResult);
+
+			if (!tcu::intThresholdCompare(log, s_types[typeNdx].name, "", listResult.getAccess(), streamResult.getAccess(), tcu::UVec4(0), tcu::COMPARE_LOG_ON_ERROR))
+				allOk = false;
+		}
+
+		m_testCtx.setTestResult(allOk ? QP_TEST_RESULT_PASS	: QP_TEST_RESULT_FAIL,
+								allOk ? "Pass"					: "Result differs from list primitives");
+		return STOP;
+	}
+
+private:
+	//! Appends primitives of a run as triangle or line list, vertex order matches primitive assembler
+	static void expandToList (rr::PrimitiveType type, const deUint16* run, int numVertices, vector<deUint16>& dst)
+	{
+		switch (type)
+		{
+			case rr::PRIMITIVETYPE_TRIANGLE_STRIP:
+				for (int ndx = 0; ndx + 2 < numVertices; ndx++)
+				{
+					dst.push_back(run[(ndx % 2 == 0) ? ndx : ndx+1]);
+					dst.push_back(run[(ndx % 2 == 0) ? ndx+1 : ndx]);
+					dst.push_back(run[ndx+2]);
+				}
+				break;
+
+			case rr::PRIMITIVETYPE_TRIANGLE_FAN:
+				for (int ndx = 1; ndx + 1 < numVertices; ndx++)
+				{
+					dst.push_back(run[0]);
+					dst.push_back(run[ndx]);
+					dst.push_back(run[ndx+1]);
+				}
+				break;
+
+			case rr::PRIMITIVETYPE_LINE_STRIP:
+			case rr::PRIMITIVETYPE_LINE_LOOP:
+				for (int ndx = 0; ndx + 1 < numVertices; ndx++)
+				{
+					dst.push_back(run[ndx]);
+					dst.push_back(run[ndx+1]);
+				}
+
+				if (type == rr::PRIMITIVETYPE_LINE_LOOP && numVertices >= 2)
+				{
+					dst.push_back(run[numVertices-1]);
+					dst.push_back(run[0]);
+				}
+				break;
+
+			default:
+				DE_ASSERT(false);
+		}
+	}
+
+	static void render (const vector<tcu::Vec4>& positions, const vector<tcu::Vec4>& colors, const rr::PrimitiveList& primitives, bool restart, tcu::TextureLevel& result)
+	{
+		class VtxShader : public rr::VertexShader
+		{
+		public:
+			VtxShader (void)
+				: rr::VertexShader(2, 1)
+			{
+				m_inputs[0].type	= rr::GENERICVECTYPE_FLOAT;
+				m_inputs[1].type	= rr::GENERICVECTYPE_FLOAT;
+				m_outputs[0].type	= rr::GENERICVECTYPE_FLOAT;
+			}
+
+			void shadeVertices (const rr::VertexAttrib* inputs, rr::VertexPacket* const* packets, const int numPackets) const
+			{
+				for (int packetNdx = 0; packetNdx < numPackets; packetNdx++)
+				{
+					rr::readVertexAttrib(packets[packetNdx]->position, inputs[0], packets[packetNdx]->instanceNdx, packets[packetNdx]->vertexNdx);
+					packets[packetNdx]->outputs[0] = rr::readVertexAttribFloat(inputs[1], packets[packetNdx]->instanceNdx, packets[packetNdx]->vertexNdx);
+				}
+			}
+		} vtxShader;
+
+		class FragShader : public rr::FragmentShader
+		{
+		public:
+			FragShader (void)
+				: rr::FragmentShader(1, 1)
+			{
+				m_inputs[0].type	= rr::GENERICVECTYPE_FLOAT;
+				m_outputs[0].type	= rr::GENERICVECTYPE_FLOAT;
+			}
+
+			void shadeFragments (rr::FragmentPacket* packets, const int numPackets, const rr::FragmentShadingContext& context) const
+			{
+				for (int packetNdx = 0; packetNdx < numPackets; packetNdx++)
+				{
+					for (int fragNdx = 0; fragNdx < rr::NUM_FRAGMENTS_PER_PACKET; fragNdx++)
+						rr::writeFragmentOutput(context, packetNdx, fragNdx, 0, rr::readVarying<float>(packets[packetNdx], context, 0, fragNdx));
+				}
+			}
+		} fragShader;
+
+		result.setStorage(tcu::TextureFormat(tcu::TextureFormat::RGBA, tcu::TextureFormat::UNORM_INT8), 67, 53);
+		tcu::clear(result.getAccess(), tcu::Vec4(0.0f, 0.0f, 0.0f, 1.0f));
+
+		const rr::Program						program			(&vtxShader, &fragShader);
+		const rr::MultisamplePixelBufferAccess	colorAccess		= rr::MultisamplePixelBufferAccess::fromSinglesampleAccess(result.getAccess());
+		const rr::RenderTarget					renderTarget	(colorAccess);
+		const rr::VertexAttrib					vertexAttribs[]	=
+		{
+			rr::VertexAttrib(rr::VERTEXATTRIBTYPE_FLOAT, 4, 0, 0, &positions[0]),
+			rr::VertexAttrib(rr::VERTEXATTRIBTYPE_FLOAT, 4, 0, 0, &colors[0])
+		};
+		rr::RenderState							state			((rr::ViewportState(colorAccess)));
+		const rr::Renderer						renderer;
+
+		// Last vertex provokes both in lists and in strips
+		state.provokingVertexConvention	= rr::PROVOKINGVERTEX_LAST;
+		state.restart.enabled			= restart;
+		state.restart.restartIndex		= 0xffff;
+
+		renderer.draw(rr::DrawCommand(state, renderTarget, program, DE_LENGTH_OF_ARRAY(vertexAttribs), vertexAttribs, primitives));
 	}
 };
 
@@ -894,6 +2062,9 @@ public:
 	void init (void)
 	{
 		addChild(new ConstantInterpolationTest(m_testCtx));
+		addChild(new VertexAttribBatchFetchCase(m_testCtx));
+		addChild(new EarlyFragmentTestsCase(m_testCtx));
+		addChild(new PrimitiveStreamCase(m_testCtx));
 	}
 };
 
@@ -912,6 +2083,7 @@ void FrameworkTests::init (void)
 {
 	addChild(new CommonFrameworkTests	(m_testCtx));
 	addChild(new CaseListParserTests	(m_testCtx));
+	addChild(new TestHierarchyTests		(m_testCtx));
 	addChild(new ReferenceRendererTests	(m_testCtx));
 	addChild(createTextureFormatTests	(m_testCtx));
 	addChild(createAstcTests			(m_testCtx));
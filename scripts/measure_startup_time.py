@@ -0,0 +1,113 @@
+# -*- coding: utf-8 -*-
+
+#-------------------------------------------------------------------------
+# drawElements Quality Program utilities
+# --------------------------------------
+#
+# Copyright 2016 The Android Open Source Project
+#
+# Licensed under the Apache License, Version 2.0 (the "License");
+# you may not use this file except in compliance with the License.
+# You may obtain a copy of the License at
+#
+#      http://www.apache.org/licenses/LICENSE-2.0
+#
+# Unless required by applicable law or agreed to in writing, software
+# distributed under the License is distributed on an "AS IS" BASIS,
+# WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+# See the License for the specific language governing permissions and
+# limitations under the License.
+#
+#-------------------------------------------------------------------------
+
+# Measures time from process start to start of the first test case when
+# running a single case from each test package. Time is dominated by test
+# hierarchy construction, so this tracks the cost of inflating groups that
+# the case filter doesn't match.
+
+import os
+import sys
+import time
+import argparse
+import subprocess
+
+class Package:
+	def __init__ (self, name, binaryPath, casePath):
+		self.name		= name
+		self.binaryPath	= binaryPath
+		self.casePath	= casePath
+
+PACKAGES = [
+	Package("dE-IT",		os.path.join("modules", "internal", "de-internal-tests"),				"dE-IT.build_info.de_debug"),
+	Package("dEQP-EGL",		os.path.join("modules", "egl", "deqp-egl"),								"dEQP-EGL.info.version"),
+	Package("dEQP-GLES2",	os.path.join("modules", "gles2", "deqp-gles2"),							"dEQP-GLES2.info.vendor"),
+	Package("dEQP-GLES3",	os.path.join("modules", "gles3", "deqp-gles3"),							"dEQP-GLES3.info.vendor"),
+	Package("dEQP-GLES31",	os.path.join("modules", "gles31", "deqp-gles31"),						"dEQP-GLES31.info.vendor"),
+	Package("dEQP-VK",		os.path.join("external", "vulkancts", "modules", "vulkan", "deqp-vk"),	"dEQP-VK.info.build"),
+]
+
+def measureTimeToFirstCase (binaryPath, casePath, extraArgs):
+	args		= [binaryPath, "--deqp-case=" + casePath, "--deqp-log-filename=" + os.devnull] + extraArgs
+	marker		= "Test case '%s'" % casePath
+	startTime	= time.time()
+	process		= subprocess.Popen(args, cwd=os.path.dirname(binaryPath), stdout=subprocess.PIPE, universal_newlines=True)
+	elapsed		= None
+
+	for line in iter(process.stdout.readline, ""):
+		if elapsed == None and line.startswith(marker):
+			elapsed = time.time() - startTime
+
+	process.wait()
+
+	if elapsed == None:
+		raise Exception("%s didn't start %s" % (binaryPath, casePath))
+
+	return elapsed
+
+def getMedian (values):
+	values	= sorted(values)
+	mid		= len(values) // 2
+	return values[mid] if len(values) % 2 == 1 else (values[mid-1] + values[mid]) * 0.5
+
+def parseArgs ():
+	parser = argparse.ArgumentParser(description = "Measure time-to-first-case of single-case runs")
+	parser.add_argument("-b",
+						"--build-dir",
+						dest="buildDir",
+						required=True,
+						help="Build directory containing the test binaries")
+	parser.add_argument("-n",
+						"--iterations",
+						dest="iterations",
+						type=int,
+						default=5,
+						help="Number of runs per package")
+	parser.add_argument("-p",
+						"--package",
+						dest="packages",
+						action="append",
+						default=[],
+						help="Package to measure (default: all that are built)")
+	parser.add_argument("extraArgs",
+						nargs="*",
+						help="Additional arguments for test binaries, e.g. --deqp-visibility=hidden")
+	return parser.parse_args()
+
+if __name__ == "__main__":
+	args		= parseArgs()
+	packages	= [p for p in PACKAGES if len(args.packages) == 0 or p.name in args.packages]
+
+	print("%-12s %10s %10s  %s" % ("Package", "Min (ms)", "Med (ms)", "Case"))
+
+	for package in packages:
+		binaryPath = os.path.realpath(os.path.join(args.buildDir, package.binaryPath))
+
+		if not os.path.exists(binaryPath):
+			if len(args.packages) > 0:
+				print("%s: %s not found" % (package.name, binaryPath))
+				sys.exit(-1)
+			continue
+
+		times = [measureTimeToFirstCase(binaryPath, package.casePath, args.extraArgs) for i in range(args.iterations)]
+
+		print("%-12s %10.1f %10.1f  %s" % (package.name, min(times)*1000.0, getMedian(times)*1000.0, package.casePath))
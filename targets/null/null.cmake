@@ -30,3 +30,6 @@ set(TCUTIL_PLATFORM_SRCS
 	null/tcuNullContextFactory.cpp
 	null/tcuNullContextFactory.hpp
 	)
+
+# Reference renderer backed context
+set(TCUTIL_PLATFORM_LIBS glutil-sglr)